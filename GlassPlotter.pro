@@ -1,5 +1,6 @@
 QT       += core gui
 QT       += printsupport
+QT       += concurrent
 
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
@@ -30,6 +31,14 @@ INCLUDEPATH += $$PWD/3rdparty/QCustomPlot # QCustomPlot
 INCLUDEPATH += $$PWD/3rdparty/pugixml/src # pugixml
 INCLUDEPATH += $$PWD/3rdparty/spline/src  # spline
 
+# zlib for compressed catalog files. Qt bundles zlib on Windows.
+unix{
+    LIBS += -lz
+}
+win32{
+    INCLUDEPATH += $$[QT_INSTALL_HEADERS]/QtZlib
+}
+
 include(sourcefiles.pri)
 
 RESOURCES += \
@@ -5,27 +5,60 @@
 SOURCES += \
     src/qcustomtablewidget.cpp \
     src/global_settings_io.cpp \
+    src/achromat_pair_search.cpp \
+    src/achromat_search_form.cpp \
+    src/apochromat_search_form.cpp \
+    src/apochromat_triplet_search.cpp \
     src/air.cpp \
+    src/pareto_front_form.cpp \
+    src/user_property_dialog.cpp \
     src/preference_dialog.cpp \
+    src/catalog_exporter.cpp \
+    src/catalog_snapshot.cpp \
     src/catalog_view_form.cpp \
     src/catalog_view_setting_dialog.cpp \
     src/curve_fitting_dialog.cpp \
+    src/dispersion_curve_table.cpp \
     src/dispersion_plot_form.cpp \
     src/dndt_plot_form.cpp \
     src/glass.cpp \
     src/glass_catalog.cpp \
     src/glass_catalog_manager.cpp \
+    src/glass_name_index.cpp \
+    src/glass_load_filter.cpp \
     src/glass_datasheet_form.cpp \
     src/glass_selection_dialog.cpp \
+    src/glass_constraint_index.cpp \
+    src/glass_property_table.cpp \
+    src/glass_equivalence_table.cpp \
+    src/normal_line_fit.cpp \
+    src/normal_line.cpp \
+    src/catalog_diff.cpp \
+    src/prescription_auditor.cpp \
+    src/prescription_audit_command.cpp \
+    src/glass_kd_tree.cpp \
+    src/glass_snapper.cpp \
+    src/glass_snap_command.cpp \
+    src/property_expression.cpp \
+    src/user_property_registry.cpp \
+    src/glass_search_engine.cpp \
     src/glass_search_form.cpp \
+    src/glass_skyline.cpp \
+    src/glass_substitution_form.cpp \
     src/glassmap_form.cpp \
+    src/gzip_file_device.cpp \
     src/load_catalog_result_dialog.cpp \
+    src/load_diagnostics.cpp \
+    src/load_diagnostics_model.cpp \
     src/main.cpp \
+    src/melt_tolerance_simulation.cpp \
+    src/melt_tolerance_form.cpp \
     src/main_window.cpp \
     src/preset_dialog.cpp \
     src/property_plot_form.cpp \
     src/qcpscatterchart.cpp \
     src/spectral_line.cpp \
+    src/text_line_reader.cpp \
     src/transmittance_plot_form.cpp \
     3rdparty/QCustomPlot/qcustomplot.cpp \
     3rdparty/pugixml/src/pugixml.cpp
@@ -34,27 +67,61 @@ SOURCES += \
 HEADERS += \
     src/qcustomtablewidget.h \
     src/global_settings_io.h \
+    src/achromat_pair_search.h \
+    src/achromat_search_form.h \
+    src/apochromat_search_form.h \
+    src/apochromat_triplet_search.h \
     src/air.h \
+    src/pareto_front_form.h \
+    src/user_property_dialog.h \
     src/preference_dialog.h \
+    src/catalog_exporter.h \
+    src/catalog_snapshot.h \
     src/catalog_view_form.h \
     src/catalog_view_setting_dialog.h \
     src/curve_fitting_dialog.h \
     src/dispersion_formula.h \
+    src/dispersion_curve_table.h \
     src/dispersion_plot_form.h \
     src/dndt_plot_form.h \
     src/glass.h \
     src/glass_catalog.h \
     src/glass_catalog_manager.h \
+    src/glass_name_index.h \
+    src/glass_load_filter.h \
     src/glass_datasheet_form.h \
     src/glass_selection_dialog.h \
+    src/glass_constraint_index.h \
+    src/glass_property_table.h \
+    src/glass_equivalence_table.h \
+    src/normal_line_fit.h \
+    src/normal_line.h \
+    src/catalog_diff.h \
+    src/prescription_auditor.h \
+    src/prescription_audit_command.h \
+    src/glass_kd_tree.h \
+    src/glass_snapper.h \
+    src/glass_snap_command.h \
+    src/property_expression.h \
+    src/user_property_registry.h \
+    src/glass_search_engine.h \
     src/glass_search_form.h \
+    src/glass_skyline.h \
+    src/glass_substitution_form.h \
     src/glassmap_form.h \
+    src/gzip_file_device.h \
     src/load_catalog_result_dialog.h \
+    src/load_diagnostics.h \
+    src/load_diagnostics_model.h \
+    src/melt_tolerance_simulation.h \
+    src/melt_tolerance_form.h \
     src/main_window.h \
     src/preset_dialog.h \
     src/property_plot_form.h \
     src/qcpscatterchart.h \
     src/spectral_line.h \
+    src/text_line_reader.h \
+    src/top_k_collector.h \
     src/transmittance_plot_form.h \
     3rdparty/QCustomPlot/qcustomplot.h
 
@@ -63,8 +130,13 @@ HEADERS += \
     #spline/src/spline.h            # spline
 
 FORMS += \
+    src/melt_tolerance_form.ui \
+    src/user_property_dialog.ui \
+    src/pareto_front_form.ui \
     src/preference_dialog.ui \
     src/glassmap_form.ui \
+    src/achromat_search_form.ui \
+    src/apochromat_search_form.ui \
     src/catalog_view_form.ui \
     src/catalog_view_setting_dialog.ui \
     src/curve_fitting_dialog.ui \
@@ -73,6 +145,7 @@ FORMS += \
     src/glass_datasheet_form.ui \
     src/glass_selection_dialog.ui \
     src/glass_search_form.ui \
+    src/glass_substitution_form.ui \
     src/load_catalog_result_dialog.ui \
     src/main_window.ui \
     src/preset_dialog.ui \
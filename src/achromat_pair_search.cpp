@@ -0,0 +1,173 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "achromat_pair_search.h"
+
+#include <algorithm>
+#include <numeric>
+#include <QtConcurrent>
+
+#include "top_k_collector.h"
+
+namespace {
+
+// crown glasses evaluated by one task
+const int kTileSize = 64;
+
+bool lessScore(const AchromatPairSearch::Pair& a, const AchromatPairSearch::Pair& b)
+{
+    if(a.score != b.score) return a.score < b.score;
+    if(a.crown != b.crown) return a.crown < b.crown;
+    return a.flint < b.flint;
+}
+
+typedef TopKCollector<AchromatPairSearch::Pair, decltype(&lessScore)> PairCollector;
+
+} // namespace
+
+
+AchromatPairSearch::AchromatPairSearch(const DispersionCurveTable& table)
+    : table_(table),
+      focal_length_(100.0),
+      max_power_ratio_(5.0),
+      rank_by_(SecondarySpectrum),
+      evaluated_pair_count_(0),
+      total_pair_count_(0)
+{
+}
+
+QVector<AchromatPairSearch::Pair> AchromatPairSearch::search(int k, const QBitArray *mask)
+{
+    evaluated_pair_count_ = 0;
+    total_pair_count_     = 0;
+
+    if(k <= 0 || table_.sampleCount() != 4){
+        return QVector<Pair>();
+    }
+
+    // per glass columns
+    QVector<int>    rows;
+    QVector<double> nColumn, vColumn, pColumn;
+    for(int r = 0; r < table_.rowCount(); r++)
+    {
+        if(mask && !mask->testBit(r)){
+            continue;
+        }
+
+        const double* c = table_.curve(r); // short, center, long, partial
+        const double dn = c[0] - c[2];
+        const double v  = (c[1] - 1.0)/dn;
+        const double p  = (c[3] - c[0])/dn;
+        if(qIsFinite(v) && qIsFinite(p) && v > 0.0){
+            rows.append(r);
+            nColumn.append(c[1]);
+            vColumn.append(v);
+            pColumn.append(p);
+        }
+    }
+
+    // sort by V in descending order
+    const int n = rows.size();
+    QVector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b){ return vColumn[a] > vColumn[b]; });
+
+    QVector<int>    sortedRows(n);
+    QVector<double> ns(n), vs(n), ps(n);
+    for(int i = 0; i < n; i++){
+        sortedRows[i] = rows[order[i]];
+        ns[i] = nColumn[order[i]];
+        vs[i] = vColumn[order[i]];
+        ps[i] = pColumn[order[i]];
+    }
+
+    total_pair_count_ = static_cast<qint64>(n)*(n - 1)/2;
+
+    QVector<int> tiles;
+    for(int begin = 0; begin < n; begin += kTileSize){
+        tiles.append(begin);
+    }
+
+    QVector<PairCollector> collectors(tiles.size(), PairCollector(k, lessScore));
+    QVector<qint64>        evaluated(tiles.size(), 0);
+
+    const double f      = focal_length_;
+    const double ratio  = max_power_ratio_;
+    const RankBy rankBy = rank_by_;
+
+    QtConcurrent::blockingMap(tiles, [&](int begin){
+        const int tile = begin/kTileSize;
+        const int end  = qMin(begin + kTileSize, n);
+        PairCollector& collector = collectors[tile];
+
+        for(int i = begin; i < end; i++)
+        {
+            const double va = vs[i];
+
+            // |phi|/phi <= ratio requires Vb <= Va*(1 - 1/ratio); the others are hopeless
+            const double vLimit = va*(1.0 - 1.0/ratio);
+            const int jBegin = static_cast<int>(std::lower_bound(vs.begin() + i + 1, vs.end(), vLimit,
+                                                                 [](double v, double limit){ return v > limit; }) - vs.begin());
+
+            evaluated[tile] += n - jBegin;
+
+            for(int j = jBegin; j < n; j++)
+            {
+                const double dv = va - vs[j];
+                if(dv <= 0.0){
+                    continue;
+                }
+
+                Pair pair;
+                pair.crown             = sortedRows[i];
+                pair.flint             = sortedRows[j];
+                pair.crownPower        = va/dv;
+                pair.flintPower        = -vs[j]/dv;
+                pair.secondarySpectrum = -f*(ps[i] - ps[j])/dv;
+
+                if(SecondarySpectrum == rankBy){
+                    pair.score = fabs(pair.secondarySpectrum);
+                }else if(ElementPower == rankBy){
+                    pair.score = pair.crownPower;
+                }else{
+                    pair.petzval = pair.crownPower/ns[i] + pair.flintPower/ns[j];
+                    pair.score   = fabs(pair.petzval);
+                }
+
+                if(collector.accepts(pair)){
+                    pair.petzval = pair.crownPower/ns[i] + pair.flintPower/ns[j];
+                    collector.push(pair);
+                }
+            }
+        }
+    });
+
+    PairCollector merged(k, lessScore);
+    for(int t = 0; t < collectors.size(); t++){
+        merged.merge(collectors[t]);
+        evaluated_pair_count_ += evaluated[t];
+    }
+
+    return merged.sorted();
+}
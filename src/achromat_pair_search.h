@@ -0,0 +1,98 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef ACHROMAT_PAIR_SEARCH_H
+#define ACHROMAT_PAIR_SEARCH_H
+
+#include <QVector>
+#include <QBitArray>
+
+#include "dispersion_curve_table.h"
+
+/**
+ * @brief Thin lens achromatic doublet search over all glass pairs
+ * @details
+ * The band is given by the short, center and long wavelengths, and the secondary spectrum is
+ * estimated from the partial dispersion P = (n(partial) - n(short))/(n(short) - n(long)).
+ * For the glass pair a(crown), b(flint), with V = (n(center) - 1)/(n(short) - n(long)),
+ *  - power split            : phi_a/phi = Va/(Va - Vb), phi_b/phi = -Vb/(Va - Vb)
+ *  - secondary spectrum     : -f*(Pa - Pb)/(Va - Vb)
+ *  - Petzval sum times f    : (phi_a/na + phi_b/nb)/phi
+ *
+ * Glasses are sorted by V once, so that the pairs whose element power exceeds the limit
+ * are skipped as a contiguous range.  Tiles of crown glasses are evaluated in parallel.
+ */
+class AchromatPairSearch
+{
+public:
+    enum RankBy{
+        SecondarySpectrum,
+        ElementPower,
+        Petzval
+    };
+
+    struct Pair{
+        int    crown; // row of the curve table
+        int    flint;
+        double crownPower; // normalized by the total power
+        double flintPower;
+        double secondarySpectrum; // same unit as the focal length
+        double petzval;
+        double score;
+    };
+
+    /**
+     * @param table curve table whose grid is {short, center, long, partial}
+     */
+    explicit AchromatPairSearch(const DispersionCurveTable& table);
+
+    void setFocalLength(double f){ focal_length_ = f; }
+
+    /** pairs whose element power exceeds ratio times the total power are pruned */
+    void setMaxPowerRatio(double ratio){ max_power_ratio_ = ratio; }
+
+    void setRankBy(RankBy rank){ rank_by_ = rank; }
+
+    /**
+     * @param mask if given, only the rows whose bit is set are paired
+     * @return at most k pairs in ascending order of score
+     */
+    QVector<Pair> search(int k, const QBitArray* mask = nullptr);
+
+    /** number of pairs evaluated by the last search */
+    qint64 evaluatedPairCount() const{ return evaluated_pair_count_; }
+
+    /** number of all the candidate pairs of the last search */
+    qint64 totalPairCount() const{ return total_pair_count_; }
+
+private:
+    const DispersionCurveTable& table_;
+    double focal_length_;
+    double max_power_ratio_;
+    RankBy rank_by_;
+    qint64 evaluated_pair_count_;
+    qint64 total_pair_count_;
+};
+
+#endif // ACHROMAT_PAIR_SEARCH_H
@@ -0,0 +1,184 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "achromat_search_form.h"
+#include "ui_achromat_search_form.h"
+
+#include <QElapsedTimer>
+#include <QMessageBox>
+#include <QValidator>
+
+#include "achromat_pair_search.h"
+#include "glass_catalog_manager.h"
+#include "glass_constraint_index.h"
+#include "glass_datasheet_form.h"
+#include "spectral_line.h"
+
+AchromatSearchForm::AchromatSearchForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::AchromatSearchForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Achromat Search");
+
+    setUpSpectralCombo(ui->comboBox_Short,   "F");
+    setUpSpectralCombo(ui->comboBox_Center,  "d");
+    setUpSpectralCombo(ui->comboBox_Long,    "C");
+    setUpSpectralCombo(ui->comboBox_Partial, "g");
+
+    ui->lineEdit_FocalLength->setValidator(new QDoubleValidator(this));
+    ui->lineEdit_FocalLength->setText("100");
+
+    ui->lineEdit_MaxPower->setValidator(new QDoubleValidator(1.0, 1000.0, 3, this));
+    ui->lineEdit_MaxPower->setText("5");
+
+    ui->comboBox_RankBy->addItem("Secondary Spectrum", AchromatPairSearch::SecondarySpectrum);
+    ui->comboBox_RankBy->addItem("Element Power",      AchromatPairSearch::ElementPower);
+    ui->comboBox_RankBy->addItem("Petzval",            AchromatPairSearch::Petzval);
+
+    ui->lineEdit_OutputCount->setValidator(new QIntValidator(0,1000));
+    ui->lineEdit_OutputCount->setText("20");
+
+    ui->tableWidget_Result->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    QObject::connect(ui->pushButton_Search,        SIGNAL(clicked()), this, SLOT(showSearchResult()));
+    QObject::connect(ui->pushButton_showDatasheet, SIGNAL(clicked()), this, SLOT(showDatasheet()));
+    QObject::connect(ui->tableWidget_Result,       SIGNAL(cellDoubleClicked(int,int)), this, SLOT(showDatasheet()));
+}
+
+AchromatSearchForm::~AchromatSearchForm()
+{
+    delete ui;
+}
+
+void AchromatSearchForm::setUpSpectralCombo(QComboBox* combo, const QString& defaultLine)
+{
+    const QStringList lines = {"t", "s", "r", "C", "C_", "D", "d", "e", "F", "F_", "g", "h", "i"};
+    combo->addItems(lines);
+    combo->setCurrentIndex(lines.indexOf(defaultLine));
+}
+
+void AchromatSearchForm::showSearchResult()
+{
+    // wavelengths in the order expected by AchromatPairSearch
+    QVector<double> grid;
+    for(QComboBox* combo : {ui->comboBox_Short, ui->comboBox_Center, ui->comboBox_Long, ui->comboBox_Partial}){
+        grid.append(SpectralLine::wavelength(combo->currentText())/1000.0);
+    }
+    if(grid[0] >= grid[2]){
+        QMessageBox::warning(this, tr("Error"), tr("Short wavelength must be shorter than long wavelength"));
+        return;
+    }
+
+    double maxPowerRatio = ui->lineEdit_MaxPower->text().toDouble();
+    if(maxPowerRatio <= 1.0){
+        QMessageBox::warning(this, tr("Error"), tr("Max power ratio must be greater than 1"));
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    if(!m_curveTable.isCurrent(snapshot, grid)){
+        m_curveTable = DispersionCurveTable(snapshot, grid);
+    }
+
+    // rows of the curve table and the constraint index follow the same catalog order
+    QString errorMessage;
+    GlassConstraintQuery query = GlassConstraintQuery::parse(ui->lineEdit_Constraint->text(), &errorMessage);
+    QBitArray mask = GlassConstraintIndex::instance(snapshot)->select(query, &errorMessage);
+    ui->lineEdit_Constraint->setToolTip(errorMessage);
+
+    AchromatPairSearch search(m_curveTable);
+    search.setFocalLength(ui->lineEdit_FocalLength->text().toDouble());
+    search.setMaxPowerRatio(maxPowerRatio);
+    search.setRankBy(static_cast<AchromatPairSearch::RankBy>(ui->comboBox_RankBy->currentData().toInt()));
+
+    int resultCount = ui->lineEdit_OutputCount->text().toInt();
+    QVector<AchromatPairSearch::Pair> pairs = search.search(resultCount, &mask);
+
+    //setup result table
+    QStringList hHeaderLabels({"Crown", "Flint", "Crown Power", "Flint Power", "Secondary Spectrum", "Petzval"});
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(pairs.size());
+    for(int i = 0; i < pairs.size(); i++)
+    {
+        const Glass* crown = m_curveTable.glass(pairs[i].crown);
+        const Glass* flint = m_curveTable.glass(pairs[i].flint);
+
+        setCellValue(ui->tableWidget_Result, i, 0, crown->fullName());
+        ui->tableWidget_Result->item(i, 0)->setData(Qt::UserRole, crown->handle());
+        setCellValue(ui->tableWidget_Result, i, 1, flint->fullName());
+        ui->tableWidget_Result->item(i, 1)->setData(Qt::UserRole, flint->handle());
+
+        setCellValue(ui->tableWidget_Result, i, 2, numToQString(pairs[i].crownPower, 'f', 4));
+        setCellValue(ui->tableWidget_Result, i, 3, numToQString(pairs[i].flintPower, 'f', 4));
+        setCellValue(ui->tableWidget_Result, i, 4, numToQString(pairs[i].secondarySpectrum, 'e', 3));
+        setCellValue(ui->tableWidget_Result, i, 5, numToQString(pairs[i].petzval, 'f', 4));
+    }
+    ui->tableWidget_Result->resizeColumnsToContents();
+
+    ui->label_Summary->setText(QString("%1 of %2 pairs evaluated in %3 ms")
+                               .arg(search.evaluatedPairCount())
+                               .arg(search.totalPairCount())
+                               .arg(timer.elapsed()));
+}
+
+void AchromatSearchForm::showDatasheet()
+{
+    QTableWidgetItem* item = ui->tableWidget_Result->currentItem();
+    if(!item){
+        return;
+    }
+
+    // crown or flint column
+    int row = item->row();
+    int col = (item->column() == 1) ? 1 : 0;
+    GlassHandle handle = ui->tableWidget_Result->item(row, col)->data(Qt::UserRole).toUInt();
+
+    Glass* glass = GlassCatalogManager::glass(handle);
+    if(!glass){
+        return;
+    }
+
+    GlassDataSheetForm* subwindow = new GlassDataSheetForm(glass, m_parentMdiArea);
+    subwindow->setAttribute(Qt::WA_DeleteOnClose);
+    m_parentMdiArea->addSubWindow(subwindow);
+    subwindow->parentWidget()->setGeometry(0,10, this->width()*1/2,this->height()*3/4);
+    subwindow->show();
+}
+
+void AchromatSearchForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
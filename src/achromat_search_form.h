@@ -0,0 +1,77 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef ACHROMAT_SEARCH_FORM_H
+#define ACHROMAT_SEARCH_FORM_H
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+#include <QComboBox>
+
+#include "dispersion_curve_table.h"
+
+namespace Ui {
+class AchromatSearchForm;
+}
+
+/** Form to search glass pairs of an achromatic doublet */
+class AchromatSearchForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit AchromatSearchForm(QMdiArea *parent = nullptr);
+    ~AchromatSearchForm();
+
+private slots:
+    /** Execute search and show result */
+    void showSearchResult();
+
+    /** Show datasheet of the glass in the current cell */
+    void showDatasheet();
+
+private:
+    void setUpSpectralCombo(QComboBox* combo, const QString& defaultLine);
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+    inline QString numToQString(double val, char fmt='f', int digit=6);
+
+    Ui::AchromatSearchForm *ui;
+    QMdiArea* m_parentMdiArea;
+
+    DispersionCurveTable m_curveTable;
+};
+
+
+QString AchromatSearchForm::numToQString(double val, char fmt, int digit)
+{
+    if(qIsNaN(val)){
+        return "-";
+    }
+    else{
+        return QString::number(val,fmt,digit);
+    }
+}
+
+#endif // ACHROMAT_SEARCH_FORM_H
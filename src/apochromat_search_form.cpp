@@ -0,0 +1,189 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "apochromat_search_form.h"
+#include "ui_apochromat_search_form.h"
+
+#include <QElapsedTimer>
+#include <QMdiSubWindow>
+#include <QMessageBox>
+#include <QSet>
+#include <QValidator>
+
+#include "glass_catalog_manager.h"
+#include "glass_datasheet_form.h"
+#include "glassmap_form.h"
+
+ApochromatSearchForm::ApochromatSearchForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::ApochromatSearchForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Apochromat Search");
+
+    ui->lineEdit_MaxPower->setValidator(new QDoubleValidator(1.0, 1000.0, 3, this));
+    ui->lineEdit_MaxPower->setText("5");
+
+    ui->lineEdit_OutputCount->setValidator(new QIntValidator(0,1000));
+    ui->lineEdit_OutputCount->setText("20");
+
+    ui->tableWidget_Result->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    QObject::connect(ui->pushButton_Search,        SIGNAL(clicked()), this, SLOT(showSearchResult()));
+    QObject::connect(ui->pushButton_ShowOnMap,     SIGNAL(clicked()), this, SLOT(showOnGlassMap()));
+    QObject::connect(ui->pushButton_showDatasheet, SIGNAL(clicked()), this, SLOT(showDatasheet()));
+    QObject::connect(ui->tableWidget_Result,       SIGNAL(cellDoubleClicked(int,int)), this, SLOT(showDatasheet()));
+}
+
+ApochromatSearchForm::~ApochromatSearchForm()
+{
+    delete ui;
+}
+
+void ApochromatSearchForm::showSearchResult()
+{
+    double maxPowerRatio = ui->lineEdit_MaxPower->text().toDouble();
+    if(maxPowerRatio <= 1.0){
+        QMessageBox::warning(this, tr("Error"), tr("Max power ratio must be greater than 1"));
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_constraintIndex = GlassConstraintIndex::instance(GlassCatalogManager::snapshot());
+    const GlassPropertyTable& table = m_constraintIndex->table();
+
+    QString errorMessage;
+    GlassConstraintQuery query = GlassConstraintQuery::parse(ui->lineEdit_Constraint->text(), &errorMessage);
+    QBitArray mask = m_constraintIndex->select(query, &errorMessage);
+    ui->lineEdit_Constraint->setToolTip(errorMessage);
+
+    ApochromatTripletSearch search(table);
+    search.setMaxPowerRatio(maxPowerRatio);
+    m_triplets = search.search(ui->lineEdit_OutputCount->text().toInt(), &mask);
+
+    //setup result table
+    QStringList hHeaderLabels({"Glass 1", "Glass 2", "Glass 3", "Power 1", "Power 2", "Power 3", "Max Power", "Petzval"});
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(m_triplets.size());
+    for(int i = 0; i < m_triplets.size(); i++)
+    {
+        const ApochromatTripletSearch::Triplet& t = m_triplets[i];
+        for(int j = 0; j < 3; j++){
+            const Glass* g = table.glass(t.rows[j]);
+            setCellValue(ui->tableWidget_Result, i, j, g->fullName());
+            ui->tableWidget_Result->item(i, j)->setData(Qt::UserRole, g->handle());
+            setCellValue(ui->tableWidget_Result, i, j+3, numToQString(t.powers[j], 'f', 4));
+        }
+        setCellValue(ui->tableWidget_Result, i, 6, numToQString(t.maxPower, 'f', 4));
+        setCellValue(ui->tableWidget_Result, i, 7, numToQString(t.petzval, 'f', 4));
+    }
+    ui->tableWidget_Result->resizeColumnsToContents();
+
+    ui->label_Summary->setText(QString("%1 of %2 triplets evaluated in %3 ms")
+                               .arg(search.evaluatedTripletCount())
+                               .arg(search.totalTripletCount())
+                               .arg(timer.elapsed()));
+}
+
+void ApochromatSearchForm::showOnGlassMap()
+{
+    if(m_triplets.isEmpty() || !m_constraintIndex){
+        return;
+    }
+
+    // selected rows, or all rows if none
+    QSet<int> selectedRows;
+    for(auto &item : ui->tableWidget_Result->selectedItems()){
+        selectedRows.insert(item->row());
+    }
+
+    const GlassPropertyTable& table = m_constraintIndex->table();
+    const int vdCol = table.columnIndex("vd");
+    const int pgCol = table.columnIndex("PgF");
+
+    QList<QPolygonF> polygons;
+    for(int i = 0; i < m_triplets.size(); i++){
+        if(!selectedRows.isEmpty() && !selectedRows.contains(i)){
+            continue;
+        }
+        QPolygonF polygon;
+        for(int j = 0; j < 3; j++){
+            int row = m_triplets[i].rows[j];
+            polygon.append(QPointF(table.value(row, vdCol), table.value(row, pgCol)));
+        }
+        polygons.append(polygon);
+    }
+
+    int mapCount = 0;
+    for(auto &subwindow : m_parentMdiArea->subWindowList()){
+        GlassMapForm* glassmap = qobject_cast<GlassMapForm*>(subwindow->widget());
+        if(glassmap && "vd" == glassmap->xDataName() && "PgF" == glassmap->yDataName()){
+            glassmap->setOverlay(polygons);
+            mapCount++;
+        }
+    }
+
+    if(0 == mapCount){
+        QMessageBox::information(this, tr("Info"), tr("Open a vd-PgF glass map to show the triplets"));
+    }
+}
+
+void ApochromatSearchForm::showDatasheet()
+{
+    QTableWidgetItem* item = ui->tableWidget_Result->currentItem();
+    if(!item){
+        return;
+    }
+
+    // glass column of the current cell, or the first glass
+    int row = item->row();
+    int col = (item->column() < 3) ? item->column() : 0;
+    GlassHandle handle = ui->tableWidget_Result->item(row, col)->data(Qt::UserRole).toUInt();
+
+    Glass* glass = GlassCatalogManager::glass(handle);
+    if(!glass){
+        return;
+    }
+
+    GlassDataSheetForm* subwindow = new GlassDataSheetForm(glass, m_parentMdiArea);
+    subwindow->setAttribute(Qt::WA_DeleteOnClose);
+    m_parentMdiArea->addSubWindow(subwindow);
+    subwindow->parentWidget()->setGeometry(0,10, this->width()*1/2,this->height()*3/4);
+    subwindow->show();
+}
+
+void ApochromatSearchForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
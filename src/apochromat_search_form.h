@@ -0,0 +1,81 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef APOCHROMAT_SEARCH_FORM_H
+#define APOCHROMAT_SEARCH_FORM_H
+
+#include <memory>
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+
+#include "apochromat_triplet_search.h"
+#include "glass_constraint_index.h"
+
+namespace Ui {
+class ApochromatSearchForm;
+}
+
+/** Form to search glass triplets of an apochromat on the vd-PgF map */
+class ApochromatSearchForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ApochromatSearchForm(QMdiArea *parent = nullptr);
+    ~ApochromatSearchForm();
+
+private slots:
+    /** Execute search and show result */
+    void showSearchResult();
+
+    /** Draw the selected triplets, or all of them, on the open vd-PgF glass maps */
+    void showOnGlassMap();
+
+    /** Show datasheet of the glass in the current cell */
+    void showDatasheet();
+
+private:
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+    inline QString numToQString(double val, char fmt='f', int digit=6);
+
+    Ui::ApochromatSearchForm *ui;
+    QMdiArea* m_parentMdiArea;
+
+    std::shared_ptr<const GlassConstraintIndex> m_constraintIndex; // source of the rows of m_triplets
+    QVector<ApochromatTripletSearch::Triplet>   m_triplets;
+};
+
+
+QString ApochromatSearchForm::numToQString(double val, char fmt, int digit)
+{
+    if(qIsNaN(val)){
+        return "-";
+    }
+    else{
+        return QString::number(val,fmt,digit);
+    }
+}
+
+#endif // APOCHROMAT_SEARCH_FORM_H
@@ -0,0 +1,196 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "apochromat_triplet_search.h"
+
+#include <algorithm>
+#include <numeric>
+#include <QtConcurrent>
+
+#include "top_k_collector.h"
+
+namespace {
+
+// third glasses bounded together
+const int kBlockSize = 32;
+
+bool lessMaxPower(const ApochromatTripletSearch::Triplet& a, const ApochromatTripletSearch::Triplet& b)
+{
+    if(a.maxPower != b.maxPower) return a.maxPower < b.maxPower;
+    for(int i = 0; i < 3; i++){
+        if(a.rows[i] != b.rows[i]) return a.rows[i] < b.rows[i];
+    }
+    return false;
+}
+
+typedef TopKCollector<ApochromatTripletSearch::Triplet, decltype(&lessMaxPower)> TripletCollector;
+
+struct Box{
+    double vmin, vmax, pmin, pmax;
+};
+
+/** distance from x to the interval [lo, hi] */
+inline double distanceTo(double x, double lo, double hi)
+{
+    return (x < lo) ? (lo - x) : ((x > hi) ? (x - hi) : 0.0);
+}
+
+} // namespace
+
+
+ApochromatTripletSearch::ApochromatTripletSearch(const GlassPropertyTable& table)
+    : table_(table),
+      max_power_ratio_(5.0),
+      evaluated_count_(0),
+      total_count_(0)
+{
+}
+
+QVector<ApochromatTripletSearch::Triplet> ApochromatTripletSearch::search(int k, const QBitArray *mask)
+{
+    evaluated_count_ = 0;
+    total_count_     = 0;
+
+    const int vdCol = table_.columnIndex("vd");
+    const int pgCol = table_.columnIndex("PgF");
+    const int ndCol = table_.columnIndex("nd");
+    if(k <= 0 || vdCol < 0 || pgCol < 0 || ndCol < 0){
+        return QVector<Triplet>();
+    }
+
+    // valid glasses sorted by vd in descending order
+    QVector<int> rows;
+    for(int r = 0; r < table_.rowCount(); r++){
+        if(mask && !mask->testBit(r)){
+            continue;
+        }
+        const double v = table_.value(r, vdCol);
+        if(qIsFinite(v) && v > 0.0 && qIsFinite(table_.value(r, pgCol)) && qIsFinite(table_.value(r, ndCol))){
+            rows.append(r);
+        }
+    }
+    std::sort(rows.begin(), rows.end(), [&](int a, int b){ return table_.value(a, vdCol) > table_.value(b, vdCol); });
+
+    const int n = rows.size();
+    QVector<double> vs(n), ps(n), ns(n);
+    for(int i = 0; i < n; i++){
+        vs[i] = table_.value(rows[i], vdCol);
+        ps[i] = table_.value(rows[i], pgCol);
+        ns[i] = table_.value(rows[i], ndCol);
+    }
+
+    // bounding boxes of the blocks
+    QVector<Box> boxes;
+    for(int b = 0; b < n; b += kBlockSize){
+        const int e = qMin(b + kBlockSize, n);
+        Box box;
+        box.vmax = vs[b];
+        box.vmin = vs[e-1];
+        box.pmin = *std::min_element(ps.begin() + b, ps.begin() + e);
+        box.pmax = *std::max_element(ps.begin() + b, ps.begin() + e);
+        boxes.append(box);
+    }
+
+    total_count_ = static_cast<qint64>(n)*(n - 1)*(n - 2)/6;
+
+    QVector<int> outer(qMax(0, n - 2));
+    std::iota(outer.begin(), outer.end(), 0);
+
+    QVector<TripletCollector> collectors(outer.size(), TripletCollector(k, lessMaxPower));
+    QVector<qint64>           evaluated(outer.size(), 0);
+
+    const double ratioLimit = max_power_ratio_;
+
+    QtConcurrent::blockingMap(outer, [&](int i){
+        TripletCollector& collector = collectors[i];
+
+        for(int j = i + 1; j < n - 1; j++)
+        {
+            // D is linear in the third glass: D = a*P + b*V + c
+            const double a = vs[j] - vs[i];
+            const double b = -(ps[j] - ps[i]);
+            const double c = -a*ps[i] - b*vs[i];
+            const double dpij = fabs(ps[i] - ps[j]);
+
+            int kBegin = j + 1;
+            while(kBegin < n)
+            {
+                const int block = kBegin/kBlockSize;
+                const int kEnd  = qMin((block + 1)*kBlockSize, n);
+
+                // the current worst of the top K tightens the limit
+                const double ratio = collector.isFull() ? qMin(ratioLimit, collector.worst().maxPower) : ratioLimit;
+
+                // largest |D| over the box is at one of its corners
+                const Box& box = boxes[block];
+                const double dmax = qMax(qMax(fabs(a*box.pmin + b*box.vmin + c), fabs(a*box.pmin + b*box.vmax + c)),
+                                         qMax(fabs(a*box.pmax + b*box.vmin + c), fabs(a*box.pmax + b*box.vmax + c)));
+
+                // each element needs |D| >= V*|dP|/ratio
+                const double need = qMax(box.vmin*dpij,
+                                         qMax(vs[i]*distanceTo(ps[j], box.pmin, box.pmax),
+                                              vs[j]*distanceTo(ps[i], box.pmin, box.pmax)))/ratio;
+
+                if(dmax < need){
+                    kBegin = kEnd;
+                    continue;
+                }
+
+                evaluated[i] += kEnd - kBegin;
+
+                for(int kk = kBegin; kk < kEnd; kk++)
+                {
+                    const double d = a*ps[kk] + b*vs[kk] + c;
+                    if(d == 0.0){
+                        continue;
+                    }
+
+                    Triplet t;
+                    t.rows[0]   = rows[i];
+                    t.rows[1]   = rows[j];
+                    t.rows[2]   = rows[kk];
+                    t.powers[0] = vs[i]*(ps[j] - ps[kk])/d;
+                    t.powers[1] = vs[j]*(ps[kk] - ps[i])/d;
+                    t.powers[2] = vs[kk]*(ps[i] - ps[j])/d;
+                    t.maxPower  = qMax(fabs(t.powers[0]), qMax(fabs(t.powers[1]), fabs(t.powers[2])));
+
+                    if(t.maxPower <= ratioLimit && collector.accepts(t)){
+                        t.petzval = t.powers[0]/ns[i] + t.powers[1]/ns[j] + t.powers[2]/ns[kk];
+                        collector.push(t);
+                    }
+                }
+
+                kBegin = kEnd;
+            }
+        }
+    });
+
+    TripletCollector merged(k, lessMaxPower);
+    for(int i = 0; i < collectors.size(); i++){
+        merged.merge(collectors[i]);
+        evaluated_count_ += evaluated[i];
+    }
+
+    return merged.sorted();
+}
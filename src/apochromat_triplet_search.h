@@ -0,0 +1,82 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef APOCHROMAT_TRIPLET_SEARCH_H
+#define APOCHROMAT_TRIPLET_SEARCH_H
+
+#include <QVector>
+#include <QBitArray>
+
+#include "glass_property_table.h"
+
+/**
+ * @brief Thin lens apochromatic triplet search on the vd-PgF map
+ * @details
+ * Three thin lenses in contact are corrected for the primary and the secondary spectrum when
+ * sum(phi_i/V_i) = 0 and sum(phi_i*P_i/V_i) = 0, which gives
+ *     phi_1/phi = V_1*(P_2 - P_3)/D,  D = V_1*(P_2 - P_3) + V_2*(P_3 - P_1) + V_3*(P_1 - P_2)
+ * and so on cyclically.  D is twice the signed area of the triangle of the three glasses on the map,
+ * so the element powers are weak when the triangle is large.  Triplets are ranked by the maximum
+ * element power ratio.
+ *
+ * Glasses are sorted by vd and the third glass is scanned in blocks with bounding boxes.
+ * A block is skipped when even the largest triangle area over its box cannot keep the element powers
+ * under the limit, or under the worst of the current top K.  The outer loop is parallelized.
+ */
+class ApochromatTripletSearch
+{
+public:
+    struct Triplet{
+        int    rows[3];   // rows of the property table, in descending order of vd
+        double powers[3]; // normalized by the total power
+        double maxPower;  // max of |powers|
+        double petzval;   // sum of powers[i]/nd_i
+    };
+
+    /** @param table property table which has vd, PgF and nd columns */
+    explicit ApochromatTripletSearch(const GlassPropertyTable& table);
+
+    /** triplets whose element power exceeds ratio times the total power are pruned */
+    void setMaxPowerRatio(double ratio){ max_power_ratio_ = ratio; }
+
+    /**
+     * @param mask if given, only the rows whose bit is set are used
+     * @return at most k triplets in ascending order of maxPower
+     */
+    QVector<Triplet> search(int k, const QBitArray* mask = nullptr);
+
+    /** number of triplets evaluated by the last search */
+    qint64 evaluatedTripletCount() const{ return evaluated_count_; }
+
+    /** number of all the candidate triplets of the last search */
+    qint64 totalTripletCount() const{ return total_count_; }
+
+private:
+    const GlassPropertyTable& table_;
+    double max_power_ratio_;
+    qint64 evaluated_count_;
+    qint64 total_count_;
+};
+
+#endif // APOCHROMAT_TRIPLET_SEARCH_H
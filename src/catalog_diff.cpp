@@ -0,0 +1,244 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "catalog_diff.h"
+
+#include <numeric>
+#include <QHash>
+#include <QSet>
+#include <QFileInfo>
+#include <QtConcurrent>
+
+#include "load_diagnostics.h"
+
+namespace {
+
+const Glass::ContentSection kSections[] = {Glass::DispersionSection, Glass::ThermalSection, Glass::TransmittanceSection, Glass::OtherSection};
+const int kSectionCount = 4;
+
+struct GlassHashes{
+    quint64 h[kSectionCount];
+};
+
+QVector<GlassHashes> computeHashes(const GlassCatalog* catalog)
+{
+    // sections are hashed for every glass, so the deferred data is read at once
+    catalog->loadDeferredSections();
+
+    QVector<GlassHashes> hashes(catalog->glassCount());
+    QVector<int> indices(catalog->glassCount());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QtConcurrent::blockingMap(indices, [&](int i){
+        const Glass* g = catalog->glass(i);
+        for(int s = 0; s < kSectionCount; s++){
+            hashes[i].h[s] = g->contentHash(kSections[s]);
+        }
+    });
+    return hashes;
+}
+
+CatalogDiff::Entry makeEntry(const QString& supplier, const QString& name, CatalogDiff::ChangeType type, int sections,
+                             const Glass* before, const Glass* after)
+{
+    CatalogDiff::Entry e;
+    e.supplier = supplier;
+    e.name     = name;
+    e.type     = type;
+    e.sections = sections;
+    e.ndBefore = before ? before->getValue("nd") : qQNaN();
+    e.vdBefore = before ? before->getValue("vd") : qQNaN();
+    e.ndAfter  = after  ? after->getValue("nd")  : qQNaN();
+    e.vdAfter  = after  ? after->getValue("vd")  : qQNaN();
+    return e;
+}
+
+} // namespace
+
+
+CatalogDiff::CatalogDiff()
+    : unchanged_count_(0)
+{
+}
+
+bool CatalogDiff::loadCatalogs(const QStringList &filePaths, std::vector<std::unique_ptr<GlassCatalog> > &catalogs, QString *errorMessage)
+{
+    catalogs.clear();
+    catalogs.resize(filePaths.size());
+
+    QVector<int> indices(filePaths.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    QVector<bool> loaded(filePaths.size(), false);
+
+    QtConcurrent::blockingMap(indices, [&](int i){
+        catalogs[i].reset(new GlassCatalog);
+        LoadDiagnostics diagnostics;
+
+        // .agf, .xml, .agf.gz, .xml.gz
+        QString filename = QFileInfo(filePaths[i]).fileName().toLower();
+        if(filename.endsWith(".gz")){
+            filename.chop(3);
+        }
+        if(filename.endsWith(".agf")){
+            loaded[i] = catalogs[i]->loadAGF(filePaths[i], diagnostics);
+        }else{
+            loaded[i] = catalogs[i]->loadXml(filePaths[i], diagnostics);
+        }
+    });
+
+    for(int i = 0; i < filePaths.size(); i++){
+        if(!loaded[i]){
+            if(errorMessage) *errorMessage = "Failed to load " + filePaths[i];
+            catalogs.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void CatalogDiff::compare(const QList<const GlassCatalog *> &before, const QList<const GlassCatalog *> &after)
+{
+    entries_.clear();
+    unchanged_count_ = 0;
+
+    QHash<QString, const GlassCatalog*> beforeBySupplier;
+    for(auto cat : before){
+        beforeBySupplier.insert(cat->supplier(), cat);
+    }
+
+    QSet<QString> paired;
+    for(auto cat : after){
+        const GlassCatalog* old = beforeBySupplier.value(cat->supplier(), nullptr);
+        compareCatalogs(old, cat);
+        paired.insert(cat->supplier());
+    }
+    for(auto cat : before){
+        if(!paired.contains(cat->supplier())){
+            compareCatalogs(cat, nullptr);
+        }
+    }
+}
+
+void CatalogDiff::compareCatalogs(const GlassCatalog *before, const GlassCatalog *after)
+{
+    const QString supplier = after ? after->supplier() : before->supplier();
+
+    if(!before){
+        for(int i = 0; i < after->glassCount(); i++){
+            const Glass* g = after->glass(i);
+            entries_.append(makeEntry(supplier, g->productName(), Added, 0, nullptr, g));
+        }
+        return;
+    }
+    if(!after){
+        for(int i = 0; i < before->glassCount(); i++){
+            const Glass* g = before->glass(i);
+            entries_.append(makeEntry(supplier, g->productName(), Removed, 0, g, nullptr));
+        }
+        return;
+    }
+
+    QVector<GlassHashes> beforeHashes, afterHashes;
+    QFuture<void> f = QtConcurrent::run([&](){ beforeHashes = computeHashes(before); });
+    afterHashes = computeHashes(after);
+    f.waitForFinished();
+
+    QHash<QString, int> beforeIndex;
+    beforeIndex.reserve(before->glassCount());
+    for(int i = 0; i < before->glassCount(); i++){
+        beforeIndex.insert(before->glass(i)->productName(), i);
+    }
+
+    QVector<bool> matched(before->glassCount(), false);
+    for(int j = 0; j < after->glassCount(); j++){
+        const Glass* g = after->glass(j);
+        auto it = beforeIndex.constFind(g->productName());
+        if(it == beforeIndex.constEnd()){
+            entries_.append(makeEntry(supplier, g->productName(), Added, 0, nullptr, g));
+            continue;
+        }
+
+        const int i = it.value();
+        matched[i] = true;
+
+        int sections = 0;
+        for(int s = 0; s < kSectionCount; s++){
+            if(beforeHashes[i].h[s] != afterHashes[j].h[s]){
+                sections |= kSections[s];
+            }
+        }
+
+        if(0 == sections){
+            unchanged_count_++;
+        }
+        else{
+            entries_.append(makeEntry(supplier, g->productName(), Modified, sections, before->glass(i), g));
+        }
+    }
+
+    for(int i = 0; i < before->glassCount(); i++){
+        if(!matched[i]){
+            const Glass* g = before->glass(i);
+            entries_.append(makeEntry(supplier, g->productName(), Removed, 0, g, nullptr));
+        }
+    }
+}
+
+int CatalogDiff::count(ChangeType type) const
+{
+    return std::count_if(entries_.begin(), entries_.end(), [type](const Entry& e){ return e.type == type; });
+}
+
+QString CatalogDiff::changeTypeName(ChangeType type)
+{
+    switch(type){
+    case Added:    return "added";
+    case Removed:  return "removed";
+    case Modified: return "modified";
+    }
+    return QString();
+}
+
+QString CatalogDiff::sectionNames(int sections)
+{
+    QStringList names;
+    if(sections & Glass::DispersionSection)    names.append("dispersion");
+    if(sections & Glass::ThermalSection)       names.append("thermal");
+    if(sections & Glass::TransmittanceSection) names.append("transmittance");
+    if(sections & Glass::OtherSection)         names.append("other");
+    return names.join("|");
+}
+
+void CatalogDiff::writeCsv(QTextStream &out) const
+{
+    // empty for the glasses only in one version
+    auto number = [](double v, char format, int precision){ return qIsFinite(v) ? QString::number(v, format, precision) : QString(); };
+
+    out << "Supplier,Glass,Change,Sections,nd before,nd after,dnd,vd before,vd after,dvd" << "\n";
+    for(auto &e : entries_){
+        out << e.supplier << "," << e.name << "," << changeTypeName(e.type) << "," << sectionNames(e.sections) << ","
+            << number(e.ndBefore, 'f', 6) << "," << number(e.ndAfter, 'f', 6) << "," << number(e.ndAfter - e.ndBefore, 'e', 2) << ","
+            << number(e.vdBefore, 'f', 2) << "," << number(e.vdAfter, 'f', 2) << "," << number(e.vdAfter - e.vdBefore, 'e', 2) << "\n";
+    }
+}
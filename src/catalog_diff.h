@@ -0,0 +1,94 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef CATALOG_DIFF_H
+#define CATALOG_DIFF_H
+
+#include <memory>
+#include <vector>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QTextStream>
+
+#include "glass_catalog.h"
+
+/**
+ * @brief Differences between two versions of glass catalogs
+ * @details
+ * Catalogs are paired by supplier and glasses by product name through a hash index.
+ * Content hashes of the data sections of every glass are computed in parallel,
+ * so that unchanged glasses are skipped by comparing four integers.
+ */
+class CatalogDiff
+{
+public:
+    enum ChangeType{
+        Added,
+        Removed,
+        Modified
+    };
+
+    struct Entry{
+        QString    supplier;
+        QString    name;
+        ChangeType type;
+        int        sections;  // Glass::ContentSection flags changed
+        double     ndBefore;
+        double     ndAfter;
+        double     vdBefore;
+        double     vdAfter;
+    };
+
+    CatalogDiff();
+
+    /** compare the catalog versions.  Catalogs without a counterpart are reported as all added or all removed. */
+    void compare(const QList<const GlassCatalog*>& before, const QList<const GlassCatalog*>& after);
+
+    /**
+     * @brief Load catalog files without the load filter, in parallel
+     * @return false with the failed file path if any file could not be loaded
+     */
+    static bool loadCatalogs(const QStringList& filePaths, std::vector< std::unique_ptr<GlassCatalog> >& catalogs, QString* errorMessage = nullptr);
+
+    const QVector<Entry>& entries() const{ return entries_; }
+    int count(ChangeType type) const;
+    int unchangedCount() const{ return unchanged_count_; }
+
+    static QString changeTypeName(ChangeType type);
+
+    /** e.g. "dispersion|thermal" */
+    static QString sectionNames(int sections);
+
+    /** one row per changed glass */
+    void writeCsv(QTextStream& out) const;
+
+private:
+    void compareCatalogs(const GlassCatalog* before, const GlassCatalog* after);
+
+    QVector<Entry> entries_;
+    int            unchanged_count_;
+};
+
+#endif // CATALOG_DIFF_H
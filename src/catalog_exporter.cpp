@@ -0,0 +1,353 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "catalog_exporter.h"
+
+#include <cstring>
+#include <QFile>
+#include <QSysInfo>
+#include <QtConcurrent>
+
+namespace {
+
+// number of rows computed at once for CSV
+const int kRowBlockSize = 4096;
+
+QByteArray csvField(const QString& str)
+{
+    QByteArray bytes = str.toUtf8();
+    if(bytes.contains(',') || bytes.contains('"') || bytes.contains('\n') || bytes.contains('\r')){
+        bytes.replace("\"", "\"\"");
+        bytes.prepend('"');
+        bytes.append('"');
+    }
+    return bytes;
+}
+
+void appendLE(QByteArray& bytes, quint8 v)
+{
+    bytes.append(static_cast<char>(v));
+}
+
+void appendLE(QByteArray& bytes, quint32 v)
+{
+    for(int i = 0; i < 4; i++){
+        bytes.append(static_cast<char>((v >> (8*i)) & 0xff));
+    }
+}
+
+void appendLE(QByteArray& bytes, quint64 v)
+{
+    for(int i = 0; i < 8; i++){
+        bytes.append(static_cast<char>((v >> (8*i)) & 0xff));
+    }
+}
+
+void appendText(QByteArray& bytes, const QString& str)
+{
+    QByteArray utf8 = str.toUtf8();
+    appendLE(bytes, static_cast<quint32>(utf8.size()));
+    bytes.append(utf8);
+}
+
+} // namespace
+
+
+CatalogExporter::CatalogExporter(CatalogSnapshotPtr snapshot)
+    : snapshot_(snapshot),
+      digit_(17)
+{
+    for(auto &cat : snapshot_->catalogs()){
+        int glassCount = cat->glassCount();
+        for(int i = 0; i < glassCount; i++){
+            rows_.append(cat->glass(i));
+        }
+    }
+}
+
+const QVector<CatalogExporter::Column>& CatalogExporter::allColumns()
+{
+    static const QVector<Column> columns = [](){
+        QVector<Column> cols;
+        auto text = [&cols](const QString& name, std::function<QString(const Glass*)> f){
+            cols.append({name, true, nullptr, f});
+        };
+        auto num = [&cols](const QString& name, std::function<double(const Glass*)> f){
+            cols.append({name, false, f, nullptr});
+        };
+
+        text("supplier", [](const Glass* g){ return g->supplier(); });
+        text("name",     [](const Glass* g){ return g->productName(); });
+        text("status",   [](const Glass* g){ return g->status(); });
+        text("MIL",      [](const Glass* g){ return g->MIL(); });
+        text("comment",  [](const Glass* g){ return g->comment(); });
+        text("formula",  [](const Glass* g){ return g->formulaName(); });
+
+        const QStringList indices = {"nd", "ne", "vd", "ve", "PgF", "PCt_", "eta1", "eta2"};
+        for(const QString& s : indices){
+            num(s, [s](const Glass* g){ return g->getValue(s); });
+        }
+
+        for(int ci = 0; ci < 12; ci++){
+            num("C" + QString::number(ci), [ci](const Glass* g){
+                return (ci < g->dispersionCoefCount()) ? g->dispersionCoef(ci) : qQNaN();
+            });
+        }
+
+        num("D0",   [](const Glass* g){ return g->D0(); });
+        num("D1",   [](const Glass* g){ return g->D1(); });
+        num("D2",   [](const Glass* g){ return g->D2(); });
+        num("E0",   [](const Glass* g){ return g->E0(); });
+        num("E1",   [](const Glass* g){ return g->E1(); });
+        num("Ltk",  [](const Glass* g){ return g->Ltk(); });
+        num("Tref", [](const Glass* g){ return g->Tref(); });
+
+        num("Low TCE",          [](const Glass* g){ return g->lowTCE(); });
+        num("High TCE",         [](const Glass* g){ return g->highTCE(); });
+        num("Relative Cost",    [](const Glass* g){ return g->relCost(); });
+        num("Climate Resist",   [](const Glass* g){ return g->climateResist(); });
+        num("Stain Resist",     [](const Glass* g){ return g->stainResist(); });
+        num("Acid Resist",      [](const Glass* g){ return g->acidResist(); });
+        num("Alkali Resist",    [](const Glass* g){ return g->alkaliResist(); });
+        num("Phosphate Resist", [](const Glass* g){ return g->phosphateResist(); });
+        num("Lambda Min",       [](const Glass* g){ return g->lambdaMin(); });
+        num("Lambda Max",       [](const Glass* g){ return g->lambdaMax(); });
+
+        return cols;
+    }();
+
+    return columns;
+}
+
+QStringList CatalogExporter::propertyNames()
+{
+    QStringList names;
+    for(auto &c : allColumns()){
+        names.append(c.name);
+    }
+    return names;
+}
+
+void CatalogExporter::setProperties(const QStringList& names)
+{
+    const QVector<Column>& cols = allColumns();
+
+    columns_.clear();
+    for(const QString& name : names){
+        for(int i = 0; i < cols.size(); i++){
+            if(cols[i].name == name){
+                columns_.append(i);
+                break;
+            }
+        }
+    }
+}
+
+QStringList CatalogExporter::properties() const
+{
+    QStringList names;
+    for(int ci : columns_){
+        names.append(allColumns()[ci].name);
+    }
+    return names;
+}
+
+void CatalogExporter::computeColumns(const QVector<int>& columns, int rowBegin, int rowEnd, QVector< QVector<double> >& values) const
+{
+    values.resize(columns.size());
+
+    QVector<int> tasks(columns.size());
+    for(int i = 0; i < tasks.size(); i++){
+        tasks[i] = i;
+    }
+
+    // one task per column; each task writes only its own array
+    QtConcurrent::blockingMap(tasks, [&](int task){
+        const Column& col = allColumns()[columns[task]];
+        QVector<double>& v = values[task];
+        v.resize(rowEnd - rowBegin);
+        for(int r = rowBegin; r < rowEnd; r++){
+            v[r - rowBegin] = col.value(rows_[r]);
+        }
+    });
+}
+
+bool CatalogExporter::exportToFile(const QString& filePath, Format format)
+{
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        error_string_ = file.errorString();
+        return false;
+    }
+
+    bool ok = write(&file, format);
+    file.close();
+    return ok;
+}
+
+bool CatalogExporter::write(QIODevice* device, Format format)
+{
+    error_string_.clear();
+
+    if(columns_.isEmpty()){
+        error_string_ = "No properties to export";
+        return false;
+    }
+
+    if(Binary == format){
+        return writeBinary(device);
+    }
+    return writeCSV(device);
+}
+
+bool CatalogExporter::writeBytes(QIODevice* device, const QByteArray& bytes)
+{
+    if(device->write(bytes) != bytes.size()){
+        error_string_ = device->errorString();
+        return false;
+    }
+    return true;
+}
+
+bool CatalogExporter::writeCSV(QIODevice* device)
+{
+    const QVector<Column>& cols = allColumns();
+
+    // header
+    QByteArray buf;
+    for(int i = 0; i < columns_.size(); i++){
+        if(i > 0) buf.append(',');
+        buf.append(csvField(cols[columns_[i]].name));
+    }
+    buf.append('\n');
+
+    // numeric columns are computed per block, text columns while writing
+    QVector<int> numericColumns;
+    QVector<int> numericSlot(columns_.size(), -1);
+    for(int i = 0; i < columns_.size(); i++){
+        if(!cols[columns_[i]].isText){
+            numericSlot[i] = numericColumns.size();
+            numericColumns.append(columns_[i]);
+        }
+    }
+
+    QVector< QVector<double> > values;
+    for(int rowBegin = 0; rowBegin < rows_.size(); rowBegin += kRowBlockSize)
+    {
+        int rowEnd = qMin(rowBegin + kRowBlockSize, rows_.size());
+        computeColumns(numericColumns, rowBegin, rowEnd, values);
+
+        for(int r = rowBegin; r < rowEnd; r++){
+            for(int i = 0; i < columns_.size(); i++){
+                if(i > 0) buf.append(',');
+
+                if(numericSlot[i] < 0){
+                    buf.append(csvField(cols[columns_[i]].text(rows_[r])));
+                }else{
+                    double val = values[numericSlot[i]][r - rowBegin];
+                    if(!qIsNaN(val)){
+                        buf.append(QByteArray::number(val, 'g', digit_));
+                    }
+                }
+            }
+            buf.append('\n');
+        }
+
+        if(!writeBytes(device, buf)){
+            return false;
+        }
+        buf.clear();
+    }
+
+    return writeBytes(device, buf);
+}
+
+bool CatalogExporter::writeBinary(QIODevice* device)
+{
+    const QVector<Column>& cols = allColumns();
+    const int rowCount = rows_.size();
+
+    // header
+    QByteArray buf("GPCOLUMN");
+    appendLE(buf, static_cast<quint32>(1));
+    appendLE(buf, static_cast<quint64>(rowCount));
+    appendLE(buf, static_cast<quint32>(columns_.size()));
+    for(int ci : columns_){
+        appendLE(buf, static_cast<quint8>(cols[ci].isText ? 1 : 0));
+        appendText(buf, cols[ci].name);
+    }
+    if(!writeBytes(device, buf)){
+        return false;
+    }
+
+    // Columns are written in the header order.  Consecutive numeric columns are computed together
+    // in batches of the thread count so that the memory use stays bounded.
+    const int batchSize = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+    QVector< QVector<double> > values;
+
+    int i = 0;
+    while(i < columns_.size())
+    {
+        if(cols[columns_[i]].isText){
+            buf.clear();
+            for(int r = 0; r < rowCount; r++){
+                appendText(buf, cols[columns_[i]].text(rows_[r]));
+            }
+            if(!writeBytes(device, buf)){
+                return false;
+            }
+            i++;
+            continue;
+        }
+
+        QVector<int> batch;
+        while(i < columns_.size() && !cols[columns_[i]].isText && batch.size() < batchSize){
+            batch.append(columns_[i]);
+            i++;
+        }
+
+        computeColumns(batch, 0, rowCount, values);
+
+        for(auto &v : values){
+            if(QSysInfo::ByteOrder == QSysInfo::LittleEndian){
+                QByteArray raw = QByteArray::fromRawData(reinterpret_cast<const char*>(v.constData()), v.size()*static_cast<int>(sizeof(double)));
+                if(!writeBytes(device, raw)){
+                    return false;
+                }
+            }else{
+                buf.clear();
+                for(double val : v){
+                    quint64 bits;
+                    memcpy(&bits, &val, sizeof(bits));
+                    appendLE(buf, bits);
+                }
+                if(!writeBytes(device, buf)){
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
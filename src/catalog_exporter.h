@@ -0,0 +1,99 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef CATALOG_EXPORTER_H
+#define CATALOG_EXPORTER_H
+
+#include <functional>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QIODevice>
+
+#include "catalog_snapshot.h"
+
+/**
+ * @brief Writes glass properties of all catalogs in a snapshot to a file
+ * @details
+ * Each property is one column and each glass is one row.  Numeric columns are computed in parallel in blocks
+ * and written directly to the device, so no table of the whole output is built in memory.
+ *
+ * Binary column file layout (little endian):
+ *  - "GPCOLUMN" (8 bytes), version (quint32), row count (quint64), column count (quint32)
+ *  - per column: type (quint8, 0 = float64, 1 = UTF-8 text), name length (quint32), name (UTF-8)
+ *  - per column in the header order: row count doubles (NaN if not available),
+ *    or row count pairs of length (quint32) and text (UTF-8)
+ */
+class CatalogExporter
+{
+public:
+    enum Format{
+        CSV,
+        Binary
+    };
+
+    explicit CatalogExporter(CatalogSnapshotPtr snapshot);
+
+    /** names of all the exportable properties */
+    static QStringList propertyNames();
+
+    /** set the columns to be written.  Unknown names are ignored. */
+    void setProperties(const QStringList& names);
+    QStringList properties() const;
+
+    /** significant digits of the numbers in CSV */
+    void setDigit(int digit){ digit_ = digit; }
+
+    int rowCount() const{ return rows_.size(); }
+
+    bool exportToFile(const QString& filePath, Format format);
+    bool write(QIODevice* device, Format format);
+
+    QString errorString() const{ return error_string_; }
+
+private:
+    struct Column{
+        QString name;
+        bool    isText;
+        std::function<double(const Glass*)>  value;
+        std::function<QString(const Glass*)> text;
+    };
+
+    static const QVector<Column>& allColumns();
+
+    /** compute the numeric columns for the rows in [rowBegin, rowEnd) */
+    void computeColumns(const QVector<int>& columns, int rowBegin, int rowEnd, QVector< QVector<double> >& values) const;
+
+    bool writeCSV(QIODevice* device);
+    bool writeBinary(QIODevice* device);
+    bool writeBytes(QIODevice* device, const QByteArray& bytes);
+
+    CatalogSnapshotPtr      snapshot_;
+    QVector<const Glass*>   rows_;
+    QVector<int>            columns_;
+    int                     digit_;
+    QString                 error_string_;
+};
+
+#endif // CATALOG_EXPORTER_H
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "catalog_snapshot.h"
+
+CatalogSnapshot::CatalogSnapshot()
+{
+    handle_table_.append(nullptr); // 0 is invalid
+}
+
+CatalogSnapshot::CatalogSnapshot(const QVector< std::shared_ptr<GlassCatalog> >& catalogs, const HandleIndex& handleIndex) :
+    catalogs_(catalogs),
+    handle_index_(handleIndex)
+{
+    handle_table_.fill(nullptr, handle_index_.size() + 1);
+
+    for(auto &cat : catalogs_){
+        int glassCount = cat->glassCount();
+        for(int i = 0; i < glassCount; i++){
+            Glass* g = cat->glass(i);
+            if(g->handle() > 0 && g->handle() < static_cast<GlassHandle>(handle_table_.size())){
+                handle_table_[g->handle()] = g;
+            }
+        }
+    }
+}
+
+GlassCatalog* CatalogSnapshot::catalog(int n) const
+{
+    if(n >= 0 && n < catalogs_.size()){
+        return catalogs_[n].get();
+    }
+    return nullptr;
+}
+
+Glass* CatalogSnapshot::glass(GlassHandle handle) const
+{
+    if(handle < static_cast<GlassHandle>(handle_table_.size())){
+        return handle_table_[handle];
+    }
+    return nullptr;
+}
+
+GlassHandle CatalogSnapshot::handle(const QString &supplier, const QString &productName) const
+{
+    return handle_index_.value(qMakePair(supplier, productName), 0);
+}
+
+Glass* CatalogSnapshot::find(const QString &fullName) const
+{
+    int sep = fullName.indexOf('_');
+    while(sep >= 0){
+        Glass* g = find(fullName.mid(sep + 1), fullName.left(sep));
+        if(g){
+            return g;
+        }
+        sep = fullName.indexOf('_', sep + 1);
+    }
+
+    return nullptr;
+}
+
+Glass* CatalogSnapshot::find(const QString &supplier, const QString &productName) const
+{
+    return glass(handle(supplier, productName));
+}
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef CATALOG_SNAPSHOT_H
+#define CATALOG_SNAPSHOT_H
+
+#include <memory>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+#include <QString>
+
+#include "glass_catalog.h"
+
+/**
+ * @brief Immutable set of loaded catalogs
+ * @details A snapshot is never modified after it is published by GlassCatalogManager.
+ *          Catalogs are shared between snapshots and freed when the last snapshot holding them is released,
+ *          so glasses obtained from a snapshot stay valid as long as the snapshot is held.
+ */
+class CatalogSnapshot
+{
+public:
+    typedef QHash<QPair<QString, QString>, GlassHandle> HandleIndex; // (supplier, product name) -> handle
+
+    CatalogSnapshot();
+    CatalogSnapshot(const QVector< std::shared_ptr<GlassCatalog> >& catalogs, const HandleIndex& handleIndex);
+
+    int  catalogCount() const{ return catalogs_.size(); }
+    bool isEmpty() const{ return catalogs_.isEmpty(); }
+
+    GlassCatalog* catalog(int n) const;
+    const QVector< std::shared_ptr<GlassCatalog> >& catalogs() const{ return catalogs_; }
+
+    /** @return nullptr if the glass is not in this snapshot */
+    Glass* glass(GlassHandle handle) const;
+    GlassHandle handle(const QString& supplier, const QString& productName) const;
+
+    /**
+     * @brief Find a glass by "<product name>_<supplier>"
+     * @details Every "_" is tried as the separator, as product and supplier names may contain "_".
+     */
+    Glass* find(const QString& fullName) const;
+    Glass* find(const QString& supplier, const QString& productName) const;
+
+private:
+    QVector< std::shared_ptr<GlassCatalog> > catalogs_;
+    HandleIndex     handle_index_;
+    QVector<Glass*> handle_table_; // handle -> glass
+};
+
+typedef std::shared_ptr<const CatalogSnapshot> CatalogSnapshotPtr;
+
+#endif // CATALOG_SNAPSHOT_H
@@ -35,6 +35,7 @@
 #include "glass_catalog_manager.h"
 #include "glass_datasheet_form.h"
 #include "catalog_view_setting_dialog.h"
+#include "user_property_registry.h"
 
 CatalogViewForm::CatalogViewForm(QMdiArea *parent) :
     QWidget(parent),
@@ -46,13 +47,16 @@ CatalogViewForm::CatalogViewForm(QMdiArea *parent) :
     m_parentMdiArea = parent;
 
     m_comboBox = ui->comboBox_Supplyer;
-    for(int i = 0; i < GlassCatalogManager::catalogList().size(); i++){
-        m_comboBox->addItem(GlassCatalogManager::catalogList().at(i)->supplier());
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    for(int i = 0; i < snapshot->catalogCount(); i++){
+        m_comboBox->addItem(snapshot->catalog(i)->supplier());
     }
 
     QObject::connect(m_comboBox,                  SIGNAL(currentIndexChanged(int)), this, SLOT(update()));
     QObject::connect(ui->pushButton_showDatasheet,SIGNAL(clicked()),                this, SLOT(showDatasheet()));
     QObject::connect(ui->pushButton_Setting,      SIGNAL(clicked()),                this, SLOT(showSettingDlg()));
+    QObject::connect(ui->lineEdit_Filter,         SIGNAL(textChanged(QString)),     this, SLOT(update()));
+    QObject::connect(GlassCatalogManager::instance(), SIGNAL(catalogReloaded(int)), this, SLOT(onCatalogReloaded(int)));
 
     m_table = ui->tableWidget;
     m_table->setSortingEnabled(true);
@@ -97,7 +101,51 @@ CatalogViewForm::~CatalogViewForm()
 
 void CatalogViewForm::update()
 {
-    setUpTable(m_currentPropertyList, GlassCatalogManager::catalogList().at( m_comboBox->currentIndex() ), m_currentDigit);
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    int catalogIndex = m_comboBox->currentIndex();
+    GlassCatalog* catalog = snapshot->catalog(catalogIndex);
+    if(!catalog){
+        return;
+    }
+    setUpTable(m_currentPropertyList, catalog, filteredGlassIndices(snapshot, catalogIndex), m_currentDigit);
+}
+
+QList<int> CatalogViewForm::filteredGlassIndices(const CatalogSnapshotPtr& snapshot, int catalogIndex)
+{
+    QList<int> indices;
+    int glassCount = snapshot->catalog(catalogIndex)->glassCount();
+
+    QString errorMessage;
+    GlassConstraintQuery query = GlassConstraintQuery::parse(ui->lineEdit_Filter->text(), &errorMessage);
+    if(query.isEmpty()){
+        ui->lineEdit_Filter->setToolTip(errorMessage);
+        for(int i = 0; i < glassCount; i++){
+            indices.append(i);
+        }
+        return indices;
+    }
+
+    auto index = GlassConstraintIndex::instance(snapshot);
+    QBitArray bits = index->select(query, &errorMessage);
+    ui->lineEdit_Filter->setToolTip(errorMessage);
+
+    int offset = index->table().rowOffset(catalogIndex);
+    for(int i = 0; i < glassCount; i++){
+        if(bits.testBit(offset + i)){
+            indices.append(i);
+        }
+    }
+    return indices;
+}
+
+void CatalogViewForm::onCatalogReloaded(int catalogIndex)
+{
+    m_comboBox->setItemText(catalogIndex, GlassCatalogManager::snapshot()->catalog(catalogIndex)->supplier());
+
+    // the table shows only one catalog, so other catalogs are not concerned
+    if(catalogIndex == m_comboBox->currentIndex()){
+        update();
+    }
 }
 
 void CatalogViewForm::addTableItem(int row, int col, QString str)
@@ -108,8 +156,32 @@ void CatalogViewForm::addTableItem(int row, int col, QString str)
 }
 
 
-void CatalogViewForm::setUpTable(QStringList properties, GlassCatalog* catalog, int digit)
+void CatalogViewForm::setUpTable(QStringList properties, GlassCatalog* catalog, const QList<int>& glassIndices, int digit)
 {
+    /***************************************
+     *
+     * user defined properties are evaluated at once
+     *
+     ***************************************/
+    QVector<const Glass*> glasses;
+    for(int i : glassIndices){
+        glasses.append(catalog->glass(i));
+    }
+
+    QMap<QString, QVector<double> > userValues;
+    for(int j = properties.size() - 1; j >= 0; j--){
+        if(m_allPropertyList.contains(properties[j])){
+            continue;
+        }
+        std::shared_ptr<const PropertyExpression> expression = UserPropertyRegistry::find(properties[j]);
+        if(expression){
+            userValues.insert(properties[j], expression->evaluate(glasses));
+        }
+        else{
+            // removed from the registry
+            properties.removeAt(j);
+        }
+    }
 
     /***************************************
      *
@@ -184,9 +256,12 @@ void CatalogViewForm::setUpTable(QStringList properties, GlassCatalog* catalog,
         else if("Phosphate Resist" == properties[j]){
             headerLabels.append("Phosphate Resist");
         }
+        else if(userValues.contains(properties[j])){
+            headerLabels.append(properties[j]);
+        }
     }
 
-    int rowCount    = catalog->glassCount();
+    int rowCount    = glassIndices.size();
     int columnCount = headerLabels.size();
     m_table->clear();
     m_table->setSortingEnabled(false);
@@ -205,10 +280,11 @@ void CatalogViewForm::setUpTable(QStringList properties, GlassCatalog* catalog,
     for(int i = 0; i < rowCount; i++)
     {
         row = i;
-        glass = catalog->glass(i);
+        glass = catalog->glass(glassIndices[i]);
 
         // glass name should be at the first column.
         addTableItem(i,0,glass->productName());
+        m_table->item(i,0)->setData(Qt::UserRole, glass->handle());
 
         // properties
         col = 1;
@@ -280,6 +356,9 @@ void CatalogViewForm::setUpTable(QStringList properties, GlassCatalog* catalog,
             else if("Phosphate Resist" == properties[j]){
                 addTableItem(row, col, numToQString(glass->phosphateResist(), 'f', digit));
             }
+            else if(userValues.contains(properties[j])){
+                addTableItem(row, col, numToQString(userValues[properties[j]][i], 'g', digit));
+            }
             col++;
         }
     }
@@ -290,13 +369,15 @@ void CatalogViewForm::setUpTable(QStringList properties, GlassCatalog* catalog,
 
 void CatalogViewForm::showDatasheet()
 {
-    // get catalog name and glass name of the current row
-    QString supplyername = m_comboBox->currentText();
-    QString productname    = m_table->item(m_table->currentRow(),0)->text();
-    QString fullname = productname + "_" + supplyername;
+    // get glass of the current row
+    GlassHandle handle = m_table->item(m_table->currentRow(),0)->data(Qt::UserRole).toUInt();
+    Glass* glass = GlassCatalogManager::glass(handle);
+    if(!glass){
+        return;
+    }
 
     // show glass datasheet form
-    GlassDataSheetForm* subwindow = new GlassDataSheetForm(GlassCatalogManager::find(fullname), m_parentMdiArea);
+    GlassDataSheetForm* subwindow = new GlassDataSheetForm(glass, m_parentMdiArea);
     subwindow->setAttribute(Qt::WA_DeleteOnClose);
     m_parentMdiArea->addSubWindow(subwindow);
     subwindow->parentWidget()->setGeometry(0,10, this->width()*1/2,this->height()*3/4);
@@ -305,7 +386,7 @@ void CatalogViewForm::showDatasheet()
 
 void CatalogViewForm::showSettingDlg()
 {
-    CatalogViewSettingDialog *dlg = new CatalogViewSettingDialog(m_allPropertyList, m_currentPropertyList, m_currentDigit, this);
+    CatalogViewSettingDialog *dlg = new CatalogViewSettingDialog(m_allPropertyList + UserPropertyRegistry::names(), m_currentPropertyList, m_currentDigit, this);
 
     if(dlg->exec() == QDialog::Accepted){
         dlg->getSettings(m_currentPropertyList, m_currentDigit);
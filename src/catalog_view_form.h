@@ -33,6 +33,7 @@
 #include <QtMath>
 
 #include "glass_catalog.h"
+#include "glass_constraint_index.h"
 #include "qcustomtablewidget.h"
 
 namespace Ui {
@@ -49,11 +50,12 @@ public:
 
 private slots:
     void update();
-    void setUpTable(QStringList properties,GlassCatalog* catalog, int digit=6);
+    void setUpTable(QStringList properties,GlassCatalog* catalog, const QList<int>& glassIndices, int digit=6);
     void showDatasheet();
     void showSettingDlg();
     void showContextMenuOnTable();
     void exportCSV();
+    void onCatalogReloaded(int catalogIndex);
 
 private:
     Ui::CatalogViewForm *ui;
@@ -66,6 +68,9 @@ private:
     QStringList m_currentPropertyList;
     int         m_currentDigit;
 
+    /** indices of the glasses in the catalog which satisfy the filter */
+    QList<int> filteredGlassIndices(const CatalogSnapshotPtr& snapshot, int catalogIndex);
+
     void addTableItem(int row, int col, QString str);
     inline QString numToQString(double val, char fmt='f', int digit=6);
 };
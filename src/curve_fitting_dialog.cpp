@@ -31,10 +31,7 @@
 
 #include "glass_catalog_manager.h"
 #include "glass_selection_dialog.h"
-
-#include "Eigen/Dense"
-
-using namespace Eigen;
+#include "normal_line.h"
 
 CurveFittingDialog::CurveFittingDialog(QString xdataname, QString ydataname, QWidget *parent) :
     QDialog(parent),
@@ -57,9 +54,27 @@ CurveFittingDialog::CurveFittingDialog(QString xdataname, QString ydataname, QWi
         m_comboBoxOrder->addItem(QString::number(i));
     }
 
+    // same order as NormalLineFit::Method
+    m_comboBoxMethod = ui->comboBox_Method;
+    m_comboBoxMethod->addItems(QStringList({"Least Squares", "Huber", "RANSAC"}));
+
+    // samples from whole catalogs
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    for(int i = 0; i < snapshot->catalogCount(); i++){
+        QListWidgetItem* item = new QListWidgetItem(snapshot->catalog(i)->supplier(), ui->listWidget_Catalogs);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(Qt::Unchecked);
+    }
+
+    // the fitted line can replace the normal line of dPgF only on PgF-vd map
+    bool isPgFMap = ("vd" == m_xDataName && "PgF" == m_yDataName);
+    ui->checkBox_NormalLine->setEnabled(isPgFMap);
+    ui->pushButton_ResetNormalLine->setEnabled(isPgFMap && !NormalLine::isDefault());
+
     QObject::connect(ui->pushButton_AddRow,    SIGNAL(clicked()), this, SLOT(addNewRow()));
     QObject::connect(ui->pushButton_AddGlass,  SIGNAL(clicked()), this, SLOT(addGlassForNewRow()));
     QObject::connect(ui->pushButton_DeleteRow, SIGNAL(clicked()), this, SLOT(deleteSelectedRow()));
+    QObject::connect(ui->pushButton_ResetNormalLine, SIGNAL(clicked()), this, SLOT(resetNormalLine()));
 
 }
 
@@ -114,6 +129,9 @@ void CurveFittingDialog::addGlassForNewRow()
             QString s2 = QString::number(glass->getValue(m_yDataName));
             QString s3 = glass->fullName();
             addNewRow(s1, s2, s3);
+
+            // glass rows are refitted with the glass at the current temperature
+            m_table->item(m_table->rowCount() - 1, 2)->setData(Qt::UserRole, glass->handle());
         }
         glass = nullptr;
     }
@@ -133,15 +151,30 @@ void CurveFittingDialog::deleteSelectedRow()
 }
 
 
+void CurveFittingDialog::resetNormalLine()
+{
+    NormalLine::reset();
+    ui->pushButton_ResetNormalLine->setEnabled(false);
+    QMessageBox::information(this, tr("Info"), tr("dPgF is measured from the normal line of K7 and F2"));
+}
+
+
 bool CurveFittingDialog::getFittingResult(QList<double>& result)
 {
     //https://en.wikipedia.org/wiki/Polynomial_regression
 
     int N = m_comboBoxOrder->currentIndex() + 1; // order
-    int M = m_table->rowCount();                 // number of samples
+    int M = m_table->rowCount();                 // number of table rows
+
+    QStringList suppliers;
+    for(int i = 0; i < ui->listWidget_Catalogs->count(); i++){
+        if(Qt::Checked == ui->listWidget_Catalogs->item(i)->checkState()){
+            suppliers.append(ui->listWidget_Catalogs->item(i)->text());
+        }
+    }
 
     // check
-    if(M == 0){ // no input
+    if(M == 0 && suppliers.isEmpty()){ // no input
         return false;
     }else{
         for(int i = 0; i < m_table->rowCount(); i++){
@@ -156,28 +189,50 @@ bool CurveFittingDialog::getFittingResult(QList<double>& result)
         }
     }
 
-    // get coords of sampling points
-    MatrixXd X = MatrixXd::Zero(M, N+1);
-    VectorXd y(M);
-
+    // rows of glasses are kept as references, others are fixed points
+    QVector<double> fixedX, fixedY;
+    QList<GlassHandle> references;
     for(int i = 0; i < M; i++)
     {
-        for(int j = 0; j < N+1; j++){
-            X(i,j) = pow(m_table->item(i,0)->text().toDouble(), j);
+        QVariant handle = m_table->item(i,2) ? m_table->item(i,2)->data(Qt::UserRole) : QVariant();
+        if(handle.isValid()){
+            references.append(handle.toUInt());
+        }
+        else{
+            fixedX.append(m_table->item(i,0)->text().toDouble());
+            fixedY.append(m_table->item(i,1)->text().toDouble());
         }
-        y(i) = m_table->item(i,1)->text().toDouble();
     }
 
-    MatrixXd A = X.transpose()*X;
-    VectorXd b = (X.transpose())*y;
-    VectorXd beta = A.bdcSvd(ComputeThinU | ComputeThinV).solve(b);
-    //VectorXd beta = (X.transpose()*X).inverse()*(X.transpose())*y;
+    NormalLineFit::Options options;
+    options.order  = N;
+    options.method = static_cast<NormalLineFit::Method>(m_comboBoxMethod->currentIndex());
+
+    NormalLineFit::Result fitResult;
+    if(ui->checkBox_NormalLine->isEnabled() && ui->checkBox_NormalLine->isChecked()){
+        NormalLine::Definition definition;
+        definition.suppliers  = suppliers;
+        definition.references = references;
+        definition.fixedVd    = fixedX;
+        definition.fixedPgF   = fixedY;
+        definition.options    = options;
+        if(!NormalLine::setDefinition(definition, &fitResult)){
+            return false;
+        }
+    }
+    else{
+        QVector<double> x = fixedX, y = fixedY;
+        NormalLine::collectSamples(GlassCatalogManager::snapshot(), m_xDataName, m_yDataName, suppliers, references, x, y);
+        if(!NormalLineFit::fit(x, y, options, fitResult)){
+            return false;
+        }
+    }
 
     // return fitting result
     result = {0.0, 0.0, 0.0, 0.0};
     for(int k = 0; k <= N; k++)
     {
-        result[k] = beta(k);
+        result[k] = fitResult.coefs[k];
     }
 
     return true;
@@ -50,6 +50,7 @@ private slots:
     void addNewRow(QString s1="", QString s2="", QString s3="");
     void addGlassForNewRow();
     void deleteSelectedRow();
+    void resetNormalLine();
 
 private:
     Ui::CurveFittingDialog *ui;
@@ -58,6 +59,7 @@ private:
     QString m_yDataName;
 
     QComboBox*    m_comboBoxOrder;
+    QComboBox*    m_comboBoxMethod;
     QTableWidget* m_table;
 
     const int m_maxFittingOrder = 3;
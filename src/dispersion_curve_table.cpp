@@ -0,0 +1,178 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "dispersion_curve_table.h"
+
+#include <QtConcurrent>
+
+#include "glass_search_engine.h"
+
+namespace {
+
+// rows sampled by one task
+const int kRowChunkSize = 256;
+
+} // namespace
+
+
+DispersionCurveTable::DispersionCurveTable()
+    : temperature_(qQNaN())
+{
+}
+
+DispersionCurveTable::DispersionCurveTable(CatalogSnapshotPtr snapshot, const QVector<double> &wavelengths)
+    : snapshot_(snapshot),
+      temperature_(Glass::currentTemperature()),
+      wavelengths_(wavelengths)
+{
+    for(auto &cat : snapshot_->catalogs()){
+        int glassCount = cat->glassCount();
+        for(int i = 0; i < glassCount; i++){
+            rows_.append(cat->glass(i));
+        }
+    }
+
+    const int m = wavelengths_.size();
+    values_.resize(rows_.size()*m);
+
+    QVector<int> chunks;
+    for(int begin = 0; begin < rows_.size(); begin += kRowChunkSize){
+        chunks.append(begin);
+    }
+
+    QtConcurrent::blockingMap(chunks, [this, m](int begin){
+        const int end = qMin(begin + kRowChunkSize, rows_.size());
+        for(int r = begin; r < end; r++){
+            double* row = values_.data() + static_cast<qint64>(r)*m;
+            for(int j = 0; j < m; j++){
+                row[j] = rows_[r]->refractiveIndex(wavelengths_[j]);
+            }
+        }
+    });
+}
+
+QVector<double> DispersionCurveTable::uniformGrid(double lambdaMin, double lambdaMax, int count)
+{
+    QVector<double> grid;
+    if(count < 2){
+        grid.append(lambdaMin);
+        return grid;
+    }
+
+    grid.resize(count);
+    for(int i = 0; i < count; i++){
+        grid[i] = lambdaMin + (lambdaMax - lambdaMin)*static_cast<double>(i)/(count - 1);
+    }
+    return grid;
+}
+
+bool DispersionCurveTable::isCurrent(const CatalogSnapshotPtr &snapshot, const QVector<double> &wavelengths) const
+{
+    return (snapshot_ == snapshot) && (wavelengths_ == wavelengths) && (temperature_ == Glass::currentTemperature());
+}
+
+double DispersionCurveTable::distance(const double *n, const double *t, const double *w, int m, Metric metric, bool allowOffset, double *offset)
+{
+    double c = 0.0;
+
+    if(RMS == metric)
+    {
+        double sw = 0.0, swd = 0.0;
+        if(allowOffset){
+            // weighted mean of the deviation minimizes the weighted RMS
+            for(int i = 0; i < m; i++){
+                sw  += w[i];
+                swd += w[i]*(t[i] - n[i]);
+            }
+            c = swd/sw;
+        }
+
+        double sum = 0.0;
+        sw = 0.0;
+        for(int i = 0; i < m; i++){
+            const double d = t[i] - n[i] - c;
+            sum += w[i]*d*d;
+            sw  += w[i];
+        }
+        if(offset) *offset = c;
+        return sqrt(sum/sw);
+    }
+    else
+    {
+        double dmin = qInf(), dmax = -qInf();
+        for(int i = 0; i < m; i++){
+            if(w[i] > 0.0){
+                const double d = t[i] - n[i];
+                if(qIsNaN(d)){
+                    return qQNaN();
+                }
+                dmin = qMin(dmin, d);
+                dmax = qMax(dmax, d);
+            }
+        }
+        if(dmax < dmin){ // no samples
+            return qQNaN();
+        }
+
+        double result;
+        if(allowOffset){
+            // mid-range offset minimizes the maximum deviation
+            c = 0.5*(dmax + dmin);
+            result = 0.5*(dmax - dmin);
+        }else{
+            result = qMax(fabs(dmin), fabs(dmax));
+        }
+        if(offset) *offset = c;
+        return result;
+    }
+}
+
+QVector<DispersionCurveTable::Match> DispersionCurveTable::findClosest(const QVector<double> &target, const QVector<double> &weights,
+                                                                       Metric metric, bool allowOffset, int k, const QBitArray *mask) const
+{
+    QVector<Match> matches;
+
+    const int m = wavelengths_.size();
+    if(target.size() != m || weights.size() != m){
+        return matches;
+    }
+
+    const double* t = target.constData();
+    const double* w = weights.constData();
+
+    QVector<GlassSearchEngine::Result> results = GlassSearchEngine::selectTopK(rows_.size(), k, [&](int begin, int end, double* e){
+        for(int r = begin; r < end; r++){
+            e[r - begin] = distance(curve(r), t, w, m, metric, allowOffset);
+        }
+    }, mask);
+
+    for(auto &r : results){
+        Match match;
+        match.row = r.row;
+        match.distance = distance(curve(r.row), t, w, m, metric, allowOffset, &match.offset);
+        matches.append(match);
+    }
+
+    return matches;
+}
@@ -0,0 +1,94 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef DISPERSION_CURVE_TABLE_H
+#define DISPERSION_CURVE_TABLE_H
+
+#include <QVector>
+#include <QBitArray>
+
+#include "catalog_snapshot.h"
+
+/**
+ * @brief Refractive index of all glasses in a snapshot sampled on a common wavelength grid
+ * @details
+ * Each glass is one contiguous row of the matrix.  Rows follow the catalog order of the snapshot.
+ * The matrix is computed in parallel once, and closest curves are then found by scanning the rows.
+ */
+class DispersionCurveTable
+{
+public:
+    enum Metric{
+        RMS, // weighted root mean square deviation
+        Max  // maximum absolute deviation over the samples of non-zero weight
+    };
+
+    struct Match{
+        int    row;
+        double distance;
+        double offset; // index offset added to the glass curve
+    };
+
+    DispersionCurveTable();
+
+    /** @param wavelengths sample wavelengths in micron */
+    DispersionCurveTable(CatalogSnapshotPtr snapshot, const QVector<double>& wavelengths);
+
+    /** count wavelengths from lambdaMin to lambdaMax, both included */
+    static QVector<double> uniformGrid(double lambdaMin, double lambdaMax, int count);
+
+    /** true if the table was built from the snapshot on the grid at the current temperature */
+    bool isCurrent(const CatalogSnapshotPtr& snapshot, const QVector<double>& wavelengths) const;
+
+    bool isEmpty() const{ return rows_.isEmpty(); }
+    int rowCount() const{ return rows_.size(); }
+    int sampleCount() const{ return wavelengths_.size(); }
+    const QVector<double>& wavelengths() const{ return wavelengths_; }
+
+    const Glass* glass(int row) const{ return rows_[row]; }
+    const double* curve(int row) const{ return values_.constData() + static_cast<qint64>(row)*wavelengths_.size(); }
+
+    /**
+     * @brief Find the glasses whose curves are closest to the target
+     * @param target index at each sample wavelength
+     * @param weights weight at each sample wavelength.  Samples of zero weight are ignored.
+     * @param allowOffset if true, a constant index offset is fitted to each glass before measuring the distance
+     * @param mask if given, only the rows whose bit is set are searched
+     * @return at most k matches in ascending order of distance
+     */
+    QVector<Match> findClosest(const QVector<double>& target, const QVector<double>& weights,
+                               Metric metric, bool allowOffset, int k, const QBitArray* mask = nullptr) const;
+
+    /** distance between curve n and target t of m samples */
+    static double distance(const double* n, const double* t, const double* w, int m, Metric metric, bool allowOffset, double* offset = nullptr);
+
+private:
+    CatalogSnapshotPtr      snapshot_;
+    double                  temperature_;
+    QVector<double>         wavelengths_;
+    QVector<const Glass*>   rows_;
+    QVector<double>         values_; // rowCount x sampleCount
+};
+
+#endif // DISPERSION_CURVE_TABLE_H
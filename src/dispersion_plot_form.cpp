@@ -129,6 +129,7 @@ DispersionPlotForm::DispersionPlotForm(QWidget *parent) :
 DispersionPlotForm::~DispersionPlotForm()
 {
     m_glassList.clear();
+    m_snapshotList.clear();
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot = nullptr;
@@ -313,6 +314,7 @@ void DispersionPlotForm::addGraph()
         }
         else{
             m_glassList.append(newGlass);
+            m_snapshotList.append(dlg->snapshot());
             updateAll();
         }
         newGlass = nullptr;
@@ -405,6 +407,7 @@ void DispersionPlotForm::deleteGraph()
         {
             if(m_glassList[i]->productName() == glass_supplier[0] && m_glassList[i]->supplier() == glass_supplier[1]){
                 m_glassList.removeAt(i);
+                m_snapshotList.removeAt(i);
                 break;
             }
         }
@@ -417,6 +420,7 @@ void DispersionPlotForm::deleteGraph()
 void DispersionPlotForm::clearAll()
 {
     m_glassList.clear();
+    m_snapshotList.clear();
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot->clearPlottables();
@@ -31,6 +31,7 @@
 #include <QList>
 #include <QListWidget>
 #include "glass.h"
+#include "catalog_snapshot.h"
 #include "property_plot_form.h"
 
 namespace Ui {
@@ -61,6 +62,7 @@ private:
     QTableWidget* m_tableCoefs;
 
     QList<Glass*>  m_glassList;
+    QList<CatalogSnapshotPtr> m_snapshotList; // keeps each glass of m_glassList alive
 
     QVector<double> computeUserDefinedCurve(const QVector<double>& xdata);
 
@@ -112,6 +112,7 @@ void DnDtPlotForm::setGlass()
 
         clearAll();
         m_currentGlass = newGlass;
+        m_snapshot     = dlg->snapshot();
         ui->label_GlassName->setText( m_currentGlass->fullName() );
 
         // plot for default wavelength
@@ -29,6 +29,7 @@
 
 #include "property_plot_form.h"
 #include "glass.h"
+#include "catalog_snapshot.h"
 
 
 namespace Ui {
@@ -55,6 +56,7 @@ private:
 
     QList<double>  m_wvlList;
     Glass*         m_currentGlass = nullptr;
+    CatalogSnapshotPtr m_snapshot; // keeps m_currentGlass alive
 };
 
 #endif // DNDT_PLOT_FORM_H
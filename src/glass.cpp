@@ -24,19 +24,26 @@
 
 #include <QDebug>
 #include "glass.h"
+#include "glass_catalog.h"
 
 #include "spline.h" // c++ cubic spline library, Tino Kluge (ttk448 at gmail.com), https://github.com/ttk592/spline
 #include "spectral_line.h"
 #include "dispersion_formula.h"
 #include "air.h"
+#include "user_property_registry.h"
+#include "normal_line.h"
 #include "Eigen/Dense"
 
+#include <algorithm>
+
 double Glass::T_ = 25;
 
 Glass::Glass()
 {    
+    handle_ = 0;
     product_name_ = "";
     supplier_ = "";
+    full_name_ = "_";
     status_   = "";
     comment_  = "";
     MIL_      = "";
@@ -52,26 +59,27 @@ Glass::Glass()
     phosphate_resist_ = NAN;
 
     formula_index_ = 1;
-    dispersion_data_ = QVector<double>(dispersion_data_size_, 0.0);
+    formula_func_ptr_ = nullptr;
+    std::fill(dispersion_data_, dispersion_data_ + dispersion_data_size_, 0.0);
 
     hasThermalData_ = false;
-    thermal_data_ = QVector<double>(thermal_data_size_, NAN);
+    std::fill(thermal_data_, thermal_data_ + thermal_data_size_, NAN);
     Tref_ = 25;
 
     lambda_max_ = 0;
     lambda_min_ = 0;
+    transmittance_thickness_ = 0;
 
+    deferred_catalog_ = nullptr;
+    deferred_offset_  = 0;
+    deferred_length_  = 0;
+    deferred_loaded_.storeRelease(1);
 }
 
 
 Glass::~Glass()
 {
     formula_func_ptr_ = nullptr;
-    dispersion_data_.clear();
-    wavelength_data_.clear();
-    transmittance_data_.clear();
-    thickness_data_.clear();
-    thermal_data_.clear();
 }
 
 
@@ -80,6 +88,11 @@ void Glass::setCurrentTemperature(double t)
     T_ = t;
 }
 
+double Glass::currentTemperature()
+{
+    return T_;
+}
+
 double Glass::relative_wavelength(double lambdainput) const
 {
     constexpr double P = 101325.0;
@@ -110,17 +123,65 @@ double Glass::getValue(const QString& dname) const
     else if(dname == "PCt_"){
         return (refractiveIndex("C") - refractiveIndex("t")) / ( refractiveIndex("F_") - refractiveIndex("C_") );
     }
+    else if(dname == "dPgF"){ // deviation from the normal line, K7 and F2 by default
+        double vd = getValue("vd");
+        return getValue("PgF") - NormalLine::PgF(vd);
+    }
     else if(dname == "eta1"){ // Buchdahl dispersion coefficients
         return BuchdahlDispCoef(0);
     }
     else if(dname == "eta2"){ // Buchdahl dispersion coefficients
         return BuchdahlDispCoef(1);
     }
+    else if(dname == "relCost"){
+        return relCost();
+    }
+    else if(dname == "climateResist"){
+        return climateResist();
+    }
+    else if(dname == "stainResist"){
+        return stainResist();
+    }
+    else if(dname == "acidResist"){
+        return acidResist();
+    }
+    else if(dname == "alkaliResist"){
+        return alkaliResist();
+    }
+    else if(dname == "phosphateResist"){
+        return phosphateResist();
+    }
+    else if(dname == "lowTCE"){
+        return lowTCE();
+    }
+    else if(dname == "highTCE"){
+        return highTCE();
+    }
+    else if(dname == "lambdaMin"){
+        return lambdaMin();
+    }
+    else if(dname == "lambdaMax"){
+        return lambdaMax();
+    }
+    else if(dname == "dndT"){ // absolute dn/dT at d line, 10^-6/K
+        return hasThermalData() ? dn_dt_abs(T_, SpectralLine::wavelength("d")/1000.0)*1.0e6 : qQNaN();
+    }
+    else if(dname == "tau400"){ // internal transmittance at 400nm for 10mm thickness
+        return internalTransmittance(0.4, 10.0);
+    }
     else{
-        return 0;
+        std::shared_ptr<const PropertyExpression> expression = UserPropertyRegistry::find(dname);
+        return expression ? expression->evaluate(this) : qQNaN();
     }
 }
 
+QStringList Glass::valueNames()
+{
+    return QStringList({"nd", "ne", "vd", "ve", "PgF", "PCt_", "dPgF", "eta1", "eta2",
+                        "relCost", "climateResist", "stainResist", "acidResist", "alkaliResist", "phosphateResist",
+                        "lowTCE", "highTCE", "lambdaMin", "lambdaMax", "dndT", "tau400"});
+}
+
 
 double Glass::Pxy(const QString& x, const QString& y) const
 {
@@ -260,22 +321,13 @@ double Glass::BuchdahlDispCoef(int n) const
 
 void Glass::setStatus(int n)
 {
-    switch(n)
-    {
-    case 1:
-        status_ = "Preferred";
-        break;
-    case 2:
-        status_ = "Obsolete";
-        break;
-    case 3:
-        status_ = "Special";
-        break;
-    case 4:
-        status_ = "Melt";
-        break;
-    default:
-        status_ = "-";
+    // status names are shared by all glasses
+    static const QString names[] = {"-", "Preferred", "Obsolete", "Special", "Melt"};
+
+    if(n >= 1 && n <= 4){
+        status_ = names[n];
+    }else{
+        status_ = names[0];
     }
 }
 
@@ -283,106 +335,107 @@ void Glass::setStatus(int n)
 
 void Glass::setDispCoef(int n, double val)
 {
-    Q_ASSERT(dispersion_data_size_ == dispersion_data_.size());
-
-    if( n < dispersion_data_.size() ){
+    if( n >= 0 && n < dispersion_data_size_ ){
         dispersion_data_[n] = val;
     }
 }
 
 void Glass::setDispForm(int n)
 {
+    // formula names are shared by all glasses
+    static const QString names[] = {"Unknown", "Schott", "Sellmeier1", "Herzberger", "Sellmeier2", "Conrady", "Sellmeier3", "Handbook of Optics1", "Handbook of Optics2", "Sellmeier4", "Extended1", "Sellmeier5", "Extended2", "Nikon Hikari", "Laurent", "Glass Manufacturer Laurent", "Glass Manufacturer Sellmeier", "Standard Sellmeier", "Cauchy", "Hartman"};
+
     formula_index_ = n;
 
     switch (n) {
     // -----> Zemax AGF
     case 1:
         formula_func_ptr_ = &(DispersionFormula::Schott);
-        formula_name_ = "Schott";
+        formula_name_ = names[1];
         break;
     case 2:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier1);
-        formula_name_ = "Sellmeier1";
+        formula_name_ = names[2];
         break;
     case 3:
         formula_func_ptr_ = &(DispersionFormula::Herzberger);
-        formula_name_ = "Herzberger";
+        formula_name_ = names[3];
         break;
     case 4:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier2);
-        formula_name_ = "Sellmeier2";
+        formula_name_ = names[4];
         break;
     case 5:
         formula_func_ptr_ = &(DispersionFormula::Conrady);
-        formula_name_ = "Conrady";
+        formula_name_ = names[5];
         break;
     case 6:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier3);
-        formula_name_ = "Sellmeier3";
+        formula_name_ = names[6];
         break;
     case 7:
         formula_func_ptr_ = &(DispersionFormula::HandbookOfOptics1);
-        formula_name_ = "Handbook of Optics1";
+        formula_name_ = names[7];
         break;
     case 8:
         formula_func_ptr_ = &(DispersionFormula::HandbookOfOptics2);
-        formula_name_ = "Handbook of Optics2";
+        formula_name_ = names[8];
         break;
     case 9:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier4);
-        formula_name_ = "Sellmeier4";
+        formula_name_ = names[9];
         break;
     case 10:
         formula_func_ptr_ = &(DispersionFormula::Extended1);
-        formula_name_ = "Extended1";
+        formula_name_ = names[10];
         break;
     case 11:
         formula_func_ptr_ = &(DispersionFormula::Sellmeier5);
-        formula_name_ = "Sellmeier5";
+        formula_name_ = names[11];
         break;
     case 12:
         formula_func_ptr_ = &(DispersionFormula::Extended2);
-        formula_name_ = "Extended2";
+        formula_name_ = names[12];
         break;
     case 13: // Unknown
         if(supplier_.contains("hikari", Qt::CaseInsensitive)){
             formula_func_ptr_ = &(DispersionFormula::Nikon_Hikari);
-            formula_name_ = "Nikon Hikari";
+            formula_name_ = names[13];
         }else{
             formula_func_ptr_ = nullptr;
-            formula_name_ = "Unknown";
+            formula_name_ = names[0];
         }
         break;
 
     // -----> CodeV XML
     case 101:
         formula_func_ptr_ = &(DispersionFormula::Laurent);
-        formula_name_ = "Laurent";
+        formula_name_ = names[14];
         break;
     case 102:
         formula_func_ptr_ = &(DispersionFormula::GlassManufacturerLaurent);
-        formula_name_ = "Glass Manufacturer Laurent";
+        formula_name_ = names[15];
         break;
     case 103:
         formula_func_ptr_ = &(DispersionFormula::GlassManufacturerSellmeier);
-        formula_name_ = "Glass Manufacturer Sellmeier";
+        formula_name_ = names[16];
         break;
     case 104:
         formula_func_ptr_ = &(DispersionFormula::StandardSellmeier);
-        formula_name_ = "Standard Sellmeier";
+        formula_name_ = names[17];
         break;
     case 105:
         formula_func_ptr_ = &(DispersionFormula::Cauchy);
-        formula_name_ = "Cauchy";
+        formula_name_ = names[18];
         break;
     case 106:
         formula_func_ptr_ = &(DispersionFormula::Hartman);
-        formula_name_ = "Hartman";
+        formula_name_ = names[19];
         break;
 
     default:
         formula_func_ptr_ = nullptr;
-        formula_name_ = "Unknown";
+        formula_name_ = names[0];
     }
 
 }
@@ -390,49 +443,56 @@ void Glass::setDispForm(int n)
 
 double Glass::transmittance(double lambdamicron, double thi) const
 {
-    Q_ASSERT( (wavelength_data_.size() > 0) && (transmittance_data_.size() > 0) && (thickness_data_.size() > 0) );
+    loadDeferredSection();
 
-    double ref_thi   = thickness_data_[0];
-    int    dataCount = transmittance_data_.size();
-    QVector<double> qvx(dataCount), qvy(dataCount);
+    Q_ASSERT( transmittance_data_.size() > 0 );
+
+    int dataCount = transmittance_data_.size();
+    std::vector<double> sx(dataCount), sy(dataCount);
 
     for(int i = 0; i < dataCount; i++)
     {
-        qvx[i] = wavelength_data_[i];
-        qvy[i] = pow(transmittance_data_[i], thi/ref_thi); // T^(t/ref_t)
+        sx[i] = transmittance_data_[i].wavelength;
+        sy[i] = pow(transmittance_data_[i].transmittance, thi/transmittance_thickness_); // T^(t/ref_t)
     }
 
     tk::spline s;
-    std::vector<double> sx(qvx.begin(), qvx.end());
-    std::vector<double> sy(qvy.begin(), qvy.end());
     s.set_points(sx,sy);
 
     return s(lambdamicron);
 }
 
+double Glass::internalTransmittance(double lambdamicron, double thi) const
+{
+    loadDeferredSection();
+
+    bool below = false, above = false;
+    for(auto &sample : transmittance_data_){
+        below = below || (sample.wavelength <= lambdamicron);
+        above = above || (sample.wavelength >= lambdamicron);
+    }
+    return (below && above) ? transmittance(lambdamicron, thi) : qQNaN();
+}
+
 QVector<double> Glass::transmittance(const QVector<double>& vLambdamicron, double thi) const
 {
-    Q_ASSERT( (wavelength_data_.size() > 0) && (transmittance_data_.size() > 0) && (thickness_data_.size() > 0) );
+    loadDeferredSection();
+
+    Q_ASSERT( transmittance_data_.size() > 0 );
 
     // Spline interpolation is rewritten here to avoid being called many times.
-    double ref_thi = thickness_data_[0];
-    int  dataCount = transmittance_data_.size();
-    QVector<double> qvx(dataCount), qvy(dataCount);
+    int dataCount = transmittance_data_.size();
+    std::vector<double> sx(dataCount), sy(dataCount);
 
     for(int i = 0; i < dataCount; i++)
     {
-        qvx[i] = wavelength_data_[i];
-        qvy[i] = pow(transmittance_data_[i], thi/ref_thi); // T^(t/ref_t)
+        sx[i] = transmittance_data_[i].wavelength;
+        sy[i] = pow(transmittance_data_[i].transmittance, thi/transmittance_thickness_); // T^(t/ref_t)
     }
 
     tk::spline s;
-    std::vector<double> sx(qvx.begin(), qvx.end());
-    std::vector<double> sy(qvy.begin(), qvy.end());
     s.set_points(sx,sy);
 
-    qvx.clear();
-    qvy.clear();
-
     // return vector output
     dataCount = vLambdamicron.size();
     QVector<double> y(dataCount);
@@ -446,16 +506,116 @@ QVector<double> Glass::transmittance(const QVector<double>& vLambdamicron, doubl
 
 void Glass::getTransmittanceData(QList<double>& pvLambdamicron, QList<double>& pvTransmittance, QList<double>& pvThickness)
 {
-    pvLambdamicron  = wavelength_data_;
-    pvTransmittance = transmittance_data_;
-    pvThickness     = thickness_data_;
+    loadDeferredSection();
+
+    pvLambdamicron.clear();
+    pvTransmittance.clear();
+    pvThickness.clear();
+
+    for(auto &sample : transmittance_data_){
+        pvLambdamicron.append(sample.wavelength);
+        pvTransmittance.append(sample.transmittance);
+        pvThickness.append(transmittance_thickness_);
+    }
 }
 
 void Glass::appendTransmittanceData(double lambdamicron, double trans, double thick)
 {
-    wavelength_data_.append(lambdamicron);
-    transmittance_data_.append(trans);
-    thickness_data_.append(thick);
+    // All samples are kept at the thickness of the first one.
+    if(transmittance_data_.isEmpty()){
+        transmittance_thickness_ = thick;
+    }
+    else if(thick > 0 && thick != transmittance_thickness_){
+        trans = pow(trans, transmittance_thickness_/thick);
+    }
+
+    TransmittanceSample sample;
+    sample.wavelength    = lambdamicron;
+    sample.transmittance = trans;
+    transmittance_data_.append(sample);
+}
+
+
+void Glass::setDeferredSection(const GlassCatalog* catalog, qint64 offset, qint64 length)
+{
+    deferred_catalog_ = catalog;
+    deferred_offset_  = offset;
+    deferred_length_  = length;
+    deferred_loaded_.storeRelease(0);
+}
+
+namespace {
+
+// FNV-1a
+class ContentHasher
+{
+public:
+    void add(const void* data, size_t size)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for(size_t i = 0; i < size; i++){
+            h_ = (h_ ^ p[i])*1099511628211ULL;
+        }
+    }
+    void add(double v){ add(&v, sizeof(v)); }
+    void add(int v){ add(&v, sizeof(v)); }
+    void add(const QString& s)
+    {
+        add(s.size());
+        add(s.constData(), s.size()*sizeof(QChar));
+    }
+    quint64 value() const{ return h_; }
+
+private:
+    quint64 h_ = 14695981039346656037ULL;
+};
+
+} // namespace
+
+quint64 Glass::contentHash(ContentSection section) const
+{
+    ContentHasher h;
+
+    switch (section) {
+    case DispersionSection:
+        h.add(formula_index_);
+        h.add(dispersion_data_, sizeof(dispersion_data_));
+        break;
+    case ThermalSection:
+        h.add(static_cast<int>(hasThermalData_));
+        h.add(thermal_data_, sizeof(thermal_data_));
+        break;
+    case TransmittanceSection:
+        loadDeferredSection();
+        h.add(lambda_min_);
+        h.add(lambda_max_);
+        h.add(transmittance_thickness_);
+        for(auto &sample : transmittance_data_){
+            h.add(sample.wavelength);
+            h.add(sample.transmittance);
+        }
+        break;
+    case OtherSection:
+        loadDeferredSection();
+        h.add(status_);
+        h.add(MIL_);
+        h.add(comment_);
+        for(double v : {lowTCE_, highTCE_, rel_cost_, climate_resist_, stain_resist_, acid_resist_, alkali_resist_, phosphate_resist_}){
+            h.add(v);
+        }
+        break;
+    }
+
+    return h.value();
+}
+
+void Glass::decodeDeferredSection() const
+{
+    if(deferred_catalog_){
+        deferred_catalog_->loadDeferredSection(const_cast<Glass*>(this));
+    }else{
+        deferred_loaded_.storeRelease(1);
+    }
 }
 
 
@@ -493,11 +653,16 @@ double Glass::delta_n_abs(double T, double lambdamicron) const
     //return (n*n-1)/(2*n) * ( D0()*dT+ D1()*dT*dT + D2()*dT*dT*dT + (E0()*dT + E1()*dT*dT)/(lambdamicron*lambdamicron - Stk*Ltk()*Ltk()) );
 }
 
-void Glass::setThermalData(int n, double val)
+QVector<double> Glass::getThermalData() const
 {
-    Q_ASSERT( thermal_data_size_ == thermal_data_.size() );
+    QVector<double> data(thermal_data_size_);
+    std::copy(thermal_data_, thermal_data_ + thermal_data_size_, data.begin());
+    return data;
+}
 
-    if( n < thermal_data_.size() ){
+void Glass::setThermalData(int n, double val)
+{
+    if( n >= 0 && n < thermal_data_size_ ){
         thermal_data_[n] = val;
 
         if(n == 6){
@@ -29,15 +29,24 @@
 #include <QString>
 #include <QList>
 #include <QVector>
+#include <QAtomicInt>
 #include <QtMath>
 
+class GlassCatalog;
+
+/** Registry handle of a loaded glass. 0 is invalid. */
+typedef quint32 GlassHandle;
+
 class Glass
 {
+    friend class GlassCatalog;
+
 public:
     Glass();
     ~Glass();
 
     static void setCurrentTemperature(double t);
+    static double currentTemperature();
 
     double relative_wavelength(double lambdainput) const;
 
@@ -46,6 +55,10 @@ public:
     double          refractiveIndex(const QString& spectral) const;
     QVector<double> refractiveIndex(const QVector<double>& vLambdamicron) const;
 
+    /** Handle assigned by GlassCatalogManager */
+    inline GlassHandle handle() const;
+    inline void     setHandle(GlassHandle h);
+
     inline QString  fullName() const;
     inline QString  productName() const;
     inline QString  supplier() const;
@@ -57,9 +70,15 @@ public:
     double Pxy_(const QString& x, const QString& y) const;
 
 
-    /** convenience function to get glass property */
+    /**
+     * @brief convenience function to get glass property
+     * @details Names other than valueNames() are looked up in the user defined properties. NaN if unknown.
+     */
     double getValue(const QString& dname) const;
 
+    /** built-in names accepted by getValue */
+    static QStringList valueNames();
+
     double BuchdahlDispCoef(int n) const;
 
     inline void setName(const QString& str);
@@ -98,7 +117,7 @@ public:
     inline double Ltk() const;
     inline double Tref()  const;
 
-    inline QVector<double> getThermalData() const;
+    QVector<double> getThermalData() const;
     double          dn_dt_abs(double T, double lambdamicron) const;
     QVector<double> dn_dt_abs(const QVector<double>& vT, double lambdamicron) const;
 
@@ -124,6 +143,9 @@ public:
 
     // transmittance data
     double          transmittance(double lambdamicron, double thi = 25) const;
+
+    /** transmittance, or NaN if the wavelength is out of the data */
+    double          internalTransmittance(double lambdamicron, double thi) const;
     QVector<double> transmittance(const QVector<double>& vLambdamicron, double thi = 25) const;
 
     inline double  lambdaMin() const;
@@ -134,6 +156,23 @@ public:
     inline void  setLambdaMin(double val);
     inline void  setLambdaMax(double val);
 
+    /**
+     * @brief Set the catalog file section which holds the data skipped in the first parse pass
+     * @details Comment, TCE, other data and transmittance data are decoded from the section on first access.
+     */
+    void setDeferredSection(const GlassCatalog* catalog, qint64 offset, qint64 length);
+
+    /** data sections compared between catalog versions */
+    enum ContentSection{
+        DispersionSection    = 0x1, // formula and coefficients
+        ThermalSection       = 0x2,
+        TransmittanceSection = 0x4,
+        OtherSection         = 0x8  // status, MIL, comment, TCE, cost and resistances
+    };
+
+    /** hash of the data in the section. Equal data gives equal hash across catalog files. */
+    quint64 contentHash(ContentSection section) const;
+
 
 private:
     double          refractiveIndex_abs_Tref(double lambdamicron) const;
@@ -143,12 +182,18 @@ private:
     QVector<double> refractiveIndex_rel_Tref(const QVector<double>& vLambdamicron) const;
     QVector<double> refractiveIndex_rel(const QVector<double>& vLambdamicron, double T) const;
 
+    inline void loadDeferredSection() const;
+    void        decodeDeferredSection() const;
+
     /** current temperature */
     static double T_;
 
+    GlassHandle handle_;
+
     QString product_name_;
-    QString supplier_;
-    QString status_;
+    QString supplier_; // shared with the catalog
+    QString full_name_;
+    QString status_;   // shared by all glasses of the same status
     QString MIL_;
     QString comment_;
 
@@ -157,16 +202,16 @@ private:
     double highTCE_;
 
     // dispersion data
-    const int       dispersion_data_size_ = 12;
-    QVector<double> dispersion_data_;
+    static constexpr int dispersion_data_size_ = 12;
+    double          dispersion_data_[dispersion_data_size_];
     int             formula_index_;
-    QString         formula_name_;
-    double (*formula_func_ptr_)(double, const QVector<double>&);
+    QString         formula_name_; // shared by all glasses of the same formula
+    double (*formula_func_ptr_)(double, const double*);
 
     // thermal data
     bool            hasThermalData_;
-    const int       thermal_data_size_ = 7;
-    QVector<double> thermal_data_; //<D0> <D1> <D2> <E0> <E1> <Ltk> <temp>
+    static constexpr int thermal_data_size_ = 7;
+    double          thermal_data_[thermal_data_size_]; //<D0> <D1> <D2> <E0> <E1> <Ltk> <temp>
     double          Tref_;
 
     // other data
@@ -179,18 +224,37 @@ private:
     double phosphate_resist_;
 
     // transmittance data
+    struct TransmittanceSample{
+        double wavelength; //micron
+        double transmittance;
+    };
     double        lambda_max_;
     double        lambda_min_;
-    QList<double> wavelength_data_; //micron
-    QList<double> transmittance_data_;
-    QList<double> thickness_data_;
+    QVector<TransmittanceSample> transmittance_data_;
+    double        transmittance_thickness_; // common to all samples
+
+    // deferred section in the catalog file
+    const GlassCatalog* deferred_catalog_;
+    qint64              deferred_offset_;
+    qint64              deferred_length_;
+    mutable QAtomicInt  deferred_loaded_;
 };
 
 //************************************************************************************************************
 // getter
+GlassHandle Glass::handle() const
+{
+    return handle_;
+}
+
+void Glass::setHandle(GlassHandle h)
+{
+    handle_ = h;
+}
+
 QString Glass::fullName() const
 {
-    return product_name_ + "_" + supplier_;
+    return full_name_;
 }
 
 QString Glass::productName() const
@@ -215,16 +279,19 @@ QString Glass::MIL() const
 
 QString Glass::comment() const
 {
+    loadDeferredSection();
     return comment_;
 }
 
 double Glass::lowTCE() const
 {
+    loadDeferredSection();
     return lowTCE_;
 }
 
 double Glass::highTCE() const
 {
+    loadDeferredSection();
     return highTCE_;
 }
 
@@ -240,7 +307,7 @@ QString Glass::formulaName() const
 
 int Glass::dispersionCoefCount() const
 {
-    return dispersion_data_.size();
+    return dispersion_data_size_;
 }
 
 double Glass::dispersionCoef(int n) const
@@ -290,31 +357,37 @@ double Glass::Tref() const
 
 double Glass::relCost() const
 {
+    loadDeferredSection();
     return rel_cost_;
 }
 
 double Glass::climateResist() const
 {
+    loadDeferredSection();
     return climate_resist_;
 }
 
 double Glass::stainResist() const
 {
+    loadDeferredSection();
     return stain_resist_;
 }
 
 double Glass::acidResist() const
 {
+    loadDeferredSection();
     return acid_resist_;
 }
 
 double Glass::alkaliResist() const
 {
+    loadDeferredSection();
     return alkali_resist_;
 }
 
 double Glass::phosphateResist() const
 {
+    loadDeferredSection();
     return phosphate_resist_;
 }
 
@@ -328,9 +401,11 @@ double Glass::lambdaMin() const
     return lambda_min_;
 }
 
-QVector<double> Glass::getThermalData() const
+void Glass::loadDeferredSection() const
 {
-    return thermal_data_;
+    if(!deferred_loaded_.loadAcquire()){
+        decodeDeferredSection();
+    }
 }
 
 
@@ -338,11 +413,13 @@ QVector<double> Glass::getThermalData() const
 void Glass::setName(const QString& str)
 {
     product_name_ = str;
+    full_name_    = product_name_ + "_" + supplier_;
 }
 
 void Glass::setSupplier(const QString& str)
 {
-    supplier_ = str;
+    supplier_  = str;
+    full_name_ = product_name_ + "_" + supplier_;
 }
 
 void Glass::setMIL(const QString& str)
@@ -26,15 +26,156 @@
 
 #include "pugixml.hpp" //https://pugixml.org
 
+#include <cstring>
 #include <QFile>
 #include <QFileInfo>
-#include <QTextStream>
+#include <QBuffer>
+
+#include "text_line_reader.h"
+#include "gzip_file_device.h"
+
+namespace {
+
+/**
+ * Parse AGF lines which are skipped in the first pass.
+ * NM, CD and TD lines are parsed in the first pass, as refractive index at the current temperature depends on them.
+ * LD line is also parsed in the first pass for the load filter.
+ */
+void parseDeferredAGFLine(Glass* g, const QString& tag, QString linetext)
+{
+    QStringList lineparts;
+
+    // GC <Individual Glass Comment>
+    if (tag == "GC")
+    {
+        g->setComment(linetext.remove(0,2).simplified());
+    }
+
+    // ED <TCE (-30 to 70)> <TCE (100 to 300)> <density> <dPgF> <Ignore Thermal Exp>
+    else if(tag == "ED")
+    {
+        lineparts = linetext.simplified().split(" ");
+        if(lineparts.size() > 2){
+            g->setLowTCE(lineparts[1].toDouble());
+            g->setHighTCE(lineparts[2].toDouble());
+        }
+    }
+
+    // OD <rel cost> <CR> <FR> <SR> <AR> <PR>
+    else if(tag == "OD")
+    {
+        lineparts = linetext.simplified().split(" ");
+        if(lineparts.size() == 7)
+        {
+            /*For these values, -1 should be specified if the data is not available.
+              Some manufactureres use "-" instead of "-1.00000".*/
+
+            double dval;
+            bool ok;
+
+            dval = lineparts[1].toDouble(&ok);
+            if(ok && (dval != -1.0)){
+                g->setRelCost(dval);
+            }
+
+            dval = lineparts[2].toDouble(&ok);
+            if(ok && (dval != -1.0)){
+                g->setClimateResist(dval);
+            }
+
+            dval = lineparts[3].toDouble(&ok);
+            if(ok && (dval != -1.0)){
+                g->setStainResist(dval);
+            }
+
+            dval = lineparts[4].toDouble(&ok);
+            if(ok && (dval != -1.0)){
+                g->setAcidResist(dval);
+            }
+
+            dval = lineparts[5].toDouble(&ok);
+            if(ok && (dval != -1.0)){
+                g->setAlkaliResist(dval);
+            }
+
+            dval = lineparts[6].toDouble(&ok);
+            if(ok && (dval != -1.0)){
+                g->setPhosphateResist(dval);
+            }
+        }
+    }
+
+    // IT <lambda> <transmission> <thickness>
+    else if(tag == "IT")
+    {
+        lineparts = linetext.simplified().split(" ");
+        if(lineparts.size() == 4){
+            g->appendTransmittanceData(lineparts[1].toDouble(), lineparts[2].toDouble(), lineparts[3].toDouble());
+        }
+    }
+}
+
+/** Parse Xml glass node elements which are skipped in the first pass. */
+void parseDeferredXmlGlass(Glass* g, const pugi::xml_node& glassNode)
+{
+    // high/low TCE(CTE)
+    if(glassNode.child("LowCTE")){
+        g->setLowTCE(glassNode.child("LowCTE").child("Value").text().as_double());
+    }
+    if(glassNode.child("HighCTE")){
+        g->setHighTCE(glassNode.child("HighCTE").child("Value").text().as_double());
+    }
+
+    // Manufacturer's properties
+    for(pugi::xml_node_iterator mp_it = glassNode.child("ManufacturersProperties").begin(); mp_it != glassNode.child("ManufacturersProperties").end(); mp_it++)
+    {
+        QString propertyname = QString(mp_it->child("Name").text().as_string());
+        if(propertyname.compare("Acid_resist") == 0){
+            g->setAcidResist(mp_it->child("Value").text().as_double());
+        }
+        else if(propertyname.compare("Climatic_resist") == 0){
+            g->setClimateResist(mp_it->child("Value").text().as_double());
+        }
+        else if(propertyname.compare("Stain_resist") == 0){
+            g->setStainResist(mp_it->child("Value").text().as_double());
+        }
+        else if(propertyname.compare("Alkali_resist") == 0){
+            g->setAlkaliResist(mp_it->child("Value").text().as_double());
+        }
+    }
+
+    // transmittance
+    for(pugi::xml_node_iterator td_it = glassNode.child("TransmissionCurves").child("Curve").begin(); td_it != glassNode.child("TransmissionCurves").child("Curve").end(); td_it++)
+    {
+        double t = 10;
+        QString nodename = td_it->name();
+        if(nodename.compare("Thickness")==0) {
+            t = td_it->text().as_double();
+        }
+
+        if(nodename.compare("Transmission")==0){
+            double w = td_it->child("Wavelength").text().as_double();
+            double v = td_it->child("Value").text().as_double();
+            g->appendTransmittanceData(w/1000.0, v, t);
+        }
+    }
+}
+
+} // namespace
+
 
 GlassCatalog::GlassCatalog()
 {
     glasses_.clear();
+    glass_block_used_ = 0;
     name_to_int_map_.clear();
     supplier_ = "";
+    file_path_ = "";
+    skipped_glass_count_ = 0;
+
+    format_        = FormatAGF;
+    text_encoding_ = TextLineReader::Local8Bit;
+    file_size_     = 0;
 }
 
 
@@ -45,19 +186,20 @@ GlassCatalog::~GlassCatalog()
 
 void GlassCatalog::clear()
 {
-    if(!glasses_.isEmpty()){
-        for(auto &g:glasses_){
-            try {
-                delete g;
-            } catch (...) {
-                g = nullptr;
-            }
-            g = nullptr;
-        }
-        glasses_.clear();
-    }
+    glasses_.clear();
+    glass_blocks_.clear();
+    glass_block_used_ = 0;
+
     supplier_ = "";
+    file_path_ = "";
     name_to_int_map_.clear();
+    skipped_glass_count_ = 0;
+
+    file_size_     = 0;
+    file_modified_ = QDateTime();
+    QMutexLocker locker(&deferred_mutex_);
+    deferred_diagnostics_.clear();
+    deferred_failed_glasses_.clear();
 }
 
 Glass* GlassCatalog::glass(int n) const
@@ -76,188 +218,245 @@ Glass* GlassCatalog::glass(const QString& glassname) const
     return nullptr;
 }
 
+Glass* GlassCatalog::allocateGlass()
+{
+    if(glass_blocks_.empty() || glass_block_used_ == glass_block_size_){
+        glass_blocks_.emplace_back(new Glass[glass_block_size_]);
+        glass_block_used_ = 0;
+    }
+    return &(glass_blocks_.back()[glass_block_used_++]);
+}
+
+void GlassCatalog::releaseLastGlass(Glass *g)
+{
+    Q_ASSERT(g == &(glass_blocks_.back()[glass_block_used_ - 1]));
+
+    *g = Glass();
+    glass_block_used_--;
+}
+
 bool GlassCatalog::hasGlass(const QString& glassname) const
 {
     return name_to_int_map_.contains(glassname);
 }
 
 
-bool GlassCatalog::loadAGF(const QString& AGFpath, QString& parse_result)
+bool GlassCatalog::loadAGF(const QString& AGFpath, LoadDiagnostics& diagnostics, const GlassLoadFilter& filter)
 {
-    QFile file(AGFpath);
+    // compressed files are decompressed chunk by chunk while parsing
+    QFile plainfile(AGFpath);
+    GzipFileDevice gzipfile(AGFpath);
+    bool compressed = GzipFileDevice::isGzipFile(AGFpath);
+    QIODevice& file = compressed ? static_cast<QIODevice&>(gzipfile) : plainfile;
     if (! file.open(QIODevice::ReadOnly)) {
         return false;
     }
 
-
-    // parse result
-    QString filename = QFileInfo(AGFpath).fileName();
+    diagnostics.beginFile(AGFpath);
 
     this->clear();
 
+    supplier_      = QFileInfo(AGFpath).baseName();
+    file_path_     = AGFpath;
+    file_size_     = QFileInfo(AGFpath).size();
+    file_modified_ = QFileInfo(AGFpath).lastModified();
+    format_        = FormatAGF;
+
+    if(!filter.acceptsSupplier(supplier_)){
+        return true;
+    }
+
+    // Only NM, CD, TD and LD lines are parsed here.  The other lines of each glass are decoded on first access.
+    // Compressed files can not be read partially, so all lines are parsed in this case.
+    TextLineReader reader(&file);
+    text_encoding_ = reader.encoding();
+
     int linecount = 0;
-    QTextStream stream(&file);
+    QByteArray linebytes;
+    qint64 lineoffset;
     QString linetext;
     QStringList lineparts;
 
-    supplier_ = QFileInfo(AGFpath).baseName();
-
-    Glass *g;
+    Glass *g = nullptr;
+    qint64 sectionOffset = 0;
+    int sectionLine = 0;
     int glassNumber = 0;
-    while (! stream.atEnd())
+
+    // store the glass when all lines of it have been read
+    auto appendGlass = [&](qint64 sectionEnd){
+        if(!g){
+            return;
+        }
+        if(filter.acceptsWavelengthRange(g->lambdaMin(), g->lambdaMax())){
+            if(!compressed){
+                g->setDeferredSection(this, sectionOffset, sectionEnd - sectionOffset);
+            }
+            glasses_.append(g);
+            name_to_int_map_.insert(g->productName(),glassNumber);
+            glassNumber += 1;
+        }else{
+            diagnostics.add(LoadDiagnostics::SkippedByFilter, g->productName(), sectionLine);
+            releaseLastGlass(g);
+            skipped_glass_count_++;
+        }
+        g = nullptr;
+    };
+
+    while (reader.readLine(linebytes, lineoffset))
     {
-        linetext = stream.readLine();
         linecount++;
 
         //NM <glass name> <dispersion formula #> <MIL#> <N(d)> <V(d)> <Exclude Sub> <status> <melt freq>
-        if(linetext.startsWith("NM"))
+        if(reader.startsWith(linebytes, "NM"))
         {
-            lineparts = linetext.simplified().split(" ");
-            g = new Glass;
-            glasses_.append(g);
-            glasses_.last()->setName(lineparts[1]);
-            glasses_.last()->setSupplier(supplier_);
-            glasses_.last()->setDispForm(lineparts[2].toInt());
-            glasses_.last()->setMIL(lineparts[3]);
+            appendGlass(lineoffset);
 
-            name_to_int_map_.insert(glasses_.last()->productName(),glassNumber);
-            glassNumber += 1;
+            linetext = reader.decode(linebytes);
+            lineparts = linetext.simplified().split(" ");
+            g = allocateGlass();
+            g->setName(lineparts[1]);
+            g->setSupplier(supplier_);
+            g->setDispForm(lineparts[2].toInt());
+            g->setMIL(lineparts[3]);
 
             if(lineparts.size() > 7){
-                glasses_.last()->setStatus(lineparts[7].toUInt());
+                g->setStatus(lineparts[7].toUInt());
             }
 
-            if(glasses_.last()->formulaName() == "Unknown"){
-                parse_result += filename + "(" + QString::number(linecount) + "): " + glasses_.last()->productName() + ": " + "Unknown dispersion formula\n";
+            // following lines are skipped until the next NM line
+            if(!filter.acceptsStatus(g->status()) || !filter.acceptsFormula(g->formulaName())){
+                diagnostics.add(LoadDiagnostics::SkippedByFilter, g->productName(), linecount);
+                releaseLastGlass(g);
+                g = nullptr;
+                skipped_glass_count_++;
+                continue;
             }
-        }
 
-         // GC <Individual Glass Comment>
-        else if (linetext.startsWith("GC"))
-        {
-            glasses_.last()->setComment(linetext.remove(0,2).simplified());
+            if(g->formulaName() == "Unknown"){
+                diagnostics.add(LoadDiagnostics::UnknownFormula, g->productName(), linecount);
+            }
+
+            sectionOffset = reader.pos();
+            sectionLine   = linecount;
         }
 
-        // ED <TCE (-30 to 70)> <TCE (100 to 300)> <density> <dPgF> <Ignore Thermal Exp>
-        else if(linetext.startsWith("ED"))
+        else if(!g)
         {
-            lineparts = linetext.simplified().split(" ");
-            glasses_.last()->setLowTCE(lineparts[1].toDouble());
-            glasses_.last()->setHighTCE(lineparts[2].toDouble());
+            continue; // catalog comment or skipped glass
         }
 
         // CD <dispersion coefficients 1 - 10>
-        else if(linetext.startsWith("CD"))
+        else if(reader.startsWith(linebytes, "CD"))
         {
-            lineparts = linetext.simplified().split(" ");
+            lineparts = reader.decode(linebytes).simplified().split(" ");
             for(int i = 1;i<lineparts.size();i++){
-                glasses_.last()->setDispCoef(i-1,lineparts[i].toDouble());
+                g->setDispCoef(i-1,lineparts[i].toDouble());
             }
         }
 
         // TD <D0> <D1> <D2> <E0> <E1> <Ltk> <Temp>
-        else if(linetext.startsWith("TD"))
+        else if(reader.startsWith(linebytes, "TD"))
         {
-            lineparts = linetext.simplified().split(" ");
+            lineparts = reader.decode(linebytes).simplified().split(" ");
             if(lineparts.size() == 8){
-                glasses_.last()->setHasThermalData(true);
+                g->setHasThermalData(true);
                 for(int i = 1;i<8;i++){
-                    glasses_.last()->setThermalData(i-1, lineparts[i].toDouble());
+                    g->setThermalData(i-1, lineparts[i].toDouble());
                 }
             }else{
-                glasses_.last()->setHasThermalData(false);
-                parse_result += filename + "(" + QString::number(linecount) + "): " + glasses_.last()->productName() + ": " + "Thermal Data Not Found\n";
+                g->setHasThermalData(false);
+                diagnostics.add(LoadDiagnostics::ThermalDataNotFound, g->productName(), linecount);
             }
         }
 
-        // OD <rel cost> <CR> <FR> <SR> <AR> <PR>
-        else if(linetext.startsWith("OD"))
+        // LD <min lambda> <max lambda>
+        else if(reader.startsWith(linebytes, "LD"))
         {
-            lineparts = linetext.simplified().split(" ");
-            if(lineparts.size() == 7)
-            {
-                /*For these values, -1 should be specified if the data is not available.
-                  Some manufactureres use "-" instead of "-1.00000".*/
-
-                double dval;
-                bool ok;
-
-                dval = lineparts[1].toDouble(&ok);
-                if(ok && (dval != -1.0)){
-                    glasses_.last()->setRelCost(dval);
-                }
-
-                dval = lineparts[2].toDouble(&ok);
-                if(ok && (dval != -1.0)){
-                    glasses_.last()->setClimateResist(dval);
-                }
-
-                dval = lineparts[3].toDouble(&ok);
-                if(ok && (dval != -1.0)){
-                    glasses_.last()->setStainResist(dval);
-                }
-
-                dval = lineparts[4].toDouble(&ok);
-                if(ok && (dval != -1.0)){
-                    glasses_.last()->setAcidResist(dval);
-                }
-
-                dval = lineparts[5].toDouble(&ok);
-                if(ok && (dval != -1.0)){
-                    glasses_.last()->setAlkaliResist(dval);
-                }
-
-                dval = lineparts[6].toDouble(&ok);
-                if(ok && (dval != -1.0)){
-                    glasses_.last()->setPhosphateResist(dval);
-                }
-            }
-            else{
-                parse_result += filename + "(" + QString::number(linecount) + "): " + glasses_.last()->productName() + ": " + "Other Data Not Found\n";
+            lineparts = reader.decode(linebytes).simplified().split(" ");
+            if(lineparts.size() > 2){
+                g->setLambdaMin(lineparts[1].toDouble()); // micron
+                g->setLambdaMax(lineparts[2].toDouble());
             }
-
         }
 
-        // LD <min lambda> <max lambda>
-        else if(linetext.startsWith("LD"))
+        // OD <rel cost> <CR> <FR> <SR> <AR> <PR>
+        else if(reader.startsWith(linebytes, "OD"))
         {
-            lineparts = linetext.simplified().split(" ");
-            glasses_.last()->setLambdaMin(lineparts[1].toDouble()); // micron
-            glasses_.last()->setLambdaMax(lineparts[2].toDouble());
+            if(reader.tokenCount(linebytes) != 7){
+                diagnostics.add(LoadDiagnostics::OtherDataNotFound, g->productName(), linecount);
+            }
         }
 
         // IT <lambda> <transmission> <thickness>
-        else if(linetext.startsWith("IT"))
+        else if(reader.startsWith(linebytes, "IT"))
         {
-            lineparts = linetext.simplified().split(" ");
-            if(lineparts.size() == 4){
-                glasses_.last()->appendTransmittanceData(lineparts[1].toDouble(), lineparts[2].toDouble(), lineparts[3].toDouble());
-            }
-            else{
-                parse_result += filename + "(" + QString::number(linecount) + "): " + glasses_.last()->productName() + ": " + "Transmittance Data Not Found\n";
+            if(reader.tokenCount(linebytes) != 4){
+                diagnostics.add(LoadDiagnostics::TransmittanceDataNotFound, g->productName(), linecount);
             }
         }
+
+        if(compressed && g){
+            linetext = reader.decode(linebytes);
+            parseDeferredAGFLine(g, linetext.left(2), linetext);
+        }
     }
 
+    appendGlass(reader.pos());
+
     file.close();
 
+    // the lines read before the broken data have been parsed, but the catalog is incomplete
+    if(compressed && gzipfile.hasError()){
+        diagnostics.add(LoadDiagnostics::DecompressionError, QString(), linecount);
+        return false;
+    }
+
     return true;
 }
 
 
-bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
+bool GlassCatalog::loadXml(QString xmlpath, LoadDiagnostics& diagnostics, const GlassLoadFilter& filter)
 {
+    // The DOM parser needs the whole text, so compressed data is inflated chunk by chunk into the parse buffer.
+    QFile plainfile(xmlpath);
+    GzipFileDevice gzipfile(xmlpath);
+    bool compressed = GzipFileDevice::isGzipFile(xmlpath);
+    QIODevice& file = compressed ? static_cast<QIODevice&>(gzipfile) : plainfile;
+    if (! file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray xmlbytes = file.readAll();
+    file.close();
+
+    if(compressed && gzipfile.hasError()){
+        diagnostics.beginFile(xmlpath);
+        diagnostics.add(LoadDiagnostics::DecompressionError);
+        return false;
+    }
+
     pugi::xml_document doc;
-    if(!doc.load_file(xmlpath.toUtf8().data())) {
+    pugi::xml_parse_result result = doc.load_buffer(xmlbytes.constData(), xmlbytes.size());
+    if(!result) {
         return false;
     }
 
-    // parse result
-    QString filename = QFileInfo(xmlpath).fileName();
+    diagnostics.beginFile(xmlpath);
 
     this->clear();
 
-    supplier_ = doc.first_child().first_child().child_value();
+    supplier_      = doc.first_child().first_child().child_value();
+    file_path_     = xmlpath;
+    file_size_     = QFileInfo(xmlpath).size();
+    file_modified_ = QFileInfo(xmlpath).lastModified();
+    format_        = FormatXML;
+
+    if(!filter.acceptsSupplier(supplier_)){
+        return true;
+    }
+
+    // Byte offsets of glass nodes are available only if the file is not converted from another encoding.
+    // Compressed files can not be read partially, so all data is parsed in this case.
+    bool deferrable = (result.encoding == pugi::encoding_utf8) && !compressed;
 
     pugi::xml_node nodeglasses_ = doc.child("Catalog").child("Glasses");
 
@@ -267,7 +466,7 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
 
     for (pugi::xml_node_iterator glass_it = nodeglasses_.begin(); glass_it != nodeglasses_.end(); glass_it++ )
     {
-        g = new Glass;
+        g = allocateGlass();
         g->setSupplier(supplier_);
         g->setName(glass_it->child("GlassName").child_value());
         g->setMIL(glass_it->child("NumericName").child_value());
@@ -294,7 +493,21 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
         }
         else{
             g->setDispForm(13); //unknown
-            parse_result += filename + ": " + g->productName() + ": " + "Unknown dispersion formula\n";
+        }
+
+        // wavelength range (nm)
+        g->setLambdaMin(glass_it->child("LowWavelength").text().as_double()/1000.0);
+        g->setLambdaMax(glass_it->child("HighWavelength").text().as_double()/1000.0);
+
+        if(!filter.acceptsStatus(g->status()) || !filter.acceptsFormula(g->formulaName()) || !filter.acceptsWavelengthRange(g->lambdaMin(), g->lambdaMax())){
+            diagnostics.add(LoadDiagnostics::SkippedByFilter, g->productName());
+            releaseLastGlass(g);
+            skipped_glass_count_++;
+            continue;
+        }
+
+        if(g->formulaName() == "Unknown"){
+            diagnostics.add(LoadDiagnostics::UnknownFormula, g->productName());
         }
 
 
@@ -307,17 +520,11 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
         }
 
         // high/low TCE(CTE)
-        if(glass_it->child("LowCTE")){
-            g->setLowTCE(glass_it->child("LowCTE").child("Value").text().as_double());
-        }
-        else{
-            parse_result += filename + ": " + g->productName() + ": " + "Not found LowCTE\n";
-        }
-        if(glass_it->child("HighCTE")){
-            g->setHighTCE(glass_it->child("HighCTE").child("Value").text().as_double());
+        if(!glass_it->child("LowCTE")){
+            diagnostics.add(LoadDiagnostics::LowCTENotFound, g->productName());
         }
-        else{
-            parse_result += filename + ": " + g->productName() + ": " + "Not found HighCTE\n";
+        if(!glass_it->child("HighCTE")){
+            diagnostics.add(LoadDiagnostics::HighCTENotFound, g->productName());
         }
 
         // Manufacturer's properties
@@ -327,55 +534,32 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
         bool hasAlkaliResist = false;
         for(pugi::xml_node_iterator mp_it = glass_it->child("ManufacturersProperties").begin(); mp_it != glass_it->child("ManufacturersProperties").end(); mp_it++)
         {
-            QString propertyname = QString(mp_it->child("Name").text().as_string());
-            if(propertyname.compare("Acid_resist") == 0){
+            const char* propertyname = mp_it->child("Name").text().as_string();
+            if(strcmp(propertyname, "Acid_resist") == 0){
                 hasAcidResist = true;
-                g->setAcidResist(mp_it->child("Value").text().as_double());
             }
-            else if(propertyname.compare("Climatic_resist") == 0){
+            else if(strcmp(propertyname, "Climatic_resist") == 0){
                 hasClimateResist = true;
-                g->setClimateResist(mp_it->child("Value").text().as_double());
             }
-            else if(propertyname.compare("Stain_resist") == 0){
+            else if(strcmp(propertyname, "Stain_resist") == 0){
                 hasStainResist = true;
-                g->setStainResist(mp_it->child("Value").text().as_double());
             }
-            else if(propertyname.compare("Alkali_resist") == 0){
+            else if(strcmp(propertyname, "Alkali_resist") == 0){
                 hasAlkaliResist = true;
-                g->setAlkaliResist(mp_it->child("Value").text().as_double());
             }
         }
         // append parse result of manufacturer property
         if(!hasAcidResist){
-            parse_result += filename + ": " + g->productName() + ": " + "Not found Acid Resist\n";
+            diagnostics.add(LoadDiagnostics::AcidResistNotFound, g->productName());
         }
         if(!hasClimateResist){
-            parse_result += filename + ": " + g->productName() + ": " + "Not found Climate Resist\n";
+            diagnostics.add(LoadDiagnostics::ClimateResistNotFound, g->productName());
         }
         if(!hasStainResist){
-            parse_result += filename + ": " + g->productName() + ": " + "Not found Stain Resist\n";
+            diagnostics.add(LoadDiagnostics::StainResistNotFound, g->productName());
         }
         if(!hasAlkaliResist){
-            parse_result += filename + ": " + g->productName() + ": " + "Not found Alkali Resist\n";
-        }
-
-        // transmittance
-        g->setLambdaMin(glass_it->child("LowWavelength").text().as_double());
-        g->setLambdaMax(glass_it->child("HighWavelength").text().as_double());
-
-        for(pugi::xml_node_iterator td_it = glass_it->child("TransmissionCurves").child("Curve").begin(); td_it != glass_it->child("TransmissionCurves").child("Curve").end(); td_it++)
-        {
-            double t = 10;
-            QString nodename = td_it->name();
-            if(nodename.compare("Thickness")==0) {
-                t = td_it->text().as_double();
-            }
-
-            if(nodename.compare("Transmission")==0){
-                double w = td_it->child("Wavelength").text().as_double();
-                double v = td_it->child("Value").text().as_double();
-                g->appendTransmittanceData(w/1000.0, v, t);
-            }
+            diagnostics.add(LoadDiagnostics::AlkaliResistNotFound, g->productName());
         }
 
         // DnDt data
@@ -392,7 +576,17 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
         }
         else{
             g->setHasThermalData(false);
-            parse_result += filename + ": " + g->productName() + ": " + "Not found DnDtConstants\n";
+            diagnostics.add(LoadDiagnostics::ThermalDataNotFound, g->productName());
+        }
+
+        // TCE, other data and transmittance are decoded on first access
+        qint64 sectionOffset = glass_it->offset_debug() - 1; // offset_debug() points to the node name after '<'
+        qint64 sectionEnd    = (sectionOffset >= 0) ? xmlbytes.indexOf("</Glass>", static_cast<int>(sectionOffset)) : -1;
+        if(deferrable && sectionEnd > 0 && xmlbytes.mid(sectionOffset, 6) == "<Glass"){
+            sectionEnd += 8; // length of "</Glass>"
+            g->setDeferredSection(this, sectionOffset, sectionEnd - sectionOffset);
+        }else{
+            parseDeferredXmlGlass(g, *glass_it);
         }
 
         // append to list
@@ -407,3 +601,104 @@ bool GlassCatalog::loadXml(QString xmlpath, QString& parse_result)
 
     return true;
 }
+
+
+void GlassCatalog::loadDeferredSection(Glass* glass) const
+{
+    QMutexLocker locker(&deferred_mutex_);
+
+    // decoded by another thread while waiting for the lock
+    if(glass->deferred_loaded_.loadAcquire()){
+        return;
+    }
+
+    QFile file(file_path_);
+    if(!(isSourceUnchanged() && file.open(QIODevice::ReadOnly) && decodeDeferredSection(glass, &file))){
+        addDeferredFailure(glass);
+    }
+}
+
+void GlassCatalog::loadDeferredSections() const
+{
+    QMutexLocker locker(&deferred_mutex_);
+
+    QFile file(file_path_);
+    bool opened = false;
+
+    // glasses are stored in the order of the file, so the sections are read forward
+    for(Glass* g : glasses_)
+    {
+        if(g->deferred_loaded_.loadAcquire()){
+            continue;
+        }
+        if(!opened){
+            opened = isSourceUnchanged() && file.open(QIODevice::ReadOnly);
+        }
+        if(!(opened && decodeDeferredSection(g, &file))){
+            addDeferredFailure(g);
+        }
+    }
+}
+
+bool GlassCatalog::isSourceUnchanged() const
+{
+    QFileInfo finfo(file_path_);
+    return ( finfo.exists() && finfo.size() == file_size_ && finfo.lastModified() == file_modified_ );
+}
+
+bool GlassCatalog::decodeDeferredSection(Glass* glass, QIODevice* file) const
+{
+    if(!file->seek(glass->deferred_offset_)){
+        return false;
+    }
+    QByteArray sectionbytes = file->read(glass->deferred_length_);
+    if(sectionbytes.size() != glass->deferred_length_){
+        return false;
+    }
+
+    bool decoded = false;
+    if(FormatAGF == format_)
+    {
+        QBuffer buffer(&sectionbytes);
+        buffer.open(QIODevice::ReadOnly);
+        TextLineReader reader(&buffer, static_cast<TextLineReader::Encoding>(text_encoding_));
+
+        QByteArray linebytes;
+        qint64 lineoffset;
+        while(reader.readLine(linebytes, lineoffset))
+        {
+            QString linetext = reader.decode(linebytes);
+            parseDeferredAGFLine(glass, linetext.left(2), linetext);
+        }
+        decoded = true;
+    }
+    else
+    {
+        pugi::xml_document doc;
+        if(doc.load_buffer(sectionbytes.constData(), sectionbytes.size(), pugi::parse_default, pugi::encoding_utf8) && doc.child("Glass")){
+            parseDeferredXmlGlass(glass, doc.child("Glass"));
+            decoded = true;
+        }
+    }
+
+    if(decoded){
+        glass->deferred_loaded_.storeRelease(1);
+    }
+    return decoded;
+}
+
+void GlassCatalog::addDeferredFailure(const Glass* glass) const
+{
+    // retried on the next access, and recorded only once
+    if(!deferred_failed_glasses_.contains(glass)){
+        deferred_failed_glasses_.insert(glass);
+        deferred_diagnostics_.beginFile(file_path_);
+        deferred_diagnostics_.add(LoadDiagnostics::DeferredDataError, glass->productName());
+    }
+}
+
+LoadDiagnostics GlassCatalog::deferredDiagnostics() const
+{
+    QMutexLocker locker(&deferred_mutex_);
+    return deferred_diagnostics_;
+}
@@ -28,8 +28,18 @@
 #include <QString>
 #include <QList>
 #include <QMap>
+#include <QDateTime>
+#include <QMutex>
+#include <QSet>
+#include <QVector>
+#include <vector>
+#include <memory>
 
 #include "glass.h"
+#include "glass_load_filter.h"
+#include "load_diagnostics.h"
+
+class QIODevice;
 
 /** GlassCatalog Container Class */
 class GlassCatalog
@@ -40,35 +50,97 @@ public:
 
     QString supplier() const {return supplier_;}
 
+    /** Path of the catalog file which this catalog was loaded from */
+    QString filePath() const {return file_path_;}
+
     Glass*  glass(int n) const;
     Glass*  glass(const QString& glassname) const;
     int glassCount() const{return glasses_.size();}
     bool hasGlass(const QString& glassname) const;
 
+    /** Number of glasses rejected by the load filter */
+    int skippedGlassCount() const{return skipped_glass_count_;}
+
     /**
      * @brief Load glass data from Zemax AGF file
      * @param AGFpath AGF file path
-     * @param parse_result Container for notable parse results
+     * @param diagnostics Container for notable parse results
+     * @param filter Glasses not accepted by the filter are skipped
      * @return
      */
-    bool loadAGF(const QString& AGFpath, QString& parse_result);
+    bool loadAGF(const QString& AGFpath, LoadDiagnostics& diagnostics, const GlassLoadFilter& filter = GlassLoadFilter());
 
 
     /**
      * @brief Load glass data from CODEV Xml file
      * @param xmlpath Xml file path
-     * @param parse_result Container for notable parse results
+     * @param diagnostics Container for notable parse results
+     * @param filter Glasses not accepted by the filter are skipped
      * @return
      */
-    bool loadXml(QString xmlpath, QString& parse_result);
+    bool loadXml(QString xmlpath, LoadDiagnostics& diagnostics, const GlassLoadFilter& filter = GlassLoadFilter());
 
     void clear();
 
+    /**
+     * @brief Decode the glass data skipped in the first parse pass
+     * @details Called by Glass on the first access to the deferred data.  This is thread safe.
+     *          The section is read again from the catalog file.  The glass stays undecoded if the file has been changed
+     *          or its section is broken, and the failure is recorded in deferredDiagnostics().
+     */
+    void loadDeferredSection(Glass* glass) const;
+
+    /**
+     * @brief Decode the deferred data of all glasses at once
+     * @details Used before walking every glass, so that the catalog file is opened once instead of once per glass.
+     */
+    void loadDeferredSections() const;
+
+    /** Failures of decoding the deferred sections so far */
+    LoadDiagnostics deferredDiagnostics() const;
+
 private:
-    QString       supplier_;
-    QList<Glass*> glasses_;
+    enum CatalogFormat{
+        FormatAGF,
+        FormatXML
+    };
+
+    /** Check that the catalog file has not been changed since the first parse pass */
+    bool isSourceUnchanged() const;
+
+    /** Read and decode the deferred section of the glass from the opened catalog file.  deferred_mutex_ must be locked. */
+    bool decodeDeferredSection(Glass* glass, QIODevice* file) const;
+
+    /** Record the glass whose deferred section could not be decoded.  deferred_mutex_ must be locked. */
+    void addDeferredFailure(const Glass* glass) const;
+
+    /** Get a new glass from the block storage */
+    Glass* allocateGlass();
+
+    /** Return the glass last allocated, which has been rejected while parsing */
+    void releaseLastGlass(Glass* g);
+
+    QString         supplier_;
+    QString         file_path_;
+    QVector<Glass*> glasses_;
+
+    // Glasses are stored contiguously in blocks, so that their addresses do not change while loading.
+    static constexpr int glass_block_size_ = 128;
+    std::vector< std::unique_ptr<Glass[]> > glass_blocks_;
+    int             glass_block_used_;
 
     QMap<QString, int> name_to_int_map_;
+
+    int skipped_glass_count_;
+
+    // source of the deferred sections, which are read from the file only if it is the same as in the first parse pass
+    CatalogFormat  format_;
+    int            text_encoding_;
+    qint64         file_size_;
+    QDateTime      file_modified_;
+    mutable QMutex deferred_mutex_;
+    mutable LoadDiagnostics     deferred_diagnostics_;
+    mutable QSet<const Glass*>  deferred_failed_glasses_;
 };
 
 
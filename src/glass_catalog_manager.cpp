@@ -25,107 +25,318 @@
 #include <QFileInfo>
 #include <QTextCodec>
 #include <QTextStream>
+#include <QFileSystemWatcher>
+#include <QTimer>
 #include "glass_catalog_manager.h"
 
-QList<GlassCatalog*> GlassCatalogManager::m_catalogList;
+GlassCatalogManager* GlassCatalogManager::m_instance = nullptr;
+CatalogSnapshotPtr GlassCatalogManager::m_snapshot = std::make_shared<const CatalogSnapshot>();
+GlassLoadFilter GlassCatalogManager::m_loadFilter;
+CatalogSnapshot::HandleIndex GlassCatalogManager::m_handleIndex;
 
-GlassCatalogManager::GlassCatalogManager()
+GlassCatalogManager::GlassCatalogManager(QObject* parent) :
+    QObject(parent)
 {
+    m_instance = this;
 
+    m_fileWatcher = new QFileSystemWatcher(this);
+    QObject::connect(m_fileWatcher, SIGNAL(fileChanged(QString)), this, SLOT(onCatalogFileChanged(QString)));
+    QObject::connect(m_fileWatcher, SIGNAL(directoryChanged(QString)), this, SLOT(onCatalogDirectoryChanged(QString)));
+
+    // Vendor tools often write a catalog in several steps, so changes are collected for a while before reloading.
+    m_reloadTimer = new QTimer(this);
+    m_reloadTimer->setSingleShot(true);
+    m_reloadTimer->setInterval(500);
+    QObject::connect(m_reloadTimer, SIGNAL(timeout()), this, SLOT(reloadPendingFiles()));
 }
 
 GlassCatalogManager::~GlassCatalogManager()
 {
-    if(!m_catalogList.isEmpty())
-    {
-        for (auto &cat: m_catalogList) {
-            delete cat;
-        }
-        m_catalogList.clear();
+    // catalogs are freed when the last reader releases its snapshot
+    publish(std::make_shared<const CatalogSnapshot>());
+
+    if(m_instance == this){
+        m_instance = nullptr;
     }
 }
 
+GlassCatalogManager* GlassCatalogManager::instance()
+{
+    return m_instance;
+}
+
+CatalogSnapshotPtr GlassCatalogManager::snapshot()
+{
+    return std::atomic_load(&m_snapshot);
+}
 
-QList<GlassCatalog*>& GlassCatalogManager::catalogList()
+void GlassCatalogManager::publish(const CatalogSnapshotPtr &snapshot)
 {
-    return m_catalogList;
+    std::atomic_store(&m_snapshot, snapshot);
 }
 
 bool GlassCatalogManager::isEmpty()
 {
-    return m_catalogList.isEmpty();
+    return snapshot()->isEmpty();
 }
 
-Glass* GlassCatalogManager::find(QString fullName)
+Glass* GlassCatalogManager::find(const QString& fullName)
 {
-    QStringList splitedText  = fullName.split("_");
-    QString     productName  = splitedText[0];
-    QString     supplierName = splitedText[1];
+    return snapshot()->find(fullName);
+}
 
-    int catalogCount = m_catalogList.size();
-    for(int i = 0; i < catalogCount; i++) {
-        if(m_catalogList[i]->supplier() == supplierName){
-            if(m_catalogList[i]->hasGlass(productName)){
-                return m_catalogList[i]->glass(productName);
-            }
+Glass* GlassCatalogManager::find(const QString &supplier, const QString &productName)
+{
+    return snapshot()->find(supplier, productName);
+}
+
+Glass* GlassCatalogManager::glass(GlassHandle handle)
+{
+    return snapshot()->glass(handle);
+}
+
+GlassHandle GlassCatalogManager::handle(const QString &supplier, const QString &productName)
+{
+    return snapshot()->handle(supplier, productName);
+}
+
+void GlassCatalogManager::assignHandles(GlassCatalog *catalog)
+{
+    int glassCount = catalog->glassCount();
+    for(int i = 0; i < glassCount; i++){
+        Glass* g = catalog->glass(i);
+        QPair<QString, QString> key(g->supplier(), g->productName());
+
+        GlassHandle h = m_handleIndex.value(key, 0);
+        if(0 == h){
+            h = m_handleIndex.size() + 1;
+            m_handleIndex.insert(key, h);
         }
-    }
 
-    return nullptr;
+        g->setHandle(h);
+    }
 }
 
-void GlassCatalogManager::loadCatalogFiles(const QStringList &catalogFilePaths, QString& parseResult)
+void GlassCatalogManager::loadCatalogFiles(const QStringList &catalogFilePaths, LoadDiagnostics& diagnostics)
 {
     if(catalogFilePaths.empty()) {
         return;
     }
 
-    // clear old catalogs
-    if(!m_catalogList.isEmpty())
-    {
-        for (auto &cat: m_catalogList) {
-            delete cat;
-        }
-        m_catalogList.clear();
-    }
+    // load catalogs. Old catalogs stay alive while readers hold the previous snapshot.
+    QVector< std::shared_ptr<GlassCatalog> > catalogs;
 
-    // load catalogs
-    GlassCatalog* catalog;
-    QString parse_result, parse_result_all;
+    for(int i = 0; i < catalogFilePaths.size(); i++){
+        if(!acceptsCatalog(catalogFilePaths[i], nullptr, diagnostics)){
+            continue;
+        }
 
-    QFileInfo finfo;
-    finfo.setFile(catalogFilePaths.first());
-    QString ext = finfo.suffix().toLower(); // .agf, .xml
+        std::shared_ptr<GlassCatalog> catalog = std::make_shared<GlassCatalog>();
 
-    for(int i = 0; i < catalogFilePaths.size(); i++){
-        catalog = new GlassCatalog;
-        parse_result.clear();
+        bool ok = loadCatalogFile(catalog.get(), catalogFilePaths[i], diagnostics);
 
-        bool ok;
-        if(ext == "agf"){
-            ok = catalog->loadAGF(catalogFilePaths[i], parse_result);
-        }else{
-            ok = catalog->loadXml(catalogFilePaths[i], parse_result);
+        if(ok && !acceptsCatalog(catalogFilePaths[i], catalog.get(), diagnostics)){
+            continue;
         }
 
         if(ok){
-            m_catalogList.append(catalog);
-            parse_result_all += parse_result;
+            assignHandles(catalog.get());
+            catalogs.append(catalog);
         }
         else{
-            parse_result_all += ("Catalog loading error:" + catalogFilePaths[i] + "\n");
-            try {
-                delete catalog;
-            }  catch (...) {
-                return;
-            }
-            continue;
+            diagnostics.beginFile(catalogFilePaths[i]);
+            diagnostics.add(LoadDiagnostics::LoadError);
+        }
+    }
+
+    publish(std::make_shared<const CatalogSnapshot>(catalogs, m_handleIndex));
+
+    watchCatalogFiles();
+}
+
+int GlassCatalogManager::reloadCatalogFile(const QString &catalogFilePath, LoadDiagnostics &diagnostics)
+{
+    CatalogSnapshotPtr current = snapshot();
+
+    int catalogIndex = -1;
+    for(int i = 0; i < current->catalogCount(); i++){
+        if(current->catalog(i)->filePath() == catalogFilePath){
+            catalogIndex = i;
+            break;
+        }
+    }
+    if(catalogIndex < 0){
+        return -1;
+    }
+
+    // the old catalog stays in use if the supplier is excluded by the current filter
+    if(!acceptsCatalog(catalogFilePath, nullptr, diagnostics)){
+        return -1;
+    }
+
+    // parse into a new catalog first, so that the old snapshot stays in use if the file is broken
+    std::shared_ptr<GlassCatalog> catalog = std::make_shared<GlassCatalog>();
+    if(!loadCatalogFile(catalog.get(), catalogFilePath, diagnostics)){
+        diagnostics.beginFile(catalogFilePath);
+        diagnostics.add(LoadDiagnostics::LoadError);
+        return -1;
+    }
+    if(!acceptsCatalog(catalogFilePath, catalog.get(), diagnostics)){
+        return -1;
+    }
+
+    assignHandles(catalog.get());
+
+    QVector< std::shared_ptr<GlassCatalog> > catalogs = current->catalogs();
+    catalogs[catalogIndex] = catalog;
+    publish(std::make_shared<const CatalogSnapshot>(catalogs, m_handleIndex));
+
+    if(m_instance){
+        emit m_instance->catalogReloaded(catalogIndex);
+    }
+
+    return catalogIndex;
+}
+
+void GlassCatalogManager::setLoadFilter(const GlassLoadFilter &filter)
+{
+    m_loadFilter = filter;
+}
+
+const GlassLoadFilter& GlassCatalogManager::loadFilter()
+{
+    return m_loadFilter;
+}
+
+bool GlassCatalogManager::loadCatalogFile(GlassCatalog *catalog, const QString &catalogFilePath, LoadDiagnostics &diagnostics)
+{
+    // .agf, .xml, .agf.gz, .xml.gz
+    QString filename = QFileInfo(catalogFilePath).fileName().toLower();
+    if(filename.endsWith(".gz")){
+        filename.chop(3);
+    }
+
+    if(filename.endsWith(".agf")){
+        return catalog->loadAGF(catalogFilePath, diagnostics, m_loadFilter);
+    }else{
+        return catalog->loadXml(catalogFilePath, diagnostics, m_loadFilter);
+    }
+}
+
+bool GlassCatalogManager::acceptsCatalog(const QString &catalogFilePath, const GlassCatalog *catalog, LoadDiagnostics &diagnostics)
+{
+    QString supplier;
+    if(catalog){
+        supplier = catalog->supplier();
+    }else{
+        QString filename = QFileInfo(catalogFilePath).fileName().toLower();
+        if(filename.endsWith(".gz")){
+            filename.chop(3);
+        }
+        if(!filename.endsWith(".agf")){
+            return true;
+        }
+        supplier = QFileInfo(catalogFilePath).baseName();
+    }
+
+    if(m_loadFilter.acceptsSupplier(supplier)){
+        return true;
+    }
+
+    diagnostics.beginFile(catalogFilePath);
+    diagnostics.add(LoadDiagnostics::SkippedByFilter);
+    return false;
+}
+
+void GlassCatalogManager::watchCatalogFiles()
+{
+    if(!m_instance){
+        return;
+    }
+
+    QStringList watchedFiles = m_instance->m_fileWatcher->files();
+    QStringList watchedDirs  = m_instance->m_fileWatcher->directories();
+    QStringList catalogFilePaths;
+    QStringList catalogDirs;
+    for(auto &cat : snapshot()->catalogs()){
+        catalogFilePaths.append(cat->filePath());
+
+        QString dir = QFileInfo(cat->filePath()).absolutePath();
+        if(!catalogDirs.contains(dir)){
+            catalogDirs.append(dir);
+        }
+    }
+
+    for(auto &path : watchedFiles){
+        if(!catalogFilePaths.contains(path)){
+            m_instance->m_fileWatcher->removePath(path);
+        }
+    }
+    for(auto &dir : watchedDirs){
+        if(!catalogDirs.contains(dir)){
+            m_instance->m_fileWatcher->removePath(dir);
         }
     }
 
-    catalog = nullptr;
+    // A file replaced by rename is dropped from the watcher, so it is added again here.
+    for(auto &path : catalogFilePaths){
+        if(!watchedFiles.contains(path) && QFileInfo::exists(path)){
+            m_instance->m_fileWatcher->addPath(path);
+        }
+    }
+
+    // The directories are watched to notice a file which was missing for a moment
+    for(auto &dir : catalogDirs){
+        if(!watchedDirs.contains(dir) && QFileInfo::exists(dir)){
+            m_instance->m_fileWatcher->addPath(dir);
+        }
+    }
+}
 
-    parseResult = parse_result_all;
+void GlassCatalogManager::onCatalogFileChanged(const QString &path)
+{
+    m_pendingFilePaths.insert(path);
+    m_reloadTimer->start();
+}
 
+void GlassCatalogManager::onCatalogDirectoryChanged(const QString &path)
+{
+    // Editors which save by delete-and-rename remove the file for a moment, and the watcher drops it.
+    // Such a file is watched again and reloaded when it reappears.
+    QStringList watchedFiles = m_fileWatcher->files();
+    for(auto &cat : snapshot()->catalogs()){
+        QString filePath = cat->filePath();
+        if(QFileInfo(filePath).absolutePath() == path && !watchedFiles.contains(filePath) && QFileInfo::exists(filePath)){
+            m_fileWatcher->addPath(filePath);
+            onCatalogFileChanged(filePath);
+        }
+    }
+}
+
+void GlassCatalogManager::reloadPendingFiles()
+{
+    QSet<QString> filePaths = m_pendingFilePaths;
+    m_pendingFilePaths.clear();
+
+    QStringList failedPaths;
+    LoadDiagnostics failedDiagnostics;
+
+    for(auto &path : filePaths){
+        if(!QFileInfo::exists(path)){
+            continue;
+        }
+
+        LoadDiagnostics diagnostics;
+        if(reloadCatalogFile(path, diagnostics) < 0){
+            failedPaths.append(path);
+            failedDiagnostics.append(diagnostics);
+        }
+    }
+
+    watchCatalogFiles();
+
+    if(!failedPaths.isEmpty()){
+        emit catalogReloadFailed(failedPaths, failedDiagnostics);
+    }
 }
 
@@ -26,26 +26,98 @@
 #ifndef GLASSCATALOGMANAGER_H
 #define GLASSCATALOGMANAGER_H
 
+#include <QObject>
 #include <QString>
 #include <QList>
 #include <QStringList>
+#include <QSet>
+#include <QHash>
+#include <QPair>
+#include <QVector>
 
 #include "glass_catalog.h"
+#include "catalog_snapshot.h"
+
+class QFileSystemWatcher;
+class QTimer;
 
 /** top level management class */
-class GlassCatalogManager
+class GlassCatalogManager : public QObject
 {
+    Q_OBJECT
+
 public:
-    GlassCatalogManager();
+    GlassCatalogManager(QObject* parent = nullptr);
     ~GlassCatalogManager();
 
-    static QList<GlassCatalog*>& catalogList();
+    /** The manager instance which emits catalog change notifications */
+    static GlassCatalogManager* instance();
+
+    /**
+     * @brief Get the current set of catalogs
+     * @details Lock free and safe to call from any thread.  Glasses obtained from the snapshot stay valid while it is held.
+     */
+    static CatalogSnapshotPtr snapshot();
+
+    // convenience functions on the current snapshot
     static bool isEmpty();
-    static Glass* find(QString fullName);
-    static void loadCatalogFiles(const QStringList& catalogFilePaths, QString& parseResult);
+    static Glass* find(const QString& fullName);
+    static Glass* find(const QString& supplier, const QString& productName);
+    static Glass* glass(GlassHandle handle);
+    static GlassHandle handle(const QString& supplier, const QString& productName);
+
+    static void loadCatalogFiles(const QStringList& catalogFilePaths, LoadDiagnostics& diagnostics);
+
+    /**
+     * @brief Re-parse a single catalog file and swap it in place of the old one
+     * @param catalogFilePath path of the catalog file that has been loaded before
+     * @param diagnostics Container for notable parse results
+     * @return index of the replaced catalog, or -1 if the file is not loaded or could not be parsed
+     */
+    static int reloadCatalogFile(const QString& catalogFilePath, LoadDiagnostics& diagnostics);
+
+    /** Filter applied to the following loads and reloads */
+    static void setLoadFilter(const GlassLoadFilter& filter);
+    static const GlassLoadFilter& loadFilter();
+
+signals:
+    /** Emitted after the catalog at the index has been replaced by a newly parsed one */
+    void catalogReloaded(int catalogIndex);
+
+    /**
+     * @brief Emitted after changed catalog files could not be reloaded
+     * @details The old catalogs stay in use. The diagnostics hold the parse results of the rejected files.
+     */
+    void catalogReloadFailed(const QStringList& filePaths, const LoadDiagnostics& diagnostics);
+
+private slots:
+    void onCatalogFileChanged(const QString& path);
+    void onCatalogDirectoryChanged(const QString& path);
+    void reloadPendingFiles();
 
 private:
-    static QList<GlassCatalog*> m_catalogList;
+    static bool loadCatalogFile(GlassCatalog* catalog, const QString& catalogFilePath, LoadDiagnostics& diagnostics);
+
+    /**
+     * @brief Check the supplier of the catalog against the load filter, and record the exclusion in diagnostics
+     * @details The supplier of an AGF file is its file name, so a rejected file is not opened at all.
+     *          The supplier of an Xml file is written in the file, so it is checked again with the loaded catalog.
+     */
+    static bool acceptsCatalog(const QString& catalogFilePath, const GlassCatalog* catalog, LoadDiagnostics& diagnostics);
+    static void watchCatalogFiles();
+    static void publish(const CatalogSnapshotPtr& snapshot);
+
+    /** Assign handles to a new catalog.  Handles are kept for the same supplier and product name. */
+    static void assignHandles(GlassCatalog* catalog);
+
+    static GlassCatalogManager* m_instance;
+    static CatalogSnapshotPtr   m_snapshot; // accessed by std::atomic_load/atomic_store only
+    static GlassLoadFilter      m_loadFilter;
+    static CatalogSnapshot::HandleIndex m_handleIndex;
+
+    QFileSystemWatcher* m_fileWatcher;
+    QTimer*             m_reloadTimer;
+    QSet<QString>       m_pendingFilePaths;
 };
 
 #endif
@@ -0,0 +1,328 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_constraint_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QtConcurrent>
+
+#include "glass_catalog.h"
+#include "user_property_registry.h"
+
+namespace {
+
+const QString kNumber = "([-+]?(?:\\d+\\.?\\d*|\\.\\d+)(?:[eE][-+]?\\d+)?)";
+const QString kIdent  = "([A-Za-z_][A-Za-z0-9_]*)";
+const QString kOp     = "(<=|>=|<|>|=)";
+
+/** apply "property op value" to the range */
+void applyBound(GlassConstraintQuery::Range& range, const QString& op, double value)
+{
+    if("<" == op || "<=" == op){
+        range.upper = value;
+        range.upperInclusive = ("<=" == op);
+    }
+    else if(">" == op || ">=" == op){
+        range.lower = value;
+        range.lowerInclusive = (">=" == op);
+    }
+    else{ // "="
+        range.lower = value;
+        range.upper = value;
+        range.lowerInclusive = true;
+        range.upperInclusive = true;
+    }
+}
+
+/** "value op property" is "property mirrored-op value" */
+QString mirrored(const QString& op)
+{
+    if("<"  == op) return ">";
+    if("<=" == op) return ">=";
+    if(">"  == op) return "<";
+    if(">=" == op) return "<=";
+    return op;
+}
+
+GlassConstraintQuery::Range unboundedRange(const QString& property)
+{
+    GlassConstraintQuery::Range range;
+    range.property       = property;
+    range.lower          = -std::numeric_limits<double>::infinity();
+    range.upper          = std::numeric_limits<double>::infinity();
+    range.lowerInclusive = true;
+    range.upperInclusive = true;
+    return range;
+}
+
+bool inRange(const GlassConstraintQuery::Range& range, double val)
+{
+    if(qIsNaN(val)) return false;
+    if(range.lowerInclusive ? (val < range.lower) : (val <= range.lower)) return false;
+    if(range.upperInclusive ? (val > range.upper) : (val >= range.upper)) return false;
+    return true;
+}
+
+/** decode the deferred data of all glasses before the table walks them, so that each catalog file is read once */
+CatalogSnapshotPtr withDeferredSections(CatalogSnapshotPtr snapshot)
+{
+    if(snapshot){
+        for(auto &cat : snapshot->catalogs()){
+            cat->loadDeferredSections();
+        }
+    }
+    return snapshot;
+}
+
+} // namespace
+
+
+GlassConstraintQuery GlassConstraintQuery::parse(const QString &text, QString *errorMessage)
+{
+    static const QRegularExpression reCategory("^(status|supplier)\\s*=\\s*(.+)$", QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression reBetween("^" + kNumber + "\\s*" + kOp + "\\s*" + kIdent + "\\s*" + kOp + "\\s*" + kNumber + "$");
+    static const QRegularExpression reRight("^" + kIdent + "\\s*" + kOp + "\\s*" + kNumber + "$");
+    static const QRegularExpression reLeft("^" + kNumber + "\\s*" + kOp + "\\s*" + kIdent + "$");
+
+    GlassConstraintQuery query;
+
+    QString normalized = text;
+    normalized.replace(QChar(0x2264), "<=").replace(QChar(0x2265), ">=");
+
+    const QStringList clauses = normalized.split(QRegularExpression("[,;]"));
+    for(const QString& c : clauses)
+    {
+        QString clause = c.trimmed();
+        if(clause.isEmpty()){
+            continue;
+        }
+
+        QRegularExpressionMatch m = reCategory.match(clause);
+        if(m.hasMatch()){
+            QStringList choices;
+            for(const QString& choice : m.captured(2).split('|')){
+                if(!choice.trimmed().isEmpty()){
+                    choices.append(choice.trimmed().toLower());
+                }
+            }
+            if(0 == m.captured(1).compare("status", Qt::CaseInsensitive)){
+                // standard glasses have the status name "-"
+                if(choices.contains("standard") && !choices.contains("-")){
+                    choices.append("-");
+                }
+                query.statuses.append(choices);
+            }else{
+                query.suppliers.append(choices);
+            }
+            continue;
+        }
+
+        m = reBetween.match(clause);
+        if(m.hasMatch()){
+            GlassConstraintQuery::Range range = unboundedRange(m.captured(3));
+            applyBound(range, mirrored(m.captured(2)), m.captured(1).toDouble());
+            applyBound(range, m.captured(4), m.captured(5).toDouble());
+            query.ranges.append(range);
+            continue;
+        }
+
+        m = reRight.match(clause);
+        if(m.hasMatch()){
+            GlassConstraintQuery::Range range = unboundedRange(m.captured(1));
+            applyBound(range, m.captured(2), m.captured(3).toDouble());
+            query.ranges.append(range);
+            continue;
+        }
+
+        m = reLeft.match(clause);
+        if(m.hasMatch()){
+            GlassConstraintQuery::Range range = unboundedRange(m.captured(3));
+            applyBound(range, mirrored(m.captured(2)), m.captured(1).toDouble());
+            query.ranges.append(range);
+            continue;
+        }
+
+        if(errorMessage){
+            *errorMessage = "Invalid condition: " + clause;
+        }
+        return GlassConstraintQuery();
+    }
+
+    return query;
+}
+
+
+GlassConstraintIndex::GlassConstraintIndex(CatalogSnapshotPtr snapshot)
+    : table_(withDeferredSections(snapshot), propertyNames())
+{
+    const int rowCount = table_.rowCount();
+    const int colCount = table_.columnCount();
+
+    // sorted indices
+    sorted_values_.resize(colCount);
+    sorted_rows_.resize(colCount);
+
+    QVector<int> tasks(colCount);
+    std::iota(tasks.begin(), tasks.end(), 0);
+
+    QtConcurrent::blockingMap(tasks, [this, rowCount](int col){
+        const double* v = table_.column(col);
+        QVector<int>& rows = sorted_rows_[col];
+        rows.reserve(rowCount);
+        for(int r = 0; r < rowCount; r++){
+            if(!qIsNaN(v[r])){
+                rows.append(r);
+            }
+        }
+        std::sort(rows.begin(), rows.end(), [v](int a, int b){ return v[a] < v[b]; });
+
+        QVector<double>& values = sorted_values_[col];
+        values.resize(rows.size());
+        for(int i = 0; i < rows.size(); i++){
+            values[i] = v[rows[i]];
+        }
+    });
+
+    // categorical bitmaps
+    for(int r = 0; r < rowCount; r++){
+        const Glass* g = table_.glass(r);
+
+        QBitArray& statusBits = status_bits_[g->status().toLower()];
+        if(statusBits.isEmpty()) statusBits.resize(rowCount);
+        statusBits.setBit(r);
+
+        QBitArray& supplierBits = supplier_bits_[g->supplier().toLower()];
+        if(supplierBits.isEmpty()) supplierBits.resize(rowCount);
+        supplierBits.setBit(r);
+    }
+}
+
+std::shared_ptr<const GlassConstraintIndex> GlassConstraintIndex::instance(const CatalogSnapshotPtr &snapshot)
+{
+    static QMutex mutex;
+    static std::shared_ptr<const GlassConstraintIndex> cached;
+
+    QMutexLocker locker(&mutex);
+    if(!cached || !cached->isCurrent(snapshot)){
+        cached = std::make_shared<const GlassConstraintIndex>(snapshot);
+    }
+    return cached;
+}
+
+QStringList GlassConstraintIndex::propertyNames()
+{
+    return Glass::valueNames() + UserPropertyRegistry::names();
+}
+
+bool GlassConstraintIndex::locateRange(const GlassConstraintQuery::Range &range, int *column, int *begin, int *end) const
+{
+    int col = table_.columnIndex(range.property);
+    if(col < 0){
+        return false;
+    }
+
+    const QVector<double>& values = sorted_values_[col];
+    auto first = range.lowerInclusive ? std::lower_bound(values.begin(), values.end(), range.lower)
+                                      : std::upper_bound(values.begin(), values.end(), range.lower);
+    auto last  = range.upperInclusive ? std::upper_bound(values.begin(), values.end(), range.upper)
+                                      : std::lower_bound(values.begin(), values.end(), range.upper);
+
+    *column = col;
+    *begin  = static_cast<int>(first - values.begin());
+    *end    = qMax(*begin, static_cast<int>(last - values.begin()));
+    return true;
+}
+
+QBitArray GlassConstraintIndex::select(const GlassConstraintQuery &query, QString *errorMessage) const
+{
+    const int rowCount = table_.rowCount();
+
+    // locate each range and start from the narrowest one
+    struct Located{ int index; int column; int begin; int end; };
+    QVector<Located> located;
+    for(int i = 0; i < query.ranges.size(); i++){
+        Located l;
+        l.index = i;
+        if(!locateRange(query.ranges[i], &l.column, &l.begin, &l.end)){
+            if(errorMessage){
+                *errorMessage = "Unknown property: " + query.ranges[i].property;
+            }
+            return QBitArray(rowCount, false);
+        }
+        located.append(l);
+    }
+    std::sort(located.begin(), located.end(), [](const Located& a, const Located& b){
+        return (a.end - a.begin) < (b.end - b.begin);
+    });
+
+    // union of the choices for each category
+    auto categoryBits = [rowCount](const QHash<QString, QBitArray>& bitmaps, const QStringList& choices){
+        QBitArray bits(rowCount, false);
+        for(const QString& choice : choices){
+            auto it = bitmaps.constFind(choice);
+            if(it != bitmaps.constEnd()){
+                bits |= it.value();
+            }
+        }
+        return bits;
+    };
+
+    QBitArray bits(rowCount, true);
+    if(!query.statuses.isEmpty()){
+        bits &= categoryBits(status_bits_, query.statuses);
+    }
+    if(!query.suppliers.isEmpty()){
+        bits &= categoryBits(supplier_bits_, query.suppliers);
+    }
+
+    if(located.isEmpty()){
+        return bits;
+    }
+
+    // candidates of the narrowest range are checked against the others
+    QBitArray result(rowCount, false);
+    const Located& first = located.front();
+    const QVector<int>& sortedRows = sorted_rows_[first.column];
+    for(int i = first.begin; i < first.end; i++){
+        int row = sortedRows[i];
+        if(!bits.testBit(row)){
+            continue;
+        }
+
+        bool ok = true;
+        for(int j = 1; j < located.size() && ok; j++){
+            ok = inRange(query.ranges[located[j].index], table_.value(row, located[j].column));
+        }
+        if(ok){
+            result.setBit(row);
+        }
+    }
+
+    return result;
+}
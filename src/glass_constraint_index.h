@@ -0,0 +1,111 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_CONSTRAINT_INDEX_H
+#define GLASS_CONSTRAINT_INDEX_H
+
+#include <memory>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QBitArray>
+
+#include "glass_property_table.h"
+
+/**
+ * @brief Conjunction of property ranges and status/supplier choices
+ * @details
+ * Text form is a list of clauses separated by ',' or ';', for example
+ * "1.80 < nd < 1.85, vd > 40, climateResist <= 2, relCost < 3, status = Preferred".
+ * status and supplier take alternatives separated by '|'.
+ * "Standard" is accepted for the standard status, which catalogs name "-".
+ */
+class GlassConstraintQuery
+{
+public:
+    struct Range{
+        QString property;
+        double  lower;
+        double  upper;
+        bool    lowerInclusive;
+        bool    upperInclusive;
+    };
+
+    bool isEmpty() const{ return ranges.isEmpty() && statuses.isEmpty() && suppliers.isEmpty(); }
+
+    /**
+     * @brief Parse the text form
+     * @param errorMessage set if the text is invalid
+     * @return empty query if the text is invalid
+     */
+    static GlassConstraintQuery parse(const QString& text, QString* errorMessage = nullptr);
+
+    QVector<Range> ranges;
+    QStringList    statuses;
+    QStringList    suppliers;
+};
+
+
+/**
+ * @brief Sorted indices of numeric properties and bitmaps of status and supplier
+ * @details
+ * Built once per catalog snapshot.  A range is located in the sorted values by binary search,
+ * and the constraints are intersected starting from the one with the fewest candidates.
+ * Row numbers are those of the property table.
+ */
+class GlassConstraintIndex
+{
+public:
+    explicit GlassConstraintIndex(CatalogSnapshotPtr snapshot);
+
+    /** shared index of the snapshot, rebuilt when the snapshot or the temperature changes */
+    static std::shared_ptr<const GlassConstraintIndex> instance(const CatalogSnapshotPtr& snapshot);
+
+    /** numeric properties which can be constrained */
+    static QStringList propertyNames();
+
+    const GlassPropertyTable& table() const{ return table_; }
+
+    bool isCurrent(const CatalogSnapshotPtr& snapshot) const{ return table_.isCurrent(snapshot); }
+
+    /**
+     * @brief Rows which satisfy all the constraints
+     * @param errorMessage set if the query refers to an unknown property
+     * @return bit per row of the table.  All bits are set for an empty query.
+     */
+    QBitArray select(const GlassConstraintQuery& query, QString* errorMessage = nullptr) const;
+
+private:
+    /** find [begin, end) of the range in the sorted arrays.  false for unknown properties. */
+    bool locateRange(const GlassConstraintQuery::Range& range, int* column, int* begin, int* end) const;
+
+    GlassPropertyTable          table_;
+    QVector< QVector<double> >  sorted_values_; // per column, NaN excluded
+    QVector< QVector<int> >     sorted_rows_;
+    QHash<QString, QBitArray>   status_bits_;   // status text in lower case
+    QHash<QString, QBitArray>   supplier_bits_; // supplier name in lower case
+};
+
+#endif // GLASS_CONSTRAINT_INDEX_H
@@ -26,8 +26,11 @@
 #include "ui_glass_datasheet_form.h"
 
 #include <QDebug>
+#include <QtConcurrent>
 
 #include "spectral_line.h"
+#include "glass_catalog_manager.h"
+#include "glass_equivalence_table.h"
 
 
 GlassDataSheetForm::GlassDataSheetForm(Glass* glass, QWidget *parent) :
@@ -53,6 +56,7 @@ GlassDataSheetForm::GlassDataSheetForm(Glass* glass, QWidget *parent) :
     setUpThermalTab();
     setUpTransmittanceTab();
     setUpOtherDataTab();
+    setUpEquivalentsTab();
 }
 
 GlassDataSheetForm::~GlassDataSheetForm()
@@ -308,3 +312,50 @@ void GlassDataSheetForm::setUpOtherDataTab()
     addGridItem(grid, 5, 1, numToQString(m_glass->phosphateResist(), 'f', digit));
 }
 
+void GlassDataSheetForm::setUpEquivalentsTab()
+{
+    QWidget* scrollAreaContents = ui->scrollAreaWidgetContents_Equivalents;
+    QGridLayout* grid = new QGridLayout(scrollAreaContents);
+    grid->setObjectName(QString::fromUtf8("gridLayout_equivalents"));
+    m_gridLayoutList.append(grid);
+    m_equivalentsGrid = grid;
+
+    addGridItem(grid, 0, 0, "Searching equivalent glasses...");
+    m_equivalentsStatusLabel = m_labelList.last();
+
+    // Building the table compares all glasses, so it runs in the background and the tab is filled in later.
+    m_equivalenceWatcher = new QFutureWatcher< std::shared_ptr<const GlassEquivalenceTable> >(this);
+    QObject::connect(m_equivalenceWatcher, SIGNAL(finished()), this, SLOT(showEquivalents()));
+    m_equivalenceWatcher->setFuture(QtConcurrent::run(&GlassEquivalenceTable::instance, GlassCatalogManager::snapshot()));
+}
+
+void GlassDataSheetForm::showEquivalents()
+{
+    QGridLayout* grid = m_equivalentsGrid;
+
+    auto table = m_equivalenceWatcher->result();
+    QVector<GlassEquivalenceTable::Equivalent> equivalents = table->equivalents(table->rowOf(m_glass->handle()));
+
+    if(equivalents.isEmpty()){
+        m_equivalentsStatusLabel->setText("No glass within RMS deviation " + QString::number(table->threshold()) + " over the visible band");
+        return;
+    }
+
+    // the status label becomes the first header
+    m_equivalentsStatusLabel->setText("Glass");
+
+    addGridItem(grid, 0, 1, "Supplier");
+    addGridItem(grid, 0, 2, "nd");
+    addGridItem(grid, 0, 3, "vd");
+    addGridItem(grid, 0, 4, "RMS Deviation");
+
+    for(int i = 0; i < equivalents.size(); i++){
+        const Glass* g = table->curves().glass(equivalents[i].row);
+        addGridItem(grid, i+1, 0, g->productName());
+        addGridItem(grid, i+1, 1, g->supplier());
+        addGridItem(grid, i+1, 2, numToQString(g->getValue("nd"), 'f', 6));
+        addGridItem(grid, i+1, 3, numToQString(g->getValue("vd"), 'f', 2));
+        addGridItem(grid, i+1, 4, numToQString(equivalents[i].distance, 'e', 2));
+    }
+}
+
@@ -30,9 +30,13 @@
 #include <QGridLayout>
 #include <QLabel>
 #include <QList>
+#include <QFutureWatcher>
+#include <memory>
 
 #include "glass.h"
 
+class GlassEquivalenceTable;
+
 namespace Ui {
 class GlassDataSheetForm;
 }
@@ -47,6 +51,10 @@ public:
     explicit GlassDataSheetForm(Glass* glass, QWidget *parent = nullptr);
     ~GlassDataSheetForm();
 
+private slots:
+    /** Fill in the equivalents tab when the equivalence table has been built */
+    void showEquivalents();
+
 private:
     void setUpBasicTab();
     void setUpIndicesTab();
@@ -55,6 +63,7 @@ private:
     void setUpThermalTab();
     void setUpTransmittanceTab();
     void setUpOtherDataTab();
+    void setUpEquivalentsTab();
 
     void addGridItem(QGridLayout* gridLayout, int row, int col, QString str);
 
@@ -64,6 +73,10 @@ private:
     Glass* m_glass;
     QList<QGridLayout*> m_gridLayoutList; // contains all grids to delete later
     QList<QLabel*>      m_labelList; //contains all QLabel to delete later
+
+    QGridLayout* m_equivalentsGrid;
+    QLabel*      m_equivalentsStatusLabel; // shown while the equivalence table is built
+    QFutureWatcher< std::shared_ptr<const GlassEquivalenceTable> >* m_equivalenceWatcher;
 };
 
 QString GlassDataSheetForm::numToQString(double val, char fmt, int digit)
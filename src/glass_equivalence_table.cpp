@@ -0,0 +1,192 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_equivalence_table.h"
+
+#include <algorithm>
+#include <numeric>
+#include <QMutex>
+#include <QTextStream>
+#include <QtConcurrent>
+
+#include "glass.h"
+
+namespace {
+
+const int kRowChunkSize = 256;
+
+// visible band, where the catalogs of all suppliers have data
+const double kLambdaMin  = 0.40;
+const double kLambdaMax  = 0.70;
+const int    kSampleCount = 16;
+
+int findRoot(QVector<int>& parent, int i)
+{
+    while(parent[i] != i){
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+} // namespace
+
+constexpr double GlassEquivalenceTable::kDefaultThreshold;
+
+GlassEquivalenceTable::GlassEquivalenceTable(CatalogSnapshotPtr snapshot, double threshold)
+    : curves_(snapshot, DispersionCurveTable::uniformGrid(kLambdaMin, kLambdaMax, kSampleCount)),
+      threshold_(threshold),
+      link_count_(0)
+{
+    const int rowCount = curves_.rowCount();
+    const int m = curves_.sampleCount();
+    const QVector<double> weights(m, 1.0);
+
+    for(int r = 0; r < rowCount; r++){
+        handle_rows_.insert(curves_.glass(r)->handle(), r);
+    }
+
+    // sort the valid rows by the mean index
+    QVector<double> means(rowCount);
+    QVector<int> order;
+    for(int r = 0; r < rowCount; r++){
+        const double* n = curves_.curve(r);
+        means[r] = std::accumulate(n, n + m, 0.0)/m;
+        if(qIsFinite(means[r])){
+            order.append(r);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&means](int a, int b){ return means[a] < means[b]; });
+
+    // links of each chunk
+    QVector<int> chunks;
+    for(int begin = 0; begin < order.size(); begin += kRowChunkSize){
+        chunks.append(begin);
+    }
+    QVector< QVector< QPair<int, int> > > links(chunks.size());
+
+    QtConcurrent::blockingMap(chunks, [&](int begin){
+        QVector< QPair<int, int> >& chunkLinks = links[begin/kRowChunkSize];
+        const int end = qMin(begin + kRowChunkSize, order.size());
+        for(int i = begin; i < end; i++){
+            const int a = order[i];
+            for(int j = i + 1; j < order.size() && means[order[j]] - means[a] <= threshold_; j++){
+                const int b = order[j];
+                const double d = DispersionCurveTable::distance(curves_.curve(b), curves_.curve(a), weights.constData(), m, DispersionCurveTable::RMS, false);
+                if(d <= threshold_){
+                    chunkLinks.append(qMakePair(a, b));
+                }
+            }
+        }
+    });
+
+    // connected components
+    QVector<int> parent(rowCount);
+    std::iota(parent.begin(), parent.end(), 0);
+    for(auto &chunkLinks : links){
+        link_count_ += chunkLinks.size();
+        for(auto &link : chunkLinks){
+            const int ra = findRoot(parent, link.first);
+            const int rb = findRoot(parent, link.second);
+            if(ra != rb){
+                parent[qMax(ra, rb)] = qMin(ra, rb);
+            }
+        }
+    }
+
+    QVector<int> componentSize(rowCount, 0);
+    for(int r = 0; r < rowCount; r++){
+        componentSize[findRoot(parent, r)]++;
+    }
+
+    cluster_of_.fill(-1, rowCount);
+    QHash<int, int> rootClusters;
+    for(int r = 0; r < rowCount; r++){
+        const int root = findRoot(parent, r);
+        if(componentSize[root] < 2){
+            continue;
+        }
+        if(!rootClusters.contains(root)){
+            rootClusters.insert(root, clusters_.size());
+            clusters_.append(QVector<int>());
+        }
+        cluster_of_[r] = rootClusters.value(root);
+        clusters_[cluster_of_[r]].append(r);
+    }
+}
+
+std::shared_ptr<const GlassEquivalenceTable> GlassEquivalenceTable::instance(const CatalogSnapshotPtr &snapshot)
+{
+    static QMutex mutex;
+    static std::shared_ptr<const GlassEquivalenceTable> cached;
+
+    QMutexLocker locker(&mutex);
+    if(!cached || !cached->isCurrent(snapshot)){
+        cached = std::make_shared<const GlassEquivalenceTable>(snapshot);
+    }
+    return cached;
+}
+
+bool GlassEquivalenceTable::isCurrent(const CatalogSnapshotPtr &snapshot) const
+{
+    return curves_.isCurrent(snapshot, curves_.wavelengths());
+}
+
+QVector<GlassEquivalenceTable::Equivalent> GlassEquivalenceTable::equivalents(int row) const
+{
+    QVector<Equivalent> result;
+    if(row < 0 || cluster_of_[row] < 0){
+        return result;
+    }
+
+    const int m = curves_.sampleCount();
+    const QVector<double> weights(m, 1.0);
+    for(int other : clusters_[cluster_of_[row]]){
+        if(other != row){
+            const double d = DispersionCurveTable::distance(curves_.curve(other), curves_.curve(row), weights.constData(), m, DispersionCurveTable::RMS, false);
+            result.append(Equivalent{other, d});
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Equivalent& a, const Equivalent& b){ return a.distance < b.distance; });
+
+    return result;
+}
+
+void GlassEquivalenceTable::writeCsv(QTextStream &out) const
+{
+    const int m = curves_.sampleCount();
+    const QVector<double> weights(m, 1.0);
+
+    out << "Cluster,Supplier,Glass,nd,vd,Deviation" << "\n";
+    for(int c = 0; c < clusters_.size(); c++){
+        const int first = clusters_[c].first();
+        for(int row : clusters_[c]){
+            const Glass* g = curves_.glass(row);
+            const double d = DispersionCurveTable::distance(curves_.curve(row), curves_.curve(first), weights.constData(), m, DispersionCurveTable::RMS, false);
+            out << (c + 1) << "," << g->supplier() << "," << g->productName() << ","
+                << QString::number(g->getValue("nd"), 'f', 6) << "," << QString::number(g->getValue("vd"), 'f', 2) << ","
+                << QString::number(d, 'e', 2) << "\n";
+        }
+    }
+}
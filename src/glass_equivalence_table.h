@@ -0,0 +1,100 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_EQUIVALENCE_TABLE_H
+#define GLASS_EQUIVALENCE_TABLE_H
+
+#include <memory>
+#include <QVector>
+#include <QHash>
+
+#include "dispersion_curve_table.h"
+
+class QTextStream;
+
+/**
+ * @brief Clusters of near-identical glasses across all loaded catalogs
+ * @details
+ * Dispersion curves are sampled over the visible band, and two glasses are linked if the RMS
+ * index deviation of their curves is within the threshold.  The clusters are the connected
+ * components of the links.
+ *
+ * The mean index over the samples differs by no more than the RMS deviation, so the rows are
+ * sorted by the mean index and each row is compared only with the rows within the threshold.
+ * The link graph is built in parallel over chunks of the sorted rows.
+ */
+class GlassEquivalenceTable
+{
+public:
+    struct Equivalent{
+        int    row;      // row of the curve table
+        double distance; // RMS index deviation
+    };
+
+    /** @param threshold maximum RMS index deviation of linked glasses */
+    GlassEquivalenceTable(CatalogSnapshotPtr snapshot, double threshold = kDefaultThreshold);
+
+    /** shared table of the snapshot, rebuilt when the snapshot or the temperature changes */
+    static std::shared_ptr<const GlassEquivalenceTable> instance(const CatalogSnapshotPtr& snapshot);
+
+    static constexpr double kDefaultThreshold = 1.0e-3;
+
+    bool isCurrent(const CatalogSnapshotPtr& snapshot) const;
+
+    const DispersionCurveTable& curves() const{ return curves_; }
+    double threshold() const{ return threshold_; }
+
+    /** @return -1 if the glass is not in the table */
+    int rowOf(GlassHandle handle) const{ return handle_rows_.value(handle, -1); }
+
+    /** @return -1 if the glass has no equivalent */
+    int clusterOf(int row) const{ return cluster_of_[row]; }
+
+    int clusterCount() const{ return clusters_.size(); }
+
+    /** rows of the cluster in the catalog order */
+    const QVector<int>& cluster(int n) const{ return clusters_[n]; }
+
+    /** other glasses of the cluster, in ascending order of the deviation from the glass */
+    QVector<Equivalent> equivalents(int row) const;
+
+    /** number of linked pairs */
+    int linkCount() const{ return link_count_; }
+
+    /**
+     * @brief Write the clusters as CSV
+     * @details One line per glass with the cluster number and the deviation from the first glass of the cluster
+     */
+    void writeCsv(QTextStream& out) const;
+
+private:
+    DispersionCurveTable    curves_;
+    double                  threshold_;
+    QHash<GlassHandle, int> handle_rows_;
+    QVector<int>            cluster_of_;
+    QVector< QVector<int> > clusters_;
+    int                     link_count_;
+};
+
+#endif // GLASS_EQUIVALENCE_TABLE_H
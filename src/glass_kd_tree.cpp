@@ -0,0 +1,177 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_kd_tree.h"
+
+#include <algorithm>
+#include <numeric>
+#include <QtMath>
+#include <QtConcurrent>
+
+#include "top_k_collector.h"
+
+namespace {
+
+// ranges not larger than this are scanned linearly
+const int kLeafSize = 8;
+
+bool lessDistance(const GlassKdTree::Neighbor& a, const GlassKdTree::Neighbor& b)
+{
+    return (a.distance < b.distance) || (a.distance == b.distance && a.row < b.row);
+}
+
+typedef TopKCollector<GlassKdTree::Neighbor, decltype(&lessDistance)> NeighborCollector;
+
+} // namespace
+
+
+GlassKdTree::GlassKdTree()
+    : dim_(0)
+{
+}
+
+GlassKdTree::GlassKdTree(const QVector<double> &coordinates, int dimension, const QBitArray *mask)
+    : dim_(dimension)
+{
+    if(dim_ <= 0){
+        return;
+    }
+
+    const int rowCount = coordinates.size()/dim_;
+    for(int r = 0; r < rowCount; r++){
+        if(mask && !mask->testBit(r)){
+            continue;
+        }
+        bool valid = true;
+        for(int d = 0; d < dim_; d++){
+            valid = valid && qIsFinite(coordinates[r*dim_ + d]);
+        }
+        if(valid){
+            rows_.append(r);
+        }
+    }
+
+    points_.resize(rows_.size()*dim_);
+    for(int i = 0; i < rows_.size(); i++){
+        std::copy(coordinates.constData() + rows_[i]*dim_, coordinates.constData() + (rows_[i] + 1)*dim_, points_.data() + i*dim_);
+    }
+
+    build(0, rows_.size(), 0);
+}
+
+void GlassKdTree::build(int begin, int end, int depth)
+{
+    if(end - begin <= kLeafSize){
+        return;
+    }
+
+    const int axis = depth % dim_;
+    const int mid  = (begin + end)/2;
+
+    // order the points of the range by the axis around the median
+    QVector<int> order(end - begin);
+    std::iota(order.begin(), order.end(), begin);
+    std::nth_element(order.begin(), order.begin() + (mid - begin), order.end(), [this, axis](int a, int b){
+        return points_[a*dim_ + axis] < points_[b*dim_ + axis];
+    });
+
+    QVector<int>    rows(end - begin);
+    QVector<double> points((end - begin)*dim_);
+    for(int i = 0; i < order.size(); i++){
+        rows[i] = rows_[order[i]];
+        std::copy(points_.constData() + order[i]*dim_, points_.constData() + (order[i] + 1)*dim_, points.data() + i*dim_);
+    }
+    std::copy(rows.begin(), rows.end(), rows_.begin() + begin);
+    std::copy(points.begin(), points.end(), points_.begin() + begin*dim_);
+
+    build(begin, mid, depth + 1);
+    build(mid + 1, end, depth + 1);
+}
+
+template<class C>
+void GlassKdTree::search(int begin, int end, int depth, const double *q, C &collector) const
+{
+    // squared distance is collected, the root is taken at the end
+    auto visit = [&](int i){
+        const double* p = points_.constData() + i*dim_;
+        double d2 = 0.0;
+        for(int d = 0; d < dim_; d++){
+            const double diff = p[d] - q[d];
+            d2 += diff*diff;
+        }
+        collector.push(Neighbor{rows_[i], d2});
+    };
+
+    if(end - begin <= kLeafSize){
+        for(int i = begin; i < end; i++){
+            visit(i);
+        }
+        return;
+    }
+
+    const int axis = depth % dim_;
+    const int mid  = (begin + end)/2;
+    visit(mid);
+
+    const double diff = q[axis] - points_[mid*dim_ + axis];
+    if(diff < 0.0){
+        search(begin, mid, depth + 1, q, collector);
+        if(!collector.isFull() || diff*diff < collector.worst().distance){
+            search(mid + 1, end, depth + 1, q, collector);
+        }
+    }else{
+        search(mid + 1, end, depth + 1, q, collector);
+        if(!collector.isFull() || diff*diff < collector.worst().distance){
+            search(begin, mid, depth + 1, q, collector);
+        }
+    }
+}
+
+QVector<GlassKdTree::Neighbor> GlassKdTree::nearest(const double *point, int k) const
+{
+    NeighborCollector collector(k, lessDistance);
+    if(k > 0 && !rows_.isEmpty()){
+        search(0, rows_.size(), 0, point, collector);
+    }
+
+    QVector<Neighbor> neighbors = collector.sorted();
+    for(auto &n : neighbors){
+        n.distance = sqrt(n.distance);
+    }
+    return neighbors;
+}
+
+QVector< QVector<GlassKdTree::Neighbor> > GlassKdTree::nearest(const QVector<double> &points, int k) const
+{
+    const int pointCount = (dim_ > 0) ? points.size()/dim_ : 0;
+    QVector< QVector<Neighbor> > results(pointCount);
+
+    QVector<int> tasks(pointCount);
+    std::iota(tasks.begin(), tasks.end(), 0);
+    QtConcurrent::blockingMap(tasks, [&](int i){
+        results[i] = nearest(points.constData() + i*dim_, k);
+    });
+
+    return results;
+}
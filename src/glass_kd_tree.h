@@ -0,0 +1,77 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_KD_TREE_H
+#define GLASS_KD_TREE_H
+
+#include <QVector>
+#include <QBitArray>
+
+/**
+ * @brief k-d tree over glass coordinates for nearest neighbor queries
+ * @details
+ * The tree is implicit: the points are reordered so that the median of each range is the node
+ * and the split axis cycles with the depth.  Coordinates are expected to be scaled already,
+ * so that the Euclidean distance is the wanted metric.
+ */
+class GlassKdTree
+{
+public:
+    struct Neighbor{
+        int    row;
+        double distance;
+    };
+
+    GlassKdTree();
+
+    /**
+     * @param coordinates rowCount x dimension, row-major.  Rows with NaN are excluded.
+     * @param mask if given, only the rows whose bit is set are included
+     */
+    GlassKdTree(const QVector<double>& coordinates, int dimension, const QBitArray* mask = nullptr);
+
+    int dimension() const{ return dim_; }
+    int size() const{ return rows_.size(); }
+
+    /** k nearest rows to the point, in ascending order of distance */
+    QVector<Neighbor> nearest(const double* point, int k) const;
+
+    /**
+     * @brief Batch query in parallel
+     * @param points pointCount x dimension, row-major
+     */
+    QVector< QVector<Neighbor> > nearest(const QVector<double>& points, int k) const;
+
+private:
+    void build(int begin, int end, int depth);
+
+    template<class C>
+    void search(int begin, int end, int depth, const double* q, C& collector) const;
+
+    int             dim_;
+    QVector<int>    rows_;   // in tree order
+    QVector<double> points_; // in tree order, row-major
+};
+
+#endif // GLASS_KD_TREE_H
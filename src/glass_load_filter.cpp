@@ -0,0 +1,71 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_load_filter.h"
+
+GlassLoadFilter::GlassLoadFilter()
+{
+    suppliers.clear();
+    statuses.clear();
+    rejectUnknownFormula = false;
+    requiredLambdaMin    = NAN;
+    requiredLambdaMax    = NAN;
+}
+
+bool GlassLoadFilter::isEnabled() const
+{
+    return ( !suppliers.isEmpty() || !statuses.isEmpty() || rejectUnknownFormula || !qIsNaN(requiredLambdaMin) || !qIsNaN(requiredLambdaMax) );
+}
+
+bool GlassLoadFilter::acceptsSupplier(const QString& supplier) const
+{
+    if(suppliers.isEmpty()){
+        return true;
+    }
+    return suppliers.contains(supplier, Qt::CaseInsensitive);
+}
+
+bool GlassLoadFilter::acceptsStatus(const QString& status) const
+{
+    if(statuses.isEmpty()){
+        return true;
+    }
+    return statuses.contains( status.isEmpty() ? QString("-") : status );
+}
+
+bool GlassLoadFilter::acceptsFormula(const QString& formulaName) const
+{
+    return !( rejectUnknownFormula && ("Unknown" == formulaName) );
+}
+
+bool GlassLoadFilter::acceptsWavelengthRange(double lambdamin, double lambdamax) const
+{
+    if( !qIsNaN(requiredLambdaMin) && !(lambdamin <= requiredLambdaMin) ){
+        return false;
+    }
+    if( !qIsNaN(requiredLambdaMax) && !(lambdamax >= requiredLambdaMax) ){
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_LOAD_FILTER_H
+#define GLASS_LOAD_FILTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QtMath>
+
+/**
+ * @brief Conditions to select glasses while loading catalog files
+ * @details Glasses rejected by the filter are never stored in the catalog.
+ */
+class GlassLoadFilter
+{
+public:
+    GlassLoadFilter();
+
+    /** Check if any condition is set */
+    bool isEnabled() const;
+
+    bool acceptsSupplier(const QString& supplier) const;
+
+    /** Glasses without status information, e.g. in Xml catalogs, are treated as "-" */
+    bool acceptsStatus(const QString& status) const;
+
+    bool acceptsFormula(const QString& formulaName) const;
+
+    /** Check if the glass data covers the required wavelength range (micron) */
+    bool acceptsWavelengthRange(double lambdamin, double lambdamax) const;
+
+    /** accepted suppliers, empty for all */
+    QStringList suppliers;
+
+    /** accepted status names, empty for all */
+    QStringList statuses;
+
+    /** reject glasses with unknown dispersion formula */
+    bool rejectUnknownFormula;
+
+    /** wavelength range which glass data must cover, NaN for no limit */
+    double requiredLambdaMin;
+    double requiredLambdaMax;
+};
+
+#endif // GLASS_LOAD_FILTER_H
@@ -0,0 +1,249 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_name_index.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <QMutex>
+#include <QRegularExpression>
+
+#include "glass.h"
+#include "glass_catalog.h"
+
+namespace {
+
+quint32 trigram(const char* p)
+{
+    return (static_cast<quint32>(static_cast<uchar>(p[0])) << 16) |
+           (static_cast<quint32>(static_cast<uchar>(p[1])) << 8)  |
+            static_cast<quint32>(static_cast<uchar>(p[2]));
+}
+
+/** edits allowed for the query length */
+int allowedEdits(int length)
+{
+    if(length <= 3) return 0;
+    if(length <= 5) return 1;
+    if(length <= 9) return 2;
+    return 3;
+}
+
+/**
+ * Minimum edit distance between the query and any substring of the name, or limit + 1 if it exceeds the limit.
+ * The first row is zero so that the match may start anywhere in the name.
+ */
+int substringEditDistance(const QByteArray& query, const QByteArray& name, int limit)
+{
+    const int m = query.size();
+    const int n = name.size();
+    std::vector<int> prev(n + 1, 0), curr(n + 1);
+
+    for(int i = 1; i <= m; i++){
+        curr[0] = i;
+        int rowMin = curr[0];
+        for(int j = 1; j <= n; j++){
+            const int cost = (query[i-1] == name[j-1]) ? 0 : 1;
+            curr[j] = qMin(qMin(prev[j] + 1, curr[j-1] + 1), prev[j-1] + cost);
+            rowMin = qMin(rowMin, curr[j]);
+        }
+        if(rowMin > limit){
+            return limit + 1;
+        }
+        std::swap(prev, curr);
+    }
+
+    return *std::min_element(prev.begin(), prev.end());
+}
+
+} // namespace
+
+GlassNameIndex::GlassNameIndex(CatalogSnapshotPtr snapshot)
+    : snapshot_(snapshot)
+{
+    for(auto &cat : snapshot_->catalogs()){
+        int supplierIndex = supplier_names_.indexOf(cat->supplier());
+        if(supplierIndex < 0){
+            supplierIndex = supplier_names_.size();
+            supplier_names_.append(cat->supplier());
+            normalized_suppliers_.append(normalize(cat->supplier()));
+        }
+
+        for(int i = 0; i < cat->glassCount(); i++){
+            const Glass* g = cat->glass(i);
+            handles_.append(g->handle());
+            product_names_.append(g->productName());
+            names_.append(normalize(g->productName()));
+            suppliers_.append(supplierIndex);
+        }
+    }
+
+    for(int e = 0; e < names_.size(); e++){
+        const QByteArray& name = names_[e];
+        for(int i = 0; i + 3 <= name.size(); i++){
+            QVector<int>& entries = postings_[trigram(name.constData() + i)];
+            if(entries.isEmpty() || entries.last() != e){ // a trigram repeated in the name is counted once
+                entries.append(e);
+            }
+        }
+    }
+}
+
+std::shared_ptr<const GlassNameIndex> GlassNameIndex::instance(const CatalogSnapshotPtr &snapshot)
+{
+    static QMutex mutex;
+    static std::shared_ptr<const GlassNameIndex> cached;
+
+    QMutexLocker locker(&mutex);
+    if(!cached || !cached->isCurrent(snapshot)){
+        cached = std::make_shared<const GlassNameIndex>(snapshot);
+    }
+    return cached;
+}
+
+QByteArray GlassNameIndex::normalize(const QString &name)
+{
+    QByteArray normalized;
+    normalized.reserve(name.size());
+    for(const QChar& c : name){
+        if(c.isLetterOrNumber() && c.unicode() < 128){
+            normalized.append(c.toUpper().toLatin1());
+        }
+    }
+    return normalized;
+}
+
+QVector<GlassNameIndex::Match> GlassNameIndex::search(const QString &text, const QString &supplier, int maxCount) const
+{
+    // supplier words
+    QVector<bool> allowedSuppliers(supplier_names_.size(), supplier.isEmpty());
+    if(!supplier.isEmpty()){
+        int s = supplier_names_.indexOf(supplier);
+        if(s >= 0) allowedSuppliers[s] = true;
+    }
+
+    QStringList words = text.split(QRegularExpression("\\s+"));
+    words.removeAll("");
+    QByteArray query;
+    QVector<bool> wordSuppliers(supplier_names_.size(), false);
+    bool hasSupplierWord = false;
+    for(auto &word : words){
+        const QByteArray w = normalize(word);
+        bool isSupplier = false;
+        for(int s = 0; words.size() > 1 && w.size() >= 2 && s < normalized_suppliers_.size(); s++){
+            if(normalized_suppliers_[s].startsWith(w)){
+                wordSuppliers[s] = true;
+                isSupplier = true;
+            }
+        }
+        if(isSupplier){
+            hasSupplierWord = true;
+        }else{
+            query += w;
+        }
+    }
+    if(hasSupplierWord){
+        for(int s = 0; s < allowedSuppliers.size(); s++){
+            allowedSuppliers[s] = allowedSuppliers[s] && wordSuppliers[s];
+        }
+    }
+
+    QVector<Match> matches;
+    const int entryCount = names_.size();
+
+    if(query.isEmpty()){
+        for(int e = 0; e < entryCount; e++){
+            if(allowedSuppliers[suppliers_[e]]){
+                matches.append(Match{e, Exact, 0});
+            }
+        }
+    }
+    else{
+        const int m = query.size();
+        const int k = allowedEdits(m);
+        QVector<quint32> grams;
+        for(int i = 0; i + 3 <= m; i++){
+            const quint32 g = trigram(query.constData() + i);
+            if(!grams.contains(g)){
+                grams.append(g);
+            }
+        }
+
+        // Each edit breaks at most 3 trigrams, so a match within k edits shares this many distinct trigrams.
+        const int required = grams.size() - 3*k;
+
+        // candidates from the trigram postings, or all entries if the count gives no bound
+        QVector<int> candidates;
+        if(required > 0){
+            QVector<quint16> counts(entryCount, 0);
+            for(quint32 g : grams){
+                auto it = postings_.constFind(g);
+                if(it == postings_.constEnd()){
+                    continue;
+                }
+                for(int e : it.value()){
+                    if(++counts[e] == required){
+                        candidates.append(e);
+                    }
+                }
+            }
+        }else{
+            candidates.resize(entryCount);
+            std::iota(candidates.begin(), candidates.end(), 0);
+        }
+
+        for(int e : candidates){
+            if(!allowedSuppliers[suppliers_[e]]){
+                continue;
+            }
+            const QByteArray& name = names_[e];
+            if(name == query){
+                matches.append(Match{e, Exact, 0});
+            }else if(name.startsWith(query)){
+                matches.append(Match{e, Prefix, 0});
+            }else if(name.contains(query)){
+                matches.append(Match{e, Substring, 0});
+            }else if(k > 0){
+                const int edits = substringEditDistance(query, name, k);
+                if(edits <= k){
+                    matches.append(Match{e, Fuzzy, edits});
+                }
+            }
+        }
+
+        // rank, then shorter names and the catalog order
+        std::sort(matches.begin(), matches.end(), [this](const Match& a, const Match& b){
+            if(a.kind  != b.kind)  return a.kind < b.kind;
+            if(a.edits != b.edits) return a.edits < b.edits;
+            if(names_[a.entry].size() != names_[b.entry].size()) return names_[a.entry].size() < names_[b.entry].size();
+            return a.entry < b.entry;
+        });
+    }
+
+    if(maxCount > 0 && matches.size() > maxCount){
+        matches.resize(maxCount);
+    }
+    return matches;
+}
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_NAME_INDEX_H
+#define GLASS_NAME_INDEX_H
+
+#include <memory>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include <QStringList>
+
+#include "catalog_snapshot.h"
+
+/**
+ * @brief Name index of all glasses in a snapshot for search-as-you-type
+ * @details
+ * Names are normalized to upper case letters and digits, so that "n-bk 7" finds N-BK7.
+ * Matches are ranked as exact, prefix, substring and fuzzy.  A fuzzy match is a substring of
+ * the name within a few edits of the query.
+ *
+ * A substring within k edits of the query shares all but 3k of the distinct trigrams of the query,
+ * so only the glasses which reach this count in the trigram postings are verified by the edit distance.  The whole index is scanned only for very short queries.
+ *
+ * Query words which are prefixes of a supplier name restrict the suppliers, e.g. "bk7 sch".
+ */
+class GlassNameIndex
+{
+public:
+    enum Kind{
+        Exact,
+        Prefix,
+        Substring,
+        Fuzzy
+    };
+
+    struct Match{
+        int  entry;
+        Kind kind;
+        int  edits; // 0 unless fuzzy
+    };
+
+    explicit GlassNameIndex(CatalogSnapshotPtr snapshot);
+
+    /** shared index of the snapshot, rebuilt when the snapshot changes */
+    static std::shared_ptr<const GlassNameIndex> instance(const CatalogSnapshotPtr& snapshot);
+
+    /** upper case letters and digits only */
+    static QByteArray normalize(const QString& name);
+
+    bool isCurrent(const CatalogSnapshotPtr& snapshot) const{ return snapshot_ == snapshot; }
+
+    /** entries follow the catalog order of the snapshot */
+    int size() const{ return handles_.size(); }
+    GlassHandle handle(int entry) const{ return handles_[entry]; }
+    const QString& productName(int entry) const{ return product_names_[entry]; }
+    const QString& supplier(int entry) const{ return supplier_names_[suppliers_[entry]]; }
+
+    /**
+     * @param text query.  Empty text matches all glasses.
+     * @param supplier if not empty, only the glasses of the supplier are searched
+     * @param maxCount if positive, at most maxCount matches are returned
+     * @return matches in ranked order
+     */
+    QVector<Match> search(const QString& text, const QString& supplier = QString(), int maxCount = -1) const;
+
+private:
+    CatalogSnapshotPtr          snapshot_;
+    QVector<GlassHandle>        handles_;
+    QVector<QString>            product_names_;
+    QVector<QByteArray>         names_;     // normalized
+    QVector<int>                suppliers_; // index of supplier_names_
+    QStringList                 supplier_names_;
+    QVector<QByteArray>         normalized_suppliers_;
+    QHash<quint32, QVector<int>> postings_; // trigram -> entries in ascending order
+};
+
+#endif // GLASS_NAME_INDEX_H
@@ -0,0 +1,87 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_property_table.h"
+
+#include <QtConcurrent>
+
+#include "user_property_registry.h"
+#include "normal_line.h"
+
+GlassPropertyTable::GlassPropertyTable()
+    : temperature_(qQNaN()),
+      user_revision_(-1),
+      normal_line_revision_(-1)
+{
+}
+
+GlassPropertyTable::GlassPropertyTable(CatalogSnapshotPtr snapshot, const QStringList &properties)
+    : snapshot_(snapshot),
+      temperature_(Glass::currentTemperature()),
+      user_revision_(UserPropertyRegistry::revision()),
+      normal_line_revision_(NormalLine::revision()),
+      properties_(properties)
+{
+    for(auto &cat : snapshot_->catalogs()){
+        row_offsets_.append(rows_.size());
+        int glassCount = cat->glassCount();
+        for(int i = 0; i < glassCount; i++){
+            rows_.append(cat->glass(i));
+        }
+    }
+
+    columns_.resize(properties_.size());
+
+    QVector<int> tasks(properties_.size());
+    for(int i = 0; i < tasks.size(); i++){
+        tasks[i] = i;
+    }
+
+    // user defined properties are evaluated in parallel by themselves
+    QVector<int> builtinTasks;
+    for(int col : tasks){
+        std::shared_ptr<const PropertyExpression> expression = UserPropertyRegistry::find(properties_[col]);
+        if(expression){
+            columns_[col] = expression->evaluate(rows_);
+        }
+        else{
+            builtinTasks.append(col);
+        }
+    }
+
+    QtConcurrent::blockingMap(builtinTasks, [this](int col){
+        const QString& name = properties_[col];
+        QVector<double>& v = columns_[col];
+        v.resize(rows_.size());
+        for(int r = 0; r < rows_.size(); r++){
+            v[r] = rows_[r]->getValue(name);
+        }
+    });
+}
+
+bool GlassPropertyTable::isCurrent(const CatalogSnapshotPtr &snapshot) const
+{
+    return (snapshot_ == snapshot) && (temperature_ == Glass::currentTemperature()) && (user_revision_ == UserPropertyRegistry::revision())
+            && (normal_line_revision_ == NormalLine::revision());
+}
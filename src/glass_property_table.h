@@ -0,0 +1,86 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_PROPERTY_TABLE_H
+#define GLASS_PROPERTY_TABLE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "catalog_snapshot.h"
+
+/**
+ * @brief Numeric glass properties of all catalogs in a snapshot, stored column by column
+ * @details
+ * Values are computed once by Glass::getValue at the current temperature and kept in contiguous arrays,
+ * so that analyses can scan them without string dispatch.  The snapshot is held by the table,
+ * therefore the glass pointers stay valid for its lifetime.
+ */
+class GlassPropertyTable
+{
+public:
+    GlassPropertyTable();
+
+    /** compute the given properties for all glasses in the snapshot.  Columns are computed in parallel. */
+    GlassPropertyTable(CatalogSnapshotPtr snapshot, const QStringList& properties);
+
+    bool isEmpty() const{ return rows_.isEmpty(); }
+
+    /** true if the table was built from the snapshot at the current temperature with the current user defined properties and normal line */
+    bool isCurrent(const CatalogSnapshotPtr& snapshot) const;
+
+    CatalogSnapshotPtr snapshot() const{ return snapshot_; }
+    double temperature() const{ return temperature_; }
+
+    int rowCount() const{ return rows_.size(); }
+    int columnCount() const{ return properties_.size(); }
+
+    const Glass* glass(int row) const{ return rows_[row]; }
+
+    /** row of the first glass of the catalog. Rows follow the catalog order of the snapshot. */
+    int rowOffset(int catalogIndex) const{ return row_offsets_[catalogIndex]; }
+
+    QStringList properties() const{ return properties_; }
+
+    /** @return column index, or -1 if the property is not in the table */
+    int columnIndex(const QString& property) const{ return properties_.indexOf(property); }
+
+    /** contiguous values of the column. NaN if not available. */
+    const double* column(int col) const{ return columns_[col].constData(); }
+
+    double value(int row, int col) const{ return columns_[col][row]; }
+
+private:
+    CatalogSnapshotPtr          snapshot_;
+    double                      temperature_;
+    int                         user_revision_;
+    int                         normal_line_revision_;
+    QStringList                 properties_;
+    QVector<const Glass*>       rows_;
+    QVector<int>                row_offsets_;
+    QVector< QVector<double> >  columns_;
+};
+
+#endif // GLASS_PROPERTY_TABLE_H
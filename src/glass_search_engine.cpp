@@ -0,0 +1,101 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_search_engine.h"
+
+#include <algorithm>
+#include <QtConcurrent>
+
+#include "top_k_collector.h"
+
+namespace {
+
+// rows scored by one task
+const int kChunkSize = 2048;
+
+bool lessError(const GlassSearchEngine::Result& a, const GlassSearchEngine::Result& b)
+{
+    return (a.error < b.error) || (a.error == b.error && a.row < b.row);
+}
+
+typedef TopKCollector<GlassSearchEngine::Result, decltype(&lessError)> ResultCollector;
+
+} // namespace
+
+
+QVector<GlassSearchEngine::Result> GlassSearchEngine::search(const GlassPropertyTable &table, const QVector<Term> &terms, int k, const QBitArray* mask)
+{
+    return selectTopK(table.rowCount(), k, [&](int begin, int end, double* e){
+        const int n = end - begin;
+        std::fill(e, e + n, 0.0);
+
+        // accumulate term by term over contiguous columns so that the inner loop can be vectorized
+        for(const Term& t : terms){
+            const double* p = table.column(t.column) + begin;
+            const double target = t.target;
+            const double weight = t.weight;
+            for(int i = 0; i < n; i++){
+                const double d = p[i] - target;
+                e[i] += weight*d*d;
+            }
+        }
+    }, mask);
+}
+
+QVector<GlassSearchEngine::Result> GlassSearchEngine::selectTopK(int rowCount, int k, const std::function<void (int, int, double *)> &scoreChunk, const QBitArray *mask)
+{
+    if(k <= 0 || rowCount <= 0){
+        return QVector<Result>();
+    }
+
+    QVector<int> chunks;
+    for(int begin = 0; begin < rowCount; begin += kChunkSize){
+        chunks.append(begin);
+    }
+
+    QVector<ResultCollector> collectors(chunks.size(), ResultCollector(k, lessError));
+
+    QtConcurrent::blockingMap(chunks, [&](int begin){
+        const int end = qMin(begin + kChunkSize, rowCount);
+        const int n = end - begin;
+
+        QVector<double> err(n);
+        double* e = err.data();
+        scoreChunk(begin, end, e);
+
+        ResultCollector& collector = collectors[begin/kChunkSize];
+        for(int i = 0; i < n; i++){
+            if(!qIsNaN(e[i]) && (!mask || mask->testBit(begin + i))){
+                collector.push(Result{begin + i, e[i]});
+            }
+        }
+    });
+
+    ResultCollector merged(k, lessError);
+    for(auto &collector : collectors){
+        merged.merge(collector);
+    }
+
+    return merged.sorted();
+}
@@ -0,0 +1,68 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SEARCH_ENGINE_H
+#define GLASS_SEARCH_ENGINE_H
+
+#include <functional>
+#include <QVector>
+#include <QBitArray>
+
+#include "glass_property_table.h"
+
+/**
+ * @brief Weighted least squares search over a GlassPropertyTable
+ * @details
+ * Error function is sum of weight*(value - target)^2.  Rows are scored in parallel chunks,
+ * each chunk keeps its best K in a bounded heap, and the chunk results are merged at the end.
+ */
+class GlassSearchEngine
+{
+public:
+    struct Term{
+        int    column; // column of the property table
+        double target;
+        double weight;
+    };
+
+    struct Result{
+        int    row;
+        double error;
+    };
+
+    /**
+     * @param mask if given, only the rows whose bit is set are searched
+     * @return at most k results in ascending order of error. Glasses lacking a value are excluded.
+     */
+    static QVector<Result> search(const GlassPropertyTable& table, const QVector<Term>& terms, int k, const QBitArray* mask = nullptr);
+
+    /**
+     * @brief Select the best k rows of an arbitrary error function
+     * @param scoreChunk called in parallel as scoreChunk(begin, end, errors) to fill errors[0, end - begin).  NaN is excluded.
+     * @return at most k results in ascending order of error
+     */
+    static QVector<Result> selectTopK(int rowCount, int k, const std::function<void(int, int, double*)>& scoreChunk, const QBitArray* mask = nullptr);
+};
+
+#endif // GLASS_SEARCH_ENGINE_H
@@ -29,12 +29,15 @@
 #include <QDebug>
 
 #include "glass_catalog_manager.h"
+#include "user_property_registry.h"
 
 GlassSearchForm::GlassSearchForm(QMdiArea *parent) :
     QWidget(parent),
     ui(new Ui::GlassSearchForm),
     m_parentMdiArea(parent)
 {
+    m_parameterNames = QStringList({"nd", "ne", "vd", "ve", "PgF", "PCt_"}) + UserPropertyRegistry::names();
+
     ui->setupUi(this);
     this->setWindowTitle("Glass Search");
 
@@ -54,6 +57,8 @@ GlassSearchForm::GlassSearchForm(QMdiArea *parent) :
     QObject::connect(ui->pushButton_Remove, SIGNAL(clicked()), this, SLOT(removeParameter()));
 
     QObject::connect(ui->pushButton_Search, SIGNAL(clicked()), this, SLOT(showSearchResult()));
+    QObject::connect(ui->lineEdit_OutputCount, SIGNAL(textChanged(QString)), this, SLOT(updateSearchResult()));
+    QObject::connect(ui->lineEdit_Constraint,  SIGNAL(textChanged(QString)), this, SLOT(updateSearchResult()));
 }
 
 GlassSearchForm::~GlassSearchForm()
@@ -82,66 +87,63 @@ void GlassSearchForm::removeParameter()
     if(ui->tableWidget_Parameters->rowCount() > 1) {
         int currentRow = ui->tableWidget_Parameters->currentRow();
         ui->tableWidget_Parameters->removeRow(currentRow);
+        updateSearchResult();
     }
 }
 
 void GlassSearchForm::showSearchResult()
 {
-    // search glass
-    int resultCount = ui->lineEdit_OutputCount->text().toInt();
-    QList<Glass*> results;
-    QList<Glass*> allGlasses;
-
-    for(auto &cat : GlassCatalogManager::catalogList()) {
-        int glassCount = cat->glassCount();
-        for(int gi = 0; gi < glassCount; gi++) {
-            allGlasses.append(cat->glass(gi));
-        }
+    QStringList paramNames;
+    QVector<GlassSearchEngine::Term> terms = getSearchTerms(paramNames);
+
+    // property values are computed once per snapshot and temperature
+    m_constraintIndex = GlassConstraintIndex::instance(GlassCatalogManager::snapshot());
+    const GlassPropertyTable& table = m_constraintIndex->table();
+    for(int i = 0; i < terms.size(); i++){
+        terms[i].column = table.columnIndex(paramNames[i]);
     }
 
-    for(auto &g : allGlasses) {
-
-        double e = getErrorValue(g);
-
-        if(results.empty()) {
-            results.append(g);
-        }else {
-            for(int i = 0; i < results.size(); i++) {
-                if(e < getErrorValue(results[i])) {
-                    results.insert(i,g);
-                    if(results.size() > resultCount) {
-                        results.pop_back();
-                    }
-                    break;
-                }
-            }
-        }
-
+    // hard conditions
+    QString errorMessage;
+    GlassConstraintQuery query = GlassConstraintQuery::parse(ui->lineEdit_Constraint->text(), &errorMessage);
+    QBitArray mask = m_constraintIndex->select(query, &errorMessage);
+    ui->lineEdit_Constraint->setToolTip(errorMessage);
+    ui->lineEdit_Constraint->setStyleSheet(errorMessage.isEmpty() ? "" : "color: red");
+
+    // an invalid condition gives no result, rather than the unconstrained one
+    QVector<GlassSearchEngine::Result> results;
+    if(errorMessage.isEmpty()){
+        int resultCount = ui->lineEdit_OutputCount->text().toInt();
+        results = GlassSearchEngine::search(table, terms, resultCount, &mask);
     }
 
     //setup result table
     QStringList hHeaderLabels({"Glass", "Catalog"});
-    for(int i = 0; i < ui->tableWidget_Parameters->rowCount(); i++) {
-        QComboBox* combo = dynamic_cast<QComboBox*>(ui->tableWidget_Parameters->cellWidget(i,0));
-        hHeaderLabels.append(combo->currentText());
-    }
+    hHeaderLabels.append(paramNames);
     ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
     ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
-    ui->tableWidget_Result->setRowCount(resultCount);
-    for(int i = 0; i < resultCount; i++) {
-        Glass* g = results[i];
+    ui->tableWidget_Result->setRowCount(results.size());
+    for(int i = 0; i < results.size(); i++) {
+        int row = results[i].row;
+        const Glass* g = table.glass(row);
         setCellValue(ui->tableWidget_Result, i, 0, g->productName());
         setCellValue(ui->tableWidget_Result, i, 1, g->supplier());
 
-        for(int j = 0; j < ui->tableWidget_Parameters->rowCount(); j++) {
-            QString param = dynamic_cast<QComboBox*>(ui->tableWidget_Parameters->cellWidget(j, 0))->currentText();
-            setCellValue(ui->tableWidget_Result, i, j+2, numToQString(g->getValue(param)));
+        for(int j = 0; j < terms.size(); j++) {
+            setCellValue(ui->tableWidget_Result, i, j+2, numToQString(table.value(row, terms[j].column)));
         }
-
     }
 
 }
 
+void GlassSearchForm::updateSearchResult()
+{
+    // follow the parameter edits once a search has been done
+    if(ui->tableWidget_Result->columnCount() > 0){
+        showSearchResult();
+    }
+}
+
 
 void GlassSearchForm::validateCellInput(int row, int col)
 {
@@ -161,8 +163,10 @@ void GlassSearchForm::validateCellInput(int row, int col)
         qDebug() << "Invalid input: " << val;
         QMessageBox::warning(this,tr("Error"), tr("Invalid Input"));
         item->setText("1.0");
+        return;
     }
 
+    updateSearchResult();
 }
 
 void GlassSearchForm::setCellValue(QTableWidget* table, int row, int col, QString str)
@@ -177,32 +181,39 @@ void GlassSearchForm::setCellValue(QTableWidget* table, int row, int col, QStrin
 }
 
 
-double GlassSearchForm::getErrorValue(const Glass* g)
+QVector<GlassSearchEngine::Term> GlassSearchForm::getSearchTerms(QStringList& paramNames)
 {
-    double e = 0.0;
+    QVector<GlassSearchEngine::Term> terms;
+    paramNames.clear();
 
     int parameterCount = ui->tableWidget_Parameters->rowCount();
 
     for(int i = 0; i < parameterCount; i++) {
+        QTableWidgetItem* targetItem = ui->tableWidget_Parameters->item(i, 1);
+        QTableWidgetItem* weightItem = ui->tableWidget_Parameters->item(i, 2);
+        QComboBox* combo = dynamic_cast<QComboBox*>(ui->tableWidget_Parameters->cellWidget(i,0));
+        if(!targetItem || !weightItem || !combo){
+            continue;
+        }
 
-        double pt = ui->tableWidget_Parameters->item(i, 1)->text().toDouble();
-        double w = ui->tableWidget_Parameters->item(i, 2)->text().toDouble();
-
-        QString paramName = dynamic_cast<QComboBox*>(ui->tableWidget_Parameters->cellWidget(i,0))->currentText();
-        double p = g->getValue(paramName);
-
-        e += w*pow(p-pt,2);
+        GlassSearchEngine::Term t;
+        t.column = -1; // resolved against the property table
+        t.target = targetItem->text().toDouble();
+        t.weight = weightItem->text().toDouble();
+        terms.append(t);
+        paramNames.append(combo->currentText());
     }
 
-    return e;
+    return terms;
 }
 
 QComboBox* GlassSearchForm::createParameterCombo()
 {
-    QStringList items({"nd", "ne", "vd", "ve", "PgF", "PCt_"});
     QComboBox *combo = new QComboBox();
-    combo->addItems(items);
+    combo->addItems(m_parameterNames);
     combo->setCurrentIndex(0);
 
+    QObject::connect(combo, SIGNAL(currentIndexChanged(int)), this, SLOT(updateSearchResult()));
+
     return combo;
 }
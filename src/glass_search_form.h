@@ -32,6 +32,8 @@
 #include <QComboBox>
 
 #include "glass.h"
+#include "glass_constraint_index.h"
+#include "glass_search_engine.h"
 
 namespace Ui {
 class GlassSearchForm;
@@ -50,6 +52,9 @@ private slots:
     /** Execute search and show result */
     void showSearchResult();
 
+    /** Re-run the search after the parameters are edited */
+    void updateSearchResult();
+
     /** Add new line to search parameter table */
     void addParameter();
 
@@ -60,8 +65,8 @@ private slots:
     void validateCellInput(int row, int col);
 
 private:
-    /** Compute error function value */
-    double getErrorValue(const Glass* g);
+    /** Read the search parameter table once per search */
+    QVector<GlassSearchEngine::Term> getSearchTerms(QStringList& paramNames);
     QComboBox* createParameterCombo();
     void setCellValue(QTableWidget* table, int row, int col, QString str);
 
@@ -71,6 +76,9 @@ private:
     QMdiArea*     m_parentMdiArea;
     QTableWidget* m_tableProperties;
     QTableWidget* m_tableResult;
+
+    QStringList m_parameterNames;
+    std::shared_ptr<const GlassConstraintIndex> m_constraintIndex;
 };
 
 
@@ -40,17 +40,20 @@ GlassSelectionDialog::GlassSelectionDialog(QWidget *parent) :
     m_lineEditFilter   = ui->lineEdit_Filter;
     m_listWidgetGlass  = ui->listWidget_Glass;
 
-    m_lineEditFilter->setPlaceholderText("Filter");
-
-    for(int i = 0; i < GlassCatalogManager::catalogList().size(); i++){
-        m_comboBoxSupplyer->addItem(GlassCatalogManager::catalogList().at(i)->supplier());
+    m_lineEditFilter->setPlaceholderText("Filter, e.g. nbk7, sf6 hoya");
+
+    // the list is consistent with the catalogs at the time of opening
+    m_snapshot = GlassCatalogManager::snapshot();
+    m_nameIndex = GlassNameIndex::instance(m_snapshot);
+    m_comboBoxSupplyer->addItem(tr("All Suppliers"));
+    for(int i = 0; i < m_snapshot->catalogCount(); i++){
+        m_comboBoxSupplyer->addItem(m_snapshot->catalog(i)->supplier());
     }
 
-    QObject::connect(m_comboBoxSupplyer,SIGNAL(currentIndexChanged(int)), this, SLOT(onComboChanged()));
+    QObject::connect(m_comboBoxSupplyer,SIGNAL(currentIndexChanged(int)), this, SLOT(updateGlassList()));
 
     QObject::connect(m_lineEditFilter,SIGNAL(textEdited(QString)), this, SLOT(updateGlassList()));
 
-    createGlassNameList();
     updateGlassList();
 }
 
@@ -59,44 +62,40 @@ GlassSelectionDialog::~GlassSelectionDialog()
     delete ui;
 }
 
-void GlassSelectionDialog::onComboChanged()
-{
-    m_lineEditFilter->clear();
-    createGlassNameList();
-    updateGlassList();
-}
-
-void GlassSelectionDialog::createGlassNameList()
-{
-    m_glassNameList.clear();
-    int catalogIndex = m_comboBoxSupplyer->currentIndex();
-    GlassCatalog* catalog = GlassCatalogManager::catalogList().at(catalogIndex);
-    for(int i = 0; i < catalog->glassCount(); i++)
-    {
-        m_glassNameList.append(catalog->glass(i)->productName());
-    }
-    catalog = nullptr;
-}
-
 void GlassSelectionDialog::updateGlassList()
 {
     m_listWidgetGlass->clear();
 
-    QStringList glassNameList = m_glassNameList;
-    QString filter = m_lineEditFilter->text();
-    if(filter.length() > 0  ){
-        glassNameList = glassNameList.filter( m_lineEditFilter->text(), Qt::CaseInsensitive );
+    // first item is all suppliers
+    bool allSuppliers = (m_comboBoxSupplyer->currentIndex() <= 0);
+    QString supplier  = allSuppliers ? QString() : m_comboBoxSupplyer->currentText();
+
+    QVector<GlassNameIndex::Match> matches = m_nameIndex->search(m_lineEditFilter->text(), supplier);
+    for(auto &m : matches){
+        QString text = m_nameIndex->productName(m.entry);
+        if(allSuppliers){
+            text += " (" + m_nameIndex->supplier(m.entry) + ")";
+        }
+        QListWidgetItem* item = new QListWidgetItem(text);
+        item->setData(Qt::UserRole, m_nameIndex->handle(m.entry));
+        m_listWidgetGlass->addItem(item);
     }
 
-    m_listWidgetGlass->addItems(glassNameList);
     m_listWidgetGlass->setCurrentRow(0);  // avoid empty selection
 }
 
 
 Glass* GlassSelectionDialog::getSelectedGlass()
 {
-    int catalogIndex = ui->comboBox_Supplyer->currentIndex();
-    QString productName = ui->listWidget_Glass->currentItem()->text();
+    if(!ui->listWidget_Glass->currentItem()){
+        return nullptr;
+    }
 
-    return GlassCatalogManager::catalogList()[catalogIndex]->glass(productName);
+    GlassHandle handle = ui->listWidget_Glass->currentItem()->data(Qt::UserRole).toUInt();
+    return m_snapshot->glass(handle);
+}
+
+CatalogSnapshotPtr GlassSelectionDialog::snapshot() const
+{
+    return m_snapshot;
 }
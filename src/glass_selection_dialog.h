@@ -25,6 +25,7 @@
 #ifndef GLASS_SELECTION_DIALOG_H
 #define GLASS_SELECTION_DIALOG_H
 
+#include <memory>
 #include <QDialog>
 #include <QList>
 #include <QStringList>
@@ -33,6 +34,8 @@
 #include <QListWidget>
 
 #include "glass.h"
+#include "catalog_snapshot.h"
+#include "glass_name_index.h"
 
 namespace Ui {
 class GlassSelectionDialog;
@@ -49,10 +52,11 @@ public:
 
     Glass* getSelectedGlass();
 
+    /** The snapshot which the selected glass belongs to. Hold it while using the glass. */
+    CatalogSnapshotPtr snapshot() const;
+
 private slots:
     void updateGlassList();
-    void createGlassNameList();
-    void onComboChanged();
 
 private:
     Ui::GlassSelectionDialog *ui;
@@ -61,7 +65,8 @@ private:
     QLineEdit*   m_lineEditFilter;
     QListWidget* m_listWidgetGlass;
 
-    QStringList  m_glassNameList;
+    CatalogSnapshotPtr m_snapshot;
+    std::shared_ptr<const GlassNameIndex> m_nameIndex; // names of all catalogs in m_snapshot
 
 };
 
@@ -0,0 +1,207 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_skyline.h"
+
+#include <algorithm>
+#include <QtMath>
+#include <QtConcurrent>
+
+namespace {
+
+const int kRowChunkSize = 1024;
+
+} // namespace
+
+GlassSkyline::GlassSkyline(const GlassPropertyTable &table, const QVector<Objective> &objectives)
+    : table_(table),
+      objectives_(objectives),
+      dim_(objectives.size()),
+      candidate_count_(0)
+{
+}
+
+QStringList GlassSkyline::directionNames()
+{
+    return QStringList({"Minimize", "Maximize", "Minimize |x|"});
+}
+
+QVector<int> GlassSkyline::compute(const QBitArray *mask)
+{
+    const int rowCount = table_.rowCount();
+    candidate_count_ = 0;
+    if(0 == dim_){
+        return QVector<int>();
+    }
+
+    // transformed values, row-major
+    values_.resize(rowCount*dim_);
+    for(int j = 0; j < dim_; j++){
+        const double* col = table_.column(objectives_[j].column);
+        for(int r = 0; r < rowCount; r++){
+            double v = col[r];
+            if(Maximize == objectives_[j].direction){
+                v = -v;
+            }else if(MinimizeAbs == objectives_[j].direction){
+                v = fabs(v);
+            }
+            values_[r*dim_ + j] = v;
+        }
+    }
+
+    QVector<int> rows;
+    for(int r = 0; r < rowCount; r++){
+        if(mask && !mask->testBit(r)){
+            continue;
+        }
+        bool valid = true;
+        for(int j = 0; j < dim_; j++){
+            valid = valid && qIsFinite(values_[r*dim_ + j]);
+        }
+        if(valid){
+            rows.append(r);
+        }
+    }
+    candidate_count_ = rows.size();
+
+    QVector<int> skyline;
+    if(1 == dim_){
+        double best = qInf();
+        for(int r : rows){
+            best = qMin(best, values_[r]);
+        }
+        for(int r : rows){
+            if(values_[r] == best){
+                skyline.append(r);
+            }
+        }
+    }
+    else if(2 == dim_){
+        skyline = sweep2D(rows);
+    }
+    else{
+        // normalized sum, monotone in every objective
+        QVector<double> lower(dim_, qInf()), upper(dim_, -qInf());
+        for(int r : rows){
+            for(int j = 0; j < dim_; j++){
+                lower[j] = qMin(lower[j], values_[r*dim_ + j]);
+                upper[j] = qMax(upper[j], values_[r*dim_ + j]);
+            }
+        }
+        scores_.fill(0.0, rowCount);
+        for(int r : rows){
+            for(int j = 0; j < dim_; j++){
+                if(upper[j] > lower[j]){
+                    scores_[r] += (values_[r*dim_ + j] - lower[j])/(upper[j] - lower[j]);
+                }
+            }
+        }
+
+        // local skylines in parallel, then the skyline of their union
+        QVector< QVector<int> > chunks;
+        for(int begin = 0; begin < rows.size(); begin += kRowChunkSize){
+            chunks.append(rows.mid(begin, kRowChunkSize));
+        }
+        QtConcurrent::blockingMap(chunks, [this](QVector<int>& chunk){
+            chunk = sortFilter(chunk);
+        });
+
+        QVector<int> merged;
+        for(auto &chunk : chunks){
+            merged += chunk;
+        }
+        skyline = (chunks.size() > 1) ? sortFilter(merged) : merged;
+    }
+
+    std::sort(skyline.begin(), skyline.end());
+    return skyline;
+}
+
+QVector<int> GlassSkyline::sweep2D(const QVector<int> &rows) const
+{
+    QVector<int> sorted = rows;
+    std::sort(sorted.begin(), sorted.end(), [this](int a, int b){
+        if(values_[a*2] != values_[b*2]) return values_[a*2] < values_[b*2];
+        return values_[a*2 + 1] < values_[b*2 + 1];
+    });
+
+    // Within a group of the same first objective, only the smallest second objective survives.
+    // It survives if it is smaller than the second objective of all the previous groups.
+    QVector<int> skyline;
+    double best = qInf();
+    for(int i = 0; i < sorted.size(); ){
+        const double first = values_[sorted[i]*2];
+        const double groupBest = values_[sorted[i]*2 + 1];
+        int j = i;
+        for(; j < sorted.size() && values_[sorted[j]*2] == first; j++){
+            if(values_[sorted[j]*2 + 1] == groupBest && groupBest < best){
+                skyline.append(sorted[j]);
+            }
+        }
+        best = qMin(best, groupBest);
+        i = j;
+    }
+
+    return skyline;
+}
+
+QVector<int> GlassSkyline::sortFilter(QVector<int> rows) const
+{
+    // a glass which dominates another comes first: smaller score, or the same score and lexicographically smaller
+    std::sort(rows.begin(), rows.end(), [this](int a, int b){
+        if(scores_[a] != scores_[b]) return scores_[a] < scores_[b];
+        return std::lexicographical_compare(values_.constData() + a*dim_, values_.constData() + (a + 1)*dim_,
+                                            values_.constData() + b*dim_, values_.constData() + (b + 1)*dim_);
+    });
+
+    QVector<int> skyline;
+    for(int r : rows){
+        bool dominated = false;
+        for(int s : skyline){
+            if(dominates(s, r)){
+                dominated = true;
+                break;
+            }
+        }
+        if(!dominated){
+            skyline.append(r);
+        }
+    }
+
+    return skyline;
+}
+
+bool GlassSkyline::dominates(int a, int b) const
+{
+    const double* va = values_.constData() + a*dim_;
+    const double* vb = values_.constData() + b*dim_;
+    bool better = false;
+    for(int j = 0; j < dim_; j++){
+        if(va[j] > vb[j]){
+            return false;
+        }
+        better = better || (va[j] < vb[j]);
+    }
+    return better;
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SKYLINE_H
+#define GLASS_SKYLINE_H
+
+#include <QVector>
+#include <QBitArray>
+
+#include "glass_property_table.h"
+
+/**
+ * @brief Pareto optimal glasses (skyline) over several objectives
+ * @details
+ * Each objective is transformed so that smaller is better.  A glass dominates another if it is not
+ * worse in any objective and better in at least one.
+ *  - 1 objective  : the glasses of the best value
+ *  - 2 objectives : one sweep over the glasses sorted by the first objective, O(N log N)
+ *  - more         : sort-filter-skyline.  Glasses are sorted by the sum of the normalized objectives,
+ *                   so that no glass is dominated by a later one and each glass is compared only with
+ *                   the skyline found so far.  Chunks of glasses are filtered in parallel first, then
+ *                   the union of the local skylines is filtered again.
+ * Glasses with NaN in any objective are excluded.
+ */
+class GlassSkyline
+{
+public:
+    enum Direction{
+        Minimize,
+        Maximize,
+        MinimizeAbs
+    };
+
+    struct Objective{
+        int       column; // column of the property table
+        Direction direction;
+    };
+
+    GlassSkyline(const GlassPropertyTable& table, const QVector<Objective>& objectives);
+
+    /**
+     * @param mask if given, only the rows whose bit is set are considered
+     * @return rows of the Pareto optimal glasses in the catalog order
+     */
+    QVector<int> compute(const QBitArray* mask = nullptr);
+
+    /** number of candidate glasses of the last computation */
+    int candidateCount() const{ return candidate_count_; }
+
+    static QStringList directionNames();
+
+private:
+    QVector<int> sweep2D(const QVector<int>& rows) const;
+    QVector<int> sortFilter(QVector<int> rows) const;
+    bool dominates(int a, int b) const;
+
+    const GlassPropertyTable& table_;
+    QVector<Objective> objectives_;
+    int                dim_;
+    QVector<double>    values_; // rowCount x dim, smaller is better
+    QVector<double>    scores_; // sum of the normalized values
+    int                candidate_count_;
+};
+
+#endif // GLASS_SKYLINE_H
@@ -0,0 +1,175 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_snap_command.h"
+
+#include <cstring>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+
+#include "glass.h"
+#include "glass_catalog_manager.h"
+#include "glass_constraint_index.h"
+#include "glass_snapper.h"
+#include "global_settings_io.h"
+
+bool GlassSnapCommand::isRequested(int argc, char *argv[])
+{
+    for(int i = 1; i < argc; i++){
+        if(0 == strcmp(argv[i], "--snap")){
+            return true;
+        }
+    }
+    return false;
+}
+
+int GlassSnapCommand::run(const QStringList &arguments)
+{
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Snap model glasses (name, nd, vd[, dPgF]) to the nearest catalog glasses.");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("snap",        "Model glass file, or - for stdin.", "file"));
+    parser.addOption(QCommandLineOption("output",      "Result CSV file. Default is stdout.", "file"));
+    parser.addOption(QCommandLineOption("catalog",     "Catalog file. Can be repeated. Default is the preference.", "file"));
+    parser.addOption(QCommandLineOption("conditions",  "Candidate conditions, e.g. \"status = Preferred, supplier = SCHOTT|OHARA\".", "text"));
+    parser.addOption(QCommandLineOption("weights",     "Weights of nd, vd and dPgF.", "nd,vd,dPgF", "1,1,1"));
+    parser.addOption(QCommandLineOption("count",       "Number of glasses per model glass.", "k", "1"));
+    parser.addOption(QCommandLineOption("temperature", "Temperature in degrees Celsius. Default is the preference.", "T"));
+    parser.process(arguments);
+
+    // preference
+    GlobalSettingsIO settings;
+    settings.loadIniFile();
+    GlassCatalogManager::setLoadFilter(settings.loadFilter());
+
+    double temperature = settings.temperature();
+    if(parser.isSet("temperature")){
+        bool ok;
+        temperature = parser.value("temperature").toDouble(&ok);
+        if(!ok){
+            err << "Invalid temperature: " << parser.value("temperature") << "\n";
+            return 1;
+        }
+    }
+    Glass::setCurrentTemperature(temperature);
+
+    QVector<double> weights;
+    for(auto &w : parser.value("weights").split(',')){
+        bool ok;
+        weights.append(w.trimmed().toDouble(&ok));
+        if(!ok || weights.last() < 0.0){
+            err << "Invalid weights: " << parser.value("weights") << "\n";
+            return 1;
+        }
+    }
+    if(weights.size() != GlassSnapper::coordinateNames().size()){
+        err << "Weights must be given for nd, vd and dPgF\n";
+        return 1;
+    }
+
+    bool ok;
+    const int k = parser.value("count").toInt(&ok);
+    if(!ok || k < 1){
+        err << "Invalid count: " << parser.value("count") << "\n";
+        return 1;
+    }
+
+    // catalogs
+    QStringList catalogFilePaths = parser.isSet("catalog") ? parser.values("catalog") : settings.defaultFilePaths();
+    if(catalogFilePaths.isEmpty()){
+        err << "No catalog file is given\n";
+        return 1;
+    }
+    LoadDiagnostics diagnostics;
+    GlassCatalogManager::loadCatalogFiles(catalogFilePaths, diagnostics);
+
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    if(snapshot->isEmpty()){
+        err << "No catalog has been loaded\n";
+        return 1;
+    }
+
+    // candidates
+    auto index = GlassConstraintIndex::instance(snapshot);
+    QString errorMessage;
+    GlassConstraintQuery query = GlassConstraintQuery::parse(parser.value("conditions"), &errorMessage);
+    QBitArray mask;
+    if(errorMessage.isEmpty()){
+        mask = index->select(query, &errorMessage);
+    }
+    if(!errorMessage.isEmpty()){
+        err << "Invalid conditions: " << errorMessage << "\n";
+        return 1;
+    }
+
+    // model glasses
+    QFile input;
+    const QString inputPath = parser.value("snap");
+    bool opened;
+    if(inputPath == "-"){
+        opened = input.open(stdin, QIODevice::ReadOnly | QIODevice::Text);
+    }else{
+        input.setFileName(inputPath);
+        opened = input.open(QIODevice::ReadOnly | QIODevice::Text);
+    }
+    if(!opened){
+        err << "Could not open " << inputPath << "\n";
+        return 1;
+    }
+    QVector<GlassSnapper::ModelGlass> models;
+    if(!GlassSnapper::readModelGlasses(&input, models, &errorMessage)){
+        err << inputPath << ": " << errorMessage << "\n";
+        return 1;
+    }
+    input.close();
+
+    GlassSnapper snapper(index, mask, weights);
+    if(0 == snapper.candidateCount()){
+        err << "No glass satisfies the conditions\n";
+        return 1;
+    }
+    const QVector< QVector<GlassSnapper::Match> > matches = snapper.snap(models, k);
+
+    // result
+    QFile output;
+    if(parser.isSet("output")){
+        output.setFileName(parser.value("output"));
+        opened = output.open(QIODevice::WriteOnly | QIODevice::Text);
+    }else{
+        opened = output.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+    if(!opened){
+        err << "Could not open " << parser.value("output") << "\n";
+        return 1;
+    }
+    QTextStream out(&output);
+    snapper.writeMatches(out, models, matches);
+    out.flush();
+
+    return 0;
+}
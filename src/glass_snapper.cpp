@@ -0,0 +1,184 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_snapper.h"
+
+#include <QIODevice>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QtMath>
+
+#include "glass.h"
+
+GlassSnapper::GlassSnapper(std::shared_ptr<const GlassConstraintIndex> index, const QBitArray &mask, const QVector<double> &weights)
+    : index_(index)
+{
+    const GlassPropertyTable& tbl = index_->table();
+    const QStringList names = coordinateNames();
+    const int rowCount = tbl.rowCount();
+
+    QVector<const double*> columns;
+    for(int j = 0; j < names.size(); j++){
+        const int col = tbl.columnIndex(names[j]);
+        columns.append(col < 0 ? nullptr : tbl.column(col));
+
+        // standard deviation over the candidates
+        double sum = 0.0, sum2 = 0.0;
+        int n = 0;
+        for(int r = 0; columns[j] && r < rowCount; r++){
+            if(r < mask.size() && mask.testBit(r) && qIsFinite(columns[j][r])){
+                sum  += columns[j][r];
+                sum2 += columns[j][r]*columns[j][r];
+                n++;
+            }
+        }
+        const double var = (n > 1) ? (sum2 - sum*sum/n)/(n - 1) : 0.0;
+        const double weight = (j < weights.size()) ? weights[j] : 1.0;
+        scales_[j] = (var > 0.0) ? weight/sqrt(var) : weight;
+    }
+
+    QVector<double> coords3(rowCount*3, qQNaN());
+    QVector<double> coords2(rowCount*2, qQNaN());
+    for(int r = 0; r < rowCount; r++){
+        for(int j = 0; j < 3; j++){
+            if(columns[j]){
+                coords3[r*3 + j] = columns[j][r]*scales_[j];
+            }
+        }
+        coords2[r*2]     = coords3[r*3];
+        coords2[r*2 + 1] = coords3[r*3 + 1];
+    }
+
+    QBitArray candidates = mask;
+    candidates.resize(rowCount);
+    tree_nd_vd_dPgF_ = GlassKdTree(coords3, 3, &candidates);
+    tree_nd_vd_      = GlassKdTree(coords2, 2, &candidates);
+}
+
+QStringList GlassSnapper::coordinateNames()
+{
+    return QStringList({"nd", "vd", "dPgF"});
+}
+
+QVector< QVector<GlassSnapper::Match> > GlassSnapper::snap(const QVector<ModelGlass> &models, int k) const
+{
+    // split the models by the dimension, then query each tree in one batch
+    QVector<int>    indices3, indices2;
+    QVector<double> points3, points2;
+    for(int i = 0; i < models.size(); i++){
+        const ModelGlass& m = models[i];
+        if(qIsFinite(m.dPgF)){
+            indices3.append(i);
+            points3 << m.nd*scales_[0] << m.vd*scales_[1] << m.dPgF*scales_[2];
+        }else{
+            indices2.append(i);
+            points2 << m.nd*scales_[0] << m.vd*scales_[1];
+        }
+    }
+
+    QVector< QVector<Match> > matches(models.size());
+    auto collect = [&](const QVector<int>& indices, const QVector< QVector<GlassKdTree::Neighbor> >& neighbors){
+        for(int i = 0; i < indices.size(); i++){
+            for(auto &n : neighbors[i]){
+                matches[indices[i]].append(Match{n.row, n.distance});
+            }
+        }
+    };
+    collect(indices3, tree_nd_vd_dPgF_.nearest(points3, k));
+    collect(indices2, tree_nd_vd_.nearest(points2, k));
+
+    return matches;
+}
+
+bool GlassSnapper::readModelGlasses(QIODevice *device, QVector<ModelGlass> &models, QString *errorMessage)
+{
+    static const QRegularExpression separator("\\s*[,;\\t]\\s*|\\s+");
+
+    QTextStream in(device);
+    int lineNumber = 0;
+    bool firstData = true;
+    while(!in.atEnd()){
+        const QString line = in.readLine().trimmed();
+        lineNumber++;
+        if(line.isEmpty() || line.startsWith('#')){
+            continue;
+        }
+
+        const QStringList fields = line.split(separator);
+        bool ok = (fields.size() == 3 || fields.size() == 4);
+        ModelGlass m;
+        if(ok){
+            bool okNd, okVd, okPgF = true;
+            m.name = fields[0];
+            m.nd   = fields[1].toDouble(&okNd);
+            m.vd   = fields[2].toDouble(&okVd);
+            m.dPgF = (fields.size() == 4) ? fields[3].toDouble(&okPgF) : qQNaN();
+            ok = okNd && okVd && okPgF;
+        }
+
+        if(!ok){
+            if(firstData){ // header
+                firstData = false;
+                continue;
+            }
+            if(errorMessage){
+                *errorMessage = QString("Line %1: expected \"name, nd, vd[, dPgF]\"").arg(lineNumber);
+            }
+            return false;
+        }
+
+        firstData = false;
+        models.append(m);
+    }
+
+    return true;
+}
+
+void GlassSnapper::writeMatches(QTextStream &out, const QVector<ModelGlass> &models, const QVector< QVector<Match> > &matches) const
+{
+    const GlassPropertyTable& tbl = index_->table();
+    const QStringList names = coordinateNames();
+
+    out << "Model,Model_nd,Model_vd,Model_dPgF,Rank,Supplier,Glass,nd,vd,dPgF,Distance" << "\n";
+    for(int i = 0; i < models.size(); i++){
+        const ModelGlass& m = models[i];
+        for(int j = 0; j < matches[i].size(); j++){
+            const Match& match = matches[i][j];
+            const Glass* g = tbl.glass(match.row);
+
+            QStringList fields;
+            fields << m.name << QString::number(m.nd) << QString::number(m.vd) << (qIsFinite(m.dPgF) ? QString::number(m.dPgF) : QString());
+            fields << QString::number(j + 1) << g->supplier() << g->productName();
+            for(auto &name : names){
+                const int col = tbl.columnIndex(name);
+                fields << ((col < 0) ? QString() : QString::number(tbl.value(match.row, col)));
+            }
+            fields << QString::number(match.distance);
+            out << fields.join(",") << "\n";
+        }
+        if(matches[i].isEmpty()){
+            out << m.name << "," << m.nd << "," << m.vd << "," << (qIsFinite(m.dPgF) ? QString::number(m.dPgF) : QString()) << ",,,,,,," << "\n";
+        }
+    }
+}
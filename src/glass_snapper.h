@@ -0,0 +1,94 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SNAPPER_H
+#define GLASS_SNAPPER_H
+
+#include <memory>
+#include <QVector>
+#include <QBitArray>
+#include <QString>
+
+#include "glass_constraint_index.h"
+#include "glass_kd_tree.h"
+
+class QIODevice;
+class QTextStream;
+
+/**
+ * @brief Snap model glasses (nd, vd, dPgF) to the nearest real glasses
+ * @details
+ * Each coordinate is divided by its standard deviation over the candidate glasses and multiplied
+ * by the weight, so that the weights are comparable regardless of the units.
+ * Model glasses without dPgF are snapped in the (nd, vd) plane.
+ */
+class GlassSnapper
+{
+public:
+    struct ModelGlass{
+        QString name;
+        double  nd;
+        double  vd;
+        double  dPgF; // NaN if not given
+    };
+
+    struct Match{
+        int    row; // row of the property table
+        double distance; // normalized and weighted
+    };
+
+    /**
+     * @param mask candidate rows of the index table
+     * @param weights weights of nd, vd and dPgF
+     */
+    GlassSnapper(std::shared_ptr<const GlassConstraintIndex> index, const QBitArray& mask, const QVector<double>& weights);
+
+    /** nd, vd, dPgF */
+    static QStringList coordinateNames();
+
+    const GlassPropertyTable& table() const{ return index_->table(); }
+
+    int candidateCount() const{ return tree_nd_vd_.size(); }
+
+    /** k nearest glasses of each model glass, queried in parallel */
+    QVector< QVector<Match> > snap(const QVector<ModelGlass>& models, int k) const;
+
+    /**
+     * @brief Read model glasses, one per line as "name, nd, vd[, dPgF]"
+     * @details Comma, semicolon, tab or space separated.  Empty lines, lines starting with '#' and a header line are skipped.
+     * @return false with the message if a line could not be parsed
+     */
+    static bool readModelGlasses(QIODevice* device, QVector<ModelGlass>& models, QString* errorMessage = nullptr);
+
+    /** write the matches as CSV, one line per match */
+    void writeMatches(QTextStream& out, const QVector<ModelGlass>& models, const QVector< QVector<Match> >& matches) const;
+
+private:
+    std::shared_ptr<const GlassConstraintIndex> index_;
+    double      scales_[3]; // weight / standard deviation
+    GlassKdTree tree_nd_vd_dPgF_;
+    GlassKdTree tree_nd_vd_;
+};
+
+#endif // GLASS_SNAPPER_H
@@ -0,0 +1,246 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "glass_substitution_form.h"
+#include "ui_glass_substitution_form.h"
+
+#include <algorithm>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QTextStream>
+#include <QValidator>
+#include <QRegularExpression>
+
+#include "glass_catalog_manager.h"
+#include "glass_selection_dialog.h"
+
+GlassSubstitutionForm::GlassSubstitutionForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::GlassSubstitutionForm),
+    m_parentMdiArea(parent),
+    m_targetGlass(nullptr)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Glass Substitution");
+
+    ui->lineEdit_LambdaMin->setValidator(new QDoubleValidator(0, 100000, 3, this));
+    ui->lineEdit_LambdaMax->setValidator(new QDoubleValidator(0, 100000, 3, this));
+    ui->lineEdit_LambdaMin->setText("400");
+    ui->lineEdit_LambdaMax->setText("700");
+
+    ui->lineEdit_OutputCount->setValidator(new QIntValidator(0,100));
+    ui->lineEdit_OutputCount->setText("10");
+
+    ui->comboBox_Metric->addItem("RMS", DispersionCurveTable::RMS);
+    ui->comboBox_Metric->addItem("Max", DispersionCurveTable::Max);
+
+    QObject::connect(ui->pushButton_SelectGlass, SIGNAL(clicked()), this, SLOT(selectGlass()));
+    QObject::connect(ui->pushButton_LoadCurve,   SIGNAL(clicked()), this, SLOT(loadCurve()));
+    QObject::connect(ui->pushButton_Search,      SIGNAL(clicked()), this, SLOT(showSearchResult()));
+}
+
+GlassSubstitutionForm::~GlassSubstitutionForm()
+{
+    delete ui;
+}
+
+void GlassSubstitutionForm::selectGlass()
+{
+    GlassSelectionDialog *dlg = new GlassSelectionDialog(this);
+    if(dlg->exec() == QDialog::Accepted)
+    {
+        Glass* g = dlg->getSelectedGlass();
+        if(g){
+            m_targetGlass    = g;
+            m_targetSnapshot = dlg->snapshot();
+            ui->label_Target->setText("Target: " + g->fullName());
+        }
+    }
+
+    delete dlg;
+}
+
+void GlassSubstitutionForm::loadCurve()
+{
+    QString filePath = QFileDialog::getOpenFileName(this, tr("Load Curve"), "", tr("Text files(*.txt *.csv);;All Files(*.*)"));
+    if(filePath.isEmpty()){
+        return;
+    }
+
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+        QMessageBox::warning(this, tr("Error"), tr("Failed to open: ") + file.errorString());
+        return;
+    }
+
+    // each line has wavelength(nm), index and optional weight.  Other lines are skipped.
+    struct Sample{ double lambda; double index; double weight; };
+    QVector<Sample> samples;
+
+    QTextStream in(&file);
+    while(!in.atEnd())
+    {
+        QStringList parts = in.readLine().trimmed().split(QRegularExpression("[\\s,;]+"));
+        if(parts.size() < 2){
+            continue;
+        }
+
+        bool ok1, ok2, ok3 = true;
+        Sample s;
+        s.lambda = parts[0].toDouble(&ok1)/1000.0;
+        s.index  = parts[1].toDouble(&ok2);
+        s.weight = (parts.size() > 2) ? parts[2].toDouble(&ok3) : 1.0;
+        if(ok1 && ok2 && ok3){
+            samples.append(s);
+        }
+    }
+
+    if(samples.size() < 2){
+        QMessageBox::warning(this, tr("Error"), tr("At least two samples of wavelength(nm) and index are required"));
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b){ return a.lambda < b.lambda; });
+
+    m_targetGlass = nullptr;
+    m_targetSnapshot.reset();
+    m_targetWavelengths.clear();
+    m_targetIndices.clear();
+    m_targetWeights.clear();
+    for(auto &s : samples){
+        m_targetWavelengths.append(s.lambda);
+        m_targetIndices.append(s.index);
+        m_targetWeights.append(s.weight);
+    }
+
+    ui->label_Target->setText("Target: " + QFileInfo(filePath).fileName());
+}
+
+bool GlassSubstitutionForm::getTargetCurve(const QVector<double>& grid, QVector<double>& target, QVector<double>& weights)
+{
+    target.resize(grid.size());
+    weights.resize(grid.size());
+
+    if(m_targetGlass){
+        for(int i = 0; i < grid.size(); i++){
+            target[i]  = m_targetGlass->refractiveIndex(grid[i]);
+            weights[i] = 1.0;
+        }
+        return true;
+    }
+
+    if(m_targetWavelengths.isEmpty()){
+        return false;
+    }
+
+    // linear interpolation of the tabulated curve, outside of it is ignored
+    for(int i = 0; i < grid.size(); i++)
+    {
+        auto it = std::lower_bound(m_targetWavelengths.begin(), m_targetWavelengths.end(), grid[i]);
+        int j = static_cast<int>(it - m_targetWavelengths.begin());
+
+        if(j < m_targetWavelengths.size() && m_targetWavelengths[j] == grid[i]){
+            target[i]  = m_targetIndices[j];
+            weights[i] = m_targetWeights[j];
+        }
+        else if(j == 0 || j == m_targetWavelengths.size()){
+            target[i]  = 0.0;
+            weights[i] = 0.0;
+        }
+        else{
+            double t = (grid[i] - m_targetWavelengths[j-1])/(m_targetWavelengths[j] - m_targetWavelengths[j-1]);
+            target[i]  = m_targetIndices[j-1] + t*(m_targetIndices[j] - m_targetIndices[j-1]);
+            weights[i] = m_targetWeights[j-1] + t*(m_targetWeights[j] - m_targetWeights[j-1]);
+        }
+    }
+
+    return true;
+}
+
+void GlassSubstitutionForm::showSearchResult()
+{
+    double lambdaMin = ui->lineEdit_LambdaMin->text().toDouble()/1000.0;
+    double lambdaMax = ui->lineEdit_LambdaMax->text().toDouble()/1000.0;
+    if(lambdaMax <= lambdaMin){
+        QMessageBox::warning(this, tr("Error"), tr("Invalid wavelength range"));
+        return;
+    }
+    QVector<double> grid = DispersionCurveTable::uniformGrid(lambdaMin, lambdaMax, ui->spinBox_SampleCount->value());
+
+    QVector<double> target, weights;
+    if(!getTargetCurve(grid, target, weights)){
+        QMessageBox::warning(this, tr("Error"), tr("No target has been set"));
+        return;
+    }
+
+    // curves are sampled once per snapshot, grid and temperature
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    if(!m_curveTable.isCurrent(snapshot, grid)){
+        m_curveTable = DispersionCurveTable(snapshot, grid);
+    }
+
+    int resultCount = ui->lineEdit_OutputCount->text().toInt();
+    DispersionCurveTable::Metric metric = static_cast<DispersionCurveTable::Metric>(ui->comboBox_Metric->currentData().toInt());
+    bool allowOffset = ui->checkBox_Offset->isChecked();
+
+    // the target glass itself is excluded
+    QVector<DispersionCurveTable::Match> matches = m_curveTable.findClosest(target, weights, metric, allowOffset, resultCount + 1);
+    for(int i = 0; i < matches.size(); i++){
+        if(m_targetGlass && m_curveTable.glass(matches[i].row)->fullName() == m_targetGlass->fullName()){
+            matches.removeAt(i);
+            break;
+        }
+    }
+    if(matches.size() > resultCount){
+        matches.resize(resultCount);
+    }
+
+    //setup result table
+    QStringList hHeaderLabels({"Glass", "Catalog", "Distance", "Offset", "nd", "vd"});
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(matches.size());
+    for(int i = 0; i < matches.size(); i++) {
+        const Glass* g = m_curveTable.glass(matches[i].row);
+        setCellValue(ui->tableWidget_Result, i, 0, g->productName());
+        setCellValue(ui->tableWidget_Result, i, 1, g->supplier());
+        setCellValue(ui->tableWidget_Result, i, 2, numToQString(matches[i].distance, 'e', 3));
+        setCellValue(ui->tableWidget_Result, i, 3, numToQString(matches[i].offset, 'e', 3));
+        setCellValue(ui->tableWidget_Result, i, 4, numToQString(g->getValue("nd")));
+        setCellValue(ui->tableWidget_Result, i, 5, numToQString(g->getValue("vd")));
+    }
+}
+
+void GlassSubstitutionForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GLASS_SUBSTITUTION_FORM_H
+#define GLASS_SUBSTITUTION_FORM_H
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+
+#include "glass.h"
+#include "catalog_snapshot.h"
+#include "dispersion_curve_table.h"
+
+namespace Ui {
+class GlassSubstitutionForm;
+}
+
+/** Form to search substitutes by the dispersion curve over a wavelength band */
+class GlassSubstitutionForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit GlassSubstitutionForm(QMdiArea *parent = nullptr);
+    ~GlassSubstitutionForm();
+
+private slots:
+    /** Select a glass as the target */
+    void selectGlass();
+
+    /** Load a tabulated curve as the target */
+    void loadCurve();
+
+    /** Execute search and show result */
+    void showSearchResult();
+
+private:
+    /**
+     * @brief Sample the target on the grid
+     * @param weights 0 for the samples not covered by a tabulated curve
+     */
+    bool getTargetCurve(const QVector<double>& grid, QVector<double>& target, QVector<double>& weights);
+
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+    inline QString numToQString(double val, char fmt='f', int digit=6);
+
+    Ui::GlassSubstitutionForm *ui;
+    QMdiArea* m_parentMdiArea;
+
+    // target glass, or tabulated curve if m_targetGlass is null
+    Glass*             m_targetGlass;
+    CatalogSnapshotPtr m_targetSnapshot; // keeps m_targetGlass alive
+    QVector<double>    m_targetWavelengths; // micron, ascending
+    QVector<double>    m_targetIndices;
+    QVector<double>    m_targetWeights;
+
+    DispersionCurveTable m_curveTable;
+};
+
+
+QString GlassSubstitutionForm::numToQString(double val, char fmt, int digit)
+{
+    if(qIsNaN(val)){
+        return "-";
+    }
+    else{
+        return QString::number(val,fmt,digit);
+    }
+}
+
+#endif // GLASS_SUBSTITUTION_FORM_H
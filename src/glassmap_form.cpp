@@ -25,7 +25,13 @@
 #include "glassmap_form.h"
 #include "ui_glassmap_form.h"
 
+#include <QtConcurrent>
+
 #include "glass_catalog_manager.h"
+#include "glass_constraint_index.h"
+#include "glass_equivalence_table.h"
+#include "user_property_registry.h"
+#include "normal_line.h"
 #include "glass_datasheet_form.h"
 #include "curve_fitting_dialog.h"
 #include "preset_dialog.h"
@@ -42,27 +48,32 @@ GlassMapForm::GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange
 {
     ui->setupUi(this);
 
+    m_highlightGraph = nullptr;
+    m_markedGraph = nullptr;
+    m_curveGraph = nullptr;
+
     // plot widget
     m_customPlot = ui->widget;
     m_customPlot->setInteraction(QCP::iRangeDrag, true);
     m_customPlot->setInteraction(QCP::iRangeZoom, true);
-    m_customPlot->setInteraction(QCP::iSelectItems, true);
     m_customPlot->axisRect()->insetLayout()->setInsetAlignment(0, Qt::AlignLeft|Qt::AlignTop);
     m_customPlot->setContextMenuPolicy(Qt::CustomContextMenu);
     m_customPlot->legend->setVisible(true);
+    m_labelGrid = new QCPLabelGrid(m_customPlot); // owned by the plot
 
     // user defined curve control
     m_checkBoxCurve = ui->checkBox_Curve;
-    QObject::connect(ui->checkBox_Curve,SIGNAL(toggled(bool)), this, SLOT(update()));
+    QObject::connect(ui->checkBox_Curve,SIGNAL(toggled(bool)), this, SLOT(refreshCurve()));
 
     m_lineEditList = QList<QLineEdit*>() << ui->lineEdit_C0 << ui->lineEdit_C1 << ui->lineEdit_C2 << ui->lineEdit_C3;
     for(int i = 0; i < m_lineEditList.size(); i++){
-        QObject::connect(m_lineEditList[i],SIGNAL(textEdited(QString)),this, SLOT(update()));
+        QObject::connect(m_lineEditList[i],SIGNAL(textEdited(QString)),this, SLOT(refreshCurve()));
     }
 
 
     // glassmap control
     setUpScrollArea();
+    QObject::connect(ui->lineEdit_Highlight, SIGNAL(textChanged(QString)), this, SLOT(refreshHighlight()));
 
 
     // Legend
@@ -79,6 +90,9 @@ GlassMapForm::GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange
 
     // neighbors
     m_listWidgetNeighbors = ui->listWidget_Neighbors;
+    m_neighborTarget = 0;
+    m_equivalenceWatcher = new QFutureWatcher< std::shared_ptr<const GlassEquivalenceTable> >(this);
+    QObject::connect(m_equivalenceWatcher, SIGNAL(finished()), this, SLOT(markEquivalentNeighbors()));
     QObject::connect(ui->pushButton_showDatasheet, SIGNAL(clicked()), this, SLOT(showGlassDataSheet()));
 
     // show plot control tab
@@ -92,7 +106,6 @@ GlassMapForm::GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange
     m_settings->setIniCodec(QTextCodec::codecForName("UTF-8"));
 
     // mouse
-    QObject::connect(m_customPlot, SIGNAL(itemClick(QCPAbstractItem*,QMouseEvent*)), this, SLOT(showNeighbors(QCPAbstractItem*)));
     QObject::connect(m_customPlot,SIGNAL(mousePress(QMouseEvent*)),this, SLOT(clearNeighbors()));
 
     // context menu
@@ -108,6 +121,9 @@ GlassMapForm::GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange
     // preset
     QObject::connect(ui->pushButton_Preset, SIGNAL(clicked()), this, SLOT(showPresetDlg()));
 
+    // catalog file reloading
+    QObject::connect(GlassCatalogManager::instance(), SIGNAL(catalogReloaded(int)), this, SLOT(onCatalogReloaded(int)));
+
     // window title
     this->setWindowTitle( xdataname + " - " + ydataname + " Plot");
 
@@ -126,6 +142,8 @@ GlassMapForm::~GlassMapForm()
     }
     m_settings = nullptr;
 
+    deleteLayers();
+
     m_customPlot->clearGraphs();
     m_customPlot->clearPlottables();
     m_customPlot->clearItems();
@@ -195,6 +213,8 @@ void GlassMapForm::setUpScrollArea()
     }
     m_glassMapCtrlList.clear();
 
+    deleteLayers();
+
     if(!m_gridLayoutList.empty()){
         for(auto &grid:m_gridLayoutList){
             delete grid;
@@ -207,12 +227,13 @@ void GlassMapForm::setUpScrollArea()
     gridLayout->setObjectName(QString::fromUtf8("gridLayout_PlotControl"));
     m_gridLayoutList.append(gridLayout);
 
-    for(int i = 0; i < GlassCatalogManager::catalogList().size(); i++)
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    for(int i = 0; i < snapshot->catalogCount(); i++)
     {
         // supplier name
         label = new QLabel(ui->scrollAreaWidgetContents);
         label->setObjectName("label_" + QString::number(i));
-        label->setText(GlassCatalogManager::catalogList().at(i)->supplier());
+        label->setText(snapshot->catalog(i)->supplier());
         gridLayout->addWidget(label, i, 0, 1, 1);
 
         // plot on/off
@@ -220,16 +241,17 @@ void GlassMapForm::setUpScrollArea()
         checkBox1->setObjectName("chkPlot_"+QString::number(i));
         checkBox1->setText("P"); // point
         gridLayout->addWidget(checkBox1, i, 1, 1, 1);
-        QObject::connect(checkBox1,SIGNAL(toggled(bool)), this, SLOT(update()));
+        QObject::connect(checkBox1,SIGNAL(toggled(bool)), this, SLOT(onGlassmapControlToggled()));
 
         // label on/off
         checkBox2 = new QCheckBox(ui->scrollAreaWidgetContents);
         checkBox2->setObjectName("chkLabel_"+QString::number(i));
         checkBox2->setText("T"); // text label
         gridLayout->addWidget(checkBox2, i, 2, 1, 1);
-        QObject::connect(checkBox2,SIGNAL(toggled(bool)), this, SLOT(update()));
+        QObject::connect(checkBox2,SIGNAL(toggled(bool)), this, SLOT(onGlassmapControlToggled()));
 
         m_glassMapCtrlList.append( GlassMapCtrl(label, checkBox1, checkBox2) );
+        m_glassMapLayers.append(GlassMapLayer());
     }
 
     ui->scrollArea->setWidgetResizable(true);
@@ -241,25 +263,39 @@ void GlassMapForm::setLegendVisible()
     m_customPlot->replot();
 }
 
-void GlassMapForm::showNeighbors(QCPAbstractItem* item)
+void GlassMapForm::showNeighbors(const QPointF& pos)
 {
-    if(m_customPlot->selectedItems().isEmpty()){
-        return;
+    // nearest point or label among the shown layers
+    GlassHandle targetHandle = 0;
+    double minDistance = m_customPlot->selectionTolerance();
+    for(auto &layer : m_glassMapLayers){
+        if(!layer.chart || !layer.chart->plottable()->realVisibility()){
+            continue;
+        }
+        QVariant details;
+        double distance = layer.chart->plottable()->selectTest(pos, false, &details);
+        if(distance >= 0 && distance < minDistance){
+            minDistance  = distance;
+            targetHandle = layer.chart->plottable()->handle(details.value<QCPDataSelection>().dataRange().begin());
+        }
     }
 
-    // mouse-selected glass
-    QString glassName = item->objectName();
-    Glass* targetGlass = GlassCatalogManager::find(glassName);
+    // mouse-clicked glass
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    Glass* targetGlass = snapshot->glass(targetHandle);
+    if(!targetGlass){
+        return;
+    }
 
     double xThreshold = (m_customPlot->xAxis->range().upper - m_customPlot->xAxis->range().lower)/10;
     double yThreshold = (m_customPlot->yAxis->range().upper - m_customPlot->yAxis->range().lower)/10;
 
-    for(int i = 0; i < GlassCatalogManager::catalogList().size(); i++){
+    for(int i = 0; i < snapshot->catalogCount(); i++){
 
         // Glasses in currently visible catalogs will be listed.
         if(m_glassMapCtrlList[i].checkBoxPlot->checkState())
         {
-            GlassCatalog* cat = GlassCatalogManager::catalogList().at(i);
+            GlassCatalog* cat = snapshot->catalog(i);
             for(int j = 0; j < cat->glassCount(); j++)
             {
                 Glass* g = cat->glass(j);
@@ -268,17 +304,48 @@ void GlassMapForm::showNeighbors(QCPAbstractItem* item)
                 double dy = (targetGlass->getValue(m_yDataName) - g->getValue(m_yDataName));
 
                 if(fabs(dx) < xThreshold && fabs(dy) < yThreshold){
-                    m_listWidgetNeighbors->addItem(g->fullName());
+                    QListWidgetItem* neighbor = new QListWidgetItem(g->fullName());
+                    neighbor->setData(Qt::UserRole, g->handle());
+                    m_listWidgetNeighbors->addItem(neighbor);
                 }
             }
         }
     }
 
     m_listWidgetNeighbors->update();
+
+    // Building the equivalence table compares all glasses, so the equivalents are marked when it is ready.
+    m_neighborTarget = targetGlass->handle();
+    m_equivalenceWatcher->setFuture(QtConcurrent::run(&GlassEquivalenceTable::instance, snapshot));
+}
+
+void GlassMapForm::markEquivalentNeighbors()
+{
+    auto equivalenceTable = m_equivalenceWatcher->result();
+    if(0 == m_neighborTarget || !equivalenceTable->isCurrent(GlassCatalogManager::snapshot())){
+        return;
+    }
+
+    // equivalents are marked with the RMS index deviation
+    QHash<GlassHandle, double> equivalentDeviations;
+    for(auto &e : equivalenceTable->equivalents(equivalenceTable->rowOf(m_neighborTarget))){
+        equivalentDeviations.insert(equivalenceTable->curves().glass(e.row)->handle(), e.distance);
+    }
+
+    for(int i = 0; i < m_listWidgetNeighbors->count(); i++){
+        QListWidgetItem* neighbor = m_listWidgetNeighbors->item(i);
+        GlassHandle handle = neighbor->data(Qt::UserRole).toUInt();
+        if(equivalentDeviations.contains(handle)){
+            neighbor->setText(neighbor->text() + "  [equivalent, RMS dn=" + QString::number(equivalentDeviations.value(handle), 'e', 1) + "]");
+        }
+    }
+
+    m_listWidgetNeighbors->update();
 }
 
 void GlassMapForm::clearNeighbors()
 {
+    m_neighborTarget = 0;
     m_listWidgetNeighbors->clear();
     m_listWidgetNeighbors->update();
 }
@@ -287,13 +354,12 @@ void GlassMapForm::showGlassDataSheet()
 {
     if(m_listWidgetNeighbors->selectedItems().size() > 0)
     {
-        QString selectedText = m_listWidgetNeighbors->currentItem()->text();
-        QString fullName = selectedText;
+        GlassHandle handle = m_listWidgetNeighbors->currentItem()->data(Qt::UserRole).toUInt();
 
-        Glass *g = GlassCatalogManager::find(fullName);
+        Glass *g = GlassCatalogManager::glass(handle);
 
         if(g){
-            GlassDataSheetForm* subwindow = new GlassDataSheetForm(GlassCatalogManager::find(fullName), m_parentMdiArea);
+            GlassDataSheetForm* subwindow = new GlassDataSheetForm(g, m_parentMdiArea);
             subwindow->setAttribute(Qt::WA_DeleteOnClose);
             m_parentMdiArea->addSubWindow(subwindow);
             subwindow->parentWidget()->setGeometry(0,10, this->width()*1/2,this->height()*3/4);
@@ -314,7 +380,7 @@ void GlassMapForm::showCurveFittingDlg()
             for(int i = 0; i < m_lineEditList.size(); i++){
                 m_lineEditList[i]->setText(QString::number(coefs[i]));
             }
-            this->update();
+            refreshCurve();
         }
         else{
             QMessageBox::warning(this,tr("File"), tr("Fitting calculation failed"));
@@ -341,46 +407,261 @@ void GlassMapForm::setDefault()
 
 void GlassMapForm::update()
 {
-    // delete all graphs and items
-    m_customPlot->clearGraphs();
-    m_customPlot->clearItems();
-    m_customPlot->clearPlottables();
+    // layers are rebuilt only if their data have been changed
+    for(int i = 0; i < m_glassMapLayers.size(); i++)
+    {
+        updateGlassmap(i);
+    }
+    updateHighlight();
+    updateMarkedGlasses();
+    updateCurve();
 
-    int catalogCount = GlassCatalogManager::catalogList().size();
-    QCPScatterChart* glassmap;
-    bool plot_on, label_on;
+    m_customPlot->replot();
+}
 
-    // replot all glassmaps
-    for(int i = 0; i < catalogCount; i++)
-    {
-        plot_on  = m_glassMapCtrlList[i].checkBoxPlot->checkState();
-        label_on = m_glassMapCtrlList[i].checkBoxLabel->checkState();
-
-        if(plot_on || label_on){
-            glassmap = new QCPScatterChart(m_customPlot);
-            setGlassmapData(glassmap, GlassCatalogManager::catalogList().at(i), m_xDataName, m_yDataName, getColorFromIndex(i,catalogCount));
-            glassmap->setVisiblePointSeries(plot_on);
-            glassmap->setVisibleTextLabels(label_on);
+void GlassMapForm::onGlassmapControlToggled()
+{
+    // only the layer of the toggled catalog
+    for(int i = 0; i < m_glassMapCtrlList.size(); i++){
+        if(sender() == m_glassMapCtrlList[i].checkBoxPlot || sender() == m_glassMapCtrlList[i].checkBoxLabel){
+            updateGlassmap(i);
+
+            // highlight follows the plotted catalogs
+            if(sender() == m_glassMapCtrlList[i].checkBoxPlot){
+                updateHighlight();
+            }
+            break;
         }
     }
 
-    // replot user defined curve
+    m_customPlot->replot();
+}
+
+void GlassMapForm::refreshCurve()
+{
+    updateCurve();
+    m_customPlot->replot();
+}
+
+void GlassMapForm::updateCurve()
+{
+    if(m_curveGraph){
+        m_customPlot->removeGraph(m_curveGraph);
+        m_curveGraph = nullptr;
+    }
+
     if(m_checkBoxCurve->checkState()){
-        QCPGraph* curveGraph = m_customPlot->addGraph();
-        setCurveData(curveGraph, getCurveCoefs());
-        curveGraph->setVisible(true);
+        m_curveGraph = m_customPlot->addGraph();
+        setCurveData(m_curveGraph, getCurveCoefs());
+        m_curveGraph->setVisible(true);
+    }
+}
+
+void GlassMapForm::deleteLayers()
+{
+    for(auto &layer : m_glassMapLayers){
+        delete layer.chart;
+    }
+    m_glassMapLayers.clear();
+}
+
+bool GlassMapForm::isLayerCurrent(const GlassMapLayer &layer, const CatalogSnapshotPtr &snapshot, int catalogIndex) const
+{
+    return layer.chart
+            && (catalogIndex < snapshot->catalogCount())
+            && (layer.catalog == snapshot->catalogs()[catalogIndex])
+            && (layer.temperature == Glass::currentTemperature())
+            && (layer.userPropertyRevision == UserPropertyRegistry::revision())
+            && (layer.normalLineRevision == NormalLine::revision());
+}
+
+void GlassMapForm::updateGlassmap(int catalogIndex)
+{
+    GlassMapLayer& layer = m_glassMapLayers[catalogIndex];
+
+    bool plot_on  = m_glassMapCtrlList[catalogIndex].checkBoxPlot->checkState();
+    bool label_on = m_glassMapCtrlList[catalogIndex].checkBoxLabel->checkState();
+
+    // the layer is not built until shown
+    if(!layer.chart && !plot_on && !label_on){
+        return;
     }
 
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    if(!isLayerCurrent(layer, snapshot, catalogIndex)){
+        delete layer.chart;
+        layer = GlassMapLayer();
+        if(catalogIndex >= snapshot->catalogCount()){
+            return;
+        }
+
+        int catalogCount = m_glassMapLayers.size();
+        layer.chart                = new QCPScatterChart(m_customPlot);
+        layer.chart->setLabelGrid(m_labelGrid);
+        layer.catalog              = snapshot->catalogs()[catalogIndex];
+        layer.temperature          = Glass::currentTemperature();
+        layer.userPropertyRevision = UserPropertyRegistry::revision();
+        layer.normalLineRevision   = NormalLine::revision();
+        setGlassmapData(layer.chart, snapshot, catalogIndex, getColorFromIndex(catalogIndex,catalogCount));
+    }
+
+    layer.chart->setVisiblePointSeries(plot_on);
+    layer.chart->setVisibleTextLabels(label_on);
+}
+
+void GlassMapForm::onCatalogReloaded(int catalogIndex)
+{
+    if(catalogIndex >= m_glassMapLayers.size()){
+        return;
+    }
+
+    m_glassMapCtrlList[catalogIndex].labelSupplier->setText(GlassCatalogManager::snapshot()->catalog(catalogIndex)->supplier());
+
+    // only the series of the reloaded catalog is recomputed
+    updateGlassmap(catalogIndex);
+    updateHighlight();
+    updateMarkedGlasses();
+    clearNeighbors();
+    m_customPlot->replot();
+}
+
+void GlassMapForm::refreshHighlight()
+{
+    updateHighlight();
+    m_customPlot->replot();
+}
+
+void GlassMapForm::updateHighlight()
+{
+    if(m_highlightGraph){
+        m_customPlot->removeGraph(m_highlightGraph);
+        m_highlightGraph = nullptr;
+    }
+
+    QString errorMessage;
+    GlassConstraintQuery query = GlassConstraintQuery::parse(ui->lineEdit_Highlight->text(), &errorMessage);
+    if(query.isEmpty()){
+        ui->lineEdit_Highlight->setStyleSheet(errorMessage.isEmpty() ? "" : "color: red");
+        return;
+    }
+
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    auto index = GlassConstraintIndex::instance(snapshot);
+    QBitArray bits = index->select(query, &errorMessage);
+    ui->lineEdit_Highlight->setStyleSheet(errorMessage.isEmpty() ? "" : "color: red");
+
+    // only the glasses of the plotted catalogs
+    const GlassPropertyTable& table = index->table();
+    QVector<double> x, y;
+    for(int i = 0; i < snapshot->catalogCount() && i < m_glassMapCtrlList.size(); i++)
+    {
+        if(!m_glassMapCtrlList[i].checkBoxPlot->checkState()){
+            continue;
+        }
+
+        int offset = table.rowOffset(i);
+        int glassCount = snapshot->catalog(i)->glassCount();
+        for(int j = 0; j < glassCount; j++){
+            if(bits.testBit(offset + j)){
+                const Glass* g = table.glass(offset + j);
+                if("Unknown" != g->formulaName()){
+                    x.append(g->getValue(m_xDataName));
+                    y.append(g->getValue(m_yDataName));
+                }
+            }
+        }
+    }
+
+    m_highlightGraph = m_customPlot->addGraph();
+    m_highlightGraph->setData(x, y);
+    m_highlightGraph->setName("highlight");
+    m_highlightGraph->setLineStyle(QCPGraph::lsNone);
+    m_highlightGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, QPen(Qt::red, 2), Qt::NoBrush, 12));
+}
+
+void GlassMapForm::setOverlay(const QList<QPolygonF>& polygons)
+{
+    m_overlayPolygons = polygons;
+    updateOverlay();
     m_customPlot->replot();
 }
 
+void GlassMapForm::updateOverlay()
+{
+    for(auto &curve : m_overlayCurves){
+        m_customPlot->removePlottable(curve);
+    }
+    m_overlayCurves.clear();
+
+    QPen pen(QColor(255, 0, 0, 160));
+    pen.setWidthF(1.5);
+
+    for(const QPolygonF& polygon : m_overlayPolygons)
+    {
+        if(polygon.isEmpty()){
+            continue;
+        }
+
+        QVector<double> x, y;
+        for(const QPointF& p : polygon){
+            x.append(p.x());
+            y.append(p.y());
+        }
+        x.append(polygon.first().x()); // closed
+        y.append(polygon.first().y());
+
+        QCPCurve* curve = new QCPCurve(m_customPlot->xAxis, m_customPlot->yAxis);
+        curve->setData(x, y);
+        curve->setPen(pen);
+        curve->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDisc, 5));
+        curve->removeFromLegend();
+        m_overlayCurves.append(curve);
+    }
+}
+
+void GlassMapForm::setMarkedGlasses(const QList<GlassHandle>& handles, const QString& name)
+{
+    m_markedGlasses = handles;
+    m_markedName = name;
+    updateMarkedGlasses();
+    m_customPlot->replot();
+}
+
+void GlassMapForm::updateMarkedGlasses()
+{
+    if(m_markedGraph){
+        m_customPlot->removeGraph(m_markedGraph);
+        m_markedGraph = nullptr;
+    }
+
+    if(m_markedGlasses.isEmpty()){
+        return;
+    }
+
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    QVector<double> x, y;
+    for(GlassHandle handle : m_markedGlasses){
+        const Glass* g = snapshot->glass(handle);
+        if(g && "Unknown" != g->formulaName()){
+            x.append(g->getValue(m_xDataName));
+            y.append(g->getValue(m_yDataName));
+        }
+    }
+
+    m_markedGraph = m_customPlot->addGraph();
+    m_markedGraph->setData(x, y);
+    m_markedGraph->setName(m_markedName);
+    m_markedGraph->setLineStyle(QCPGraph::lsNone);
+    m_markedGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssStar, QPen(QColor(0, 128, 0), 2), Qt::NoBrush, 12));
+}
+
 void GlassMapForm::showPresetDlg()
 {
     PresetDialog* dlg = new PresetDialog(m_settings,getCurveCoefs(),this);
 
     if(dlg->exec() == QDialog::Accepted){
         setCurveCoefsToUI(dlg->getCoefs());
-        update();
+        refreshCurve();
     }
 
     delete dlg;
@@ -388,16 +669,42 @@ void GlassMapForm::showPresetDlg()
 }
 
 
-void GlassMapForm::setGlassmapData(QCPScatterChart* glassmap,GlassCatalog* catalog, QString xlabel, QString ylabel, QColor color)
+int GlassMapForm::labelPriority(const QString& status)
+{
+    // labels of commonly used glasses are kept where labels overlap
+    if("Preferred" == status){
+        return 0;
+    }else if("-" == status){
+        return 1; // standard
+    }else if("Obsolete" == status){
+        return 3;
+    }else{
+        return 2;
+    }
+}
+
+void GlassMapForm::setGlassmapData(QCPScatterChart* glassmap, const CatalogSnapshotPtr& snapshot, int catalogIndex, QColor color)
 {
+    GlassCatalog* catalog = snapshot->catalog(catalogIndex);
     int glassCount = catalog->glassCount();
 
+    // Only the two plotted properties are computed, shared by the layers of the same snapshot.
+    // The full constraint index is left to the highlight, as it decodes the deferred data of every glass.
+    if(!m_coordinateTable.isCurrent(snapshot)){
+        m_coordinateTable = GlassPropertyTable(snapshot, QStringList({m_xDataName, m_yDataName}));
+    }
+    const GlassPropertyTable& table = m_coordinateTable;
+    const int offset = table.rowOffset(catalogIndex);
+
     QVector<double> x, y;
-    QVector<QString> labels, obj_names;
+    QVector<QString> labels;
+    QVector<GlassHandle> handles;
+    QVector<int> priorities;
     x.reserve(glassCount);
     y.reserve(glassCount);
     labels.reserve(glassCount);
-    obj_names.reserve(glassCount);
+    handles.reserve(glassCount);
+    priorities.reserve(glassCount);
 
     Glass* g;
 
@@ -407,13 +714,15 @@ void GlassMapForm::setGlassmapData(QCPScatterChart* glassmap,GlassCatalog* catal
         if("Unknown" == g->formulaName()){
             continue;
         }else{
-            x.append(g->getValue(xlabel));
-            y.append(g->getValue(ylabel));
+            x.append(table.value(offset + i, 0));
+            y.append(table.value(offset + i, 1));
             labels.append(g->fullName());
+            handles.append(g->handle());
+            priorities.append(labelPriority(g->status()));
         }
     }
 
-    glassmap->setData(x, y, labels);
+    glassmap->setData(x, y, labels, handles, priorities);
     glassmap->setName(catalog->supplier());
     glassmap->setColor(color);
 }
@@ -490,6 +799,8 @@ void GlassMapForm::mouseMoveSignal(QMouseEvent *event)
 
 void GlassMapForm::mousePressSignal(QMouseEvent *event)
 {
+    m_mousePressPos = event->pos();
+
     if (m_customPlot->legend->selectTest(event->pos(), false) > 0)
     {
         m_customPlot->setInteraction(QCP::iRangeDrag, false);
@@ -507,7 +818,11 @@ void GlassMapForm::mousePressSignal(QMouseEvent *event)
 
 void GlassMapForm::mouseReleaseSignal(QMouseEvent *event)
 {
-    Q_UNUSED(event)
+    // a click without dragging the plot or the legend
+    if(!m_draggingLegend && event->button() == Qt::LeftButton
+            && (event->pos() - m_mousePressPos).manhattanLength() <= QApplication::startDragDistance()){
+        showNeighbors(event->pos());
+    }
     m_draggingLegend = false;
 }
 
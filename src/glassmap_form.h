@@ -25,9 +25,14 @@
 #ifndef GLASSMAP_FORM_H
 #define GLASSMAP_FORM_H
 
+#include <memory>
 #include <QWidget>
+#include <QFutureWatcher>
 #include "qcpscatterchart.h"
-#include "glass_catalog.h"
+#include "catalog_snapshot.h"
+#include "glass_property_table.h"
+
+class GlassEquivalenceTable;
 
 
 namespace Ui {
@@ -42,17 +47,30 @@ public:
     explicit GlassMapForm(QString xdataname, QString ydataname, QCPRange xrange, QCPRange yrange, bool xreversed = true, QMdiArea *parent = nullptr);
     ~GlassMapForm();
 
+    QString xDataName() const{ return m_xDataName; }
+    QString yDataName() const{ return m_yDataName; }
+
+    /** Draw closed polygons over the map, e.g. glass triplets. An empty list removes them. */
+    void setOverlay(const QList<QPolygonF>& polygons);
+
+    /** Mark the glasses, e.g. Pareto optimal ones, with the legend name. An empty list removes them. */
+    void setMarkedGlasses(const QList<GlassHandle>& handles, const QString& name);
+
 private slots:
     void setLegendVisible();
     void showCurveFittingDlg();
-    void showNeighbors(QCPAbstractItem* item);
     void clearNeighbors();
     void showGlassDataSheet();
     void update();
+    void onGlassmapControlToggled();
+    void refreshCurve();
     void setDefault();
     void showPresetDlg();
     void showContextMenu();
     void exportImage();
+    void onCatalogReloaded(int catalogIndex);
+    void refreshHighlight();
+    void markEquivalentNeighbors();
 
 private:
     /**
@@ -74,10 +92,34 @@ private:
     QCheckBox*   m_checkBoxLegend;
     QCheckBox*   m_checkBoxCurve;
     QListWidget* m_listWidgetNeighbors;
+    GlassHandle  m_neighborTarget; // clicked glass of the neighbor list, 0 if none
+    QFutureWatcher< std::shared_ptr<const GlassEquivalenceTable> >* m_equivalenceWatcher;
+
+    /**
+     * @brief Scatter chart of a catalog
+     * @details Kept while hidden, and rebuilt only when the catalog, the temperature or the property definitions change.
+     */
+    struct GlassMapLayer{
+        QCPScatterChart* chart = nullptr;
+        std::shared_ptr<GlassCatalog> catalog;
+        double temperature = 0.0;
+        int    userPropertyRevision = -1;
+        int    normalLineRevision = -1;
+    };
 
     QList<GlassMapCtrl>  m_glassMapCtrlList;
+    QList<GlassMapLayer> m_glassMapLayers; // one layer per catalog
+    QCPGraph*            m_curveGraph;     // user defined curve
     QList<QLineEdit*>    m_lineEditList;
     QList<QGridLayout*>  m_gridLayoutList;
+    QCPGraph*            m_highlightGraph; // glasses which satisfy the highlight conditions
+    QList<QPolygonF>     m_overlayPolygons;
+    QList<QCPCurve*>     m_overlayCurves;
+    QList<GlassHandle>   m_markedGlasses;
+    QString              m_markedName;
+    QCPGraph*            m_markedGraph;
+    QCPLabelGrid*        m_labelGrid;      // text labels placed in the current replot, shared by the layers
+    GlassPropertyTable   m_coordinateTable; // plotted x and y values of all glasses in the snapshot
 
     QSettings* m_settings;
     QString    m_settingFile;
@@ -92,8 +134,22 @@ private:
 
     bool m_draggingLegend;
     QPointF m_dragLegendOrigin;
+    QPoint  m_mousePressPos;
 
-    void   setGlassmapData(QCPScatterChart* glassmap, GlassCatalog* catalog, QString xlabel, QString ylabel, QColor color);
+    /**
+     * @brief List the glasses around the glass clicked at the position
+     * @details The layers are hit-tested directly, as the highlight, marked and curve graphs lie on top of them.
+     */
+    void showNeighbors(const QPointF& pos);
+
+    void   setGlassmapData(QCPScatterChart* glassmap, const CatalogSnapshotPtr& snapshot, int catalogIndex, QColor color);
+    bool   isLayerCurrent(const GlassMapLayer& layer, const CatalogSnapshotPtr& snapshot, int catalogIndex) const;
+    void   deleteLayers();
+    void   updateGlassmap(int catalogIndex);
+    void   updateCurve();
+    void   updateHighlight();
+    void   updateOverlay();
+    void   updateMarkedGlasses();
     void   setUpScrollArea();
     void   saveSetting();
     QList<double> getCurveCoefs();
@@ -102,6 +158,9 @@ private:
 
     QColor getColorFromIndex(int index, int maxIndex);
 
+    /** @brief Priority of the text label by glass status, smaller is shown first where labels overlap */
+    static int labelPriority(const QString& status);
+
 private slots:
     void mouseMoveSignal(QMouseEvent *event);
     void mousePressSignal(QMouseEvent *event);
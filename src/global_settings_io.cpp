@@ -67,6 +67,16 @@ double GlobalSettingsIO::temperature() const
     return m_temperature;
 }
 
+GlassLoadFilter GlobalSettingsIO::loadFilter() const
+{
+    return m_loadFilter;
+}
+
+QList<UserPropertyRegistry::Definition> GlobalSettingsIO::userProperties() const
+{
+    return m_userProperties;
+}
+
 void GlobalSettingsIO::setNumFiles(int n)
 {
     m_numFiles = n;
@@ -87,6 +97,16 @@ void GlobalSettingsIO::setTemperature(double t)
     m_temperature = t;
 }
 
+void GlobalSettingsIO::setLoadFilter(const GlassLoadFilter &filter)
+{
+    m_loadFilter = filter;
+}
+
+void GlobalSettingsIO::setUserProperties(const QList<UserPropertyRegistry::Definition> &definitions)
+{
+    m_userProperties = definitions;
+}
+
 void GlobalSettingsIO::loadIniFile()
 {
     m_settings->beginGroup("Preference");
@@ -103,7 +123,28 @@ void GlobalSettingsIO::loadIniFile()
     m_doShowResult = m_settings->value("ShowResult", false).toBool();
     m_temperature = m_settings->value("Temperature", 25).toDouble();
 
+    // load filter. Empty wavelength means no limit.
+    bool ok;
+    m_loadFilter.suppliers = m_settings->value("FilterSuppliers", QStringList()).toStringList();
+    m_loadFilter.statuses  = m_settings->value("FilterStatuses", QStringList()).toStringList();
+    m_loadFilter.rejectUnknownFormula = m_settings->value("FilterUnknownFormula", false).toBool();
+    m_loadFilter.requiredLambdaMin = m_settings->value("FilterLambdaMin", "").toDouble(&ok);
+    if(!ok) m_loadFilter.requiredLambdaMin = NAN;
+    m_loadFilter.requiredLambdaMax = m_settings->value("FilterLambdaMax", "").toDouble(&ok);
+    if(!ok) m_loadFilter.requiredLambdaMax = NAN;
+
     m_settings->endGroup();
+
+    m_userProperties.clear();
+    int count = m_settings->beginReadArray("UserProperties");
+    for(int i = 0; i < count; i++){
+        m_settings->setArrayIndex(i);
+        UserPropertyRegistry::Definition def;
+        def.name       = m_settings->value("Name", "").toString();
+        def.expression = m_settings->value("Expression", "").toString();
+        m_userProperties.append(def);
+    }
+    m_settings->endArray();
 }
 
 void GlobalSettingsIO::saveIniFile()
@@ -120,7 +161,23 @@ void GlobalSettingsIO::saveIniFile()
     m_settings->setValue("ShowResult", m_doShowResult);
     m_settings->setValue("Temperature", m_temperature);
 
+    m_settings->setValue("FilterSuppliers", m_loadFilter.suppliers);
+    m_settings->setValue("FilterStatuses", m_loadFilter.statuses);
+    m_settings->setValue("FilterUnknownFormula", m_loadFilter.rejectUnknownFormula);
+    m_settings->setValue("FilterLambdaMin", qIsNaN(m_loadFilter.requiredLambdaMin) ? QString("") : QString::number(m_loadFilter.requiredLambdaMin));
+    m_settings->setValue("FilterLambdaMax", qIsNaN(m_loadFilter.requiredLambdaMax) ? QString("") : QString::number(m_loadFilter.requiredLambdaMax));
+
     m_settings->endGroup();
+
+    m_settings->remove("UserProperties");
+    m_settings->beginWriteArray("UserProperties", m_userProperties.size());
+    for(int i = 0; i < m_userProperties.size(); i++){
+        m_settings->setArrayIndex(i);
+        m_settings->setValue("Name", m_userProperties[i].name);
+        m_settings->setValue("Expression", m_userProperties[i].expression);
+    }
+    m_settings->endArray();
+
     m_settings->sync();
 }
 
@@ -26,6 +26,8 @@
 #define GLOBAL_SETTINGS_IO_H
 
 #include <QSettings>
+#include "glass_load_filter.h"
+#include "user_property_registry.h"
 
 /** Preference settings io */
 class GlobalSettingsIO
@@ -43,11 +45,15 @@ public:
     QStringList defaultFilePaths() const;
     bool doShowResult() const;
     double temperature() const;
+    GlassLoadFilter loadFilter() const;
+    QList<UserPropertyRegistry::Definition> userProperties() const;
 
     void setNumFiles(int n);
     void setDefaultFilePaths(QStringList filepaths);
     void setDoShowResult(bool status);
     void setTemperature(double t);
+    void setLoadFilter(const GlassLoadFilter& filter);
+    void setUserProperties(const QList<UserPropertyRegistry::Definition>& definitions);
 
 private:
     QString iniFilePath;
@@ -58,6 +64,8 @@ private:
     QStringList m_defaultFilePaths;
     bool m_doShowResult;
     double m_temperature;
+    GlassLoadFilter m_loadFilter;
+    QList<UserPropertyRegistry::Definition> m_userProperties;
 };
 
 
@@ -0,0 +1,153 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "gzip_file_device.h"
+
+GzipFileDevice::GzipFileDevice(const QString& filePath) :
+    file_(filePath),
+    stream_initialized_(false),
+    stream_end_(false),
+    has_error_(false)
+{
+}
+
+GzipFileDevice::~GzipFileDevice()
+{
+    close();
+}
+
+bool GzipFileDevice::isGzipFile(const QString &filePath)
+{
+    return filePath.endsWith(".gz", Qt::CaseInsensitive);
+}
+
+bool GzipFileDevice::open(OpenMode mode)
+{
+    if(mode != QIODevice::ReadOnly){
+        setErrorString("Only read-only mode is supported");
+        return false;
+    }
+
+    if(!file_.open(QIODevice::ReadOnly)){
+        setErrorString(file_.errorString());
+        return false;
+    }
+
+    stream_.zalloc   = Z_NULL;
+    stream_.zfree    = Z_NULL;
+    stream_.opaque   = Z_NULL;
+    stream_.next_in  = Z_NULL;
+    stream_.avail_in = 0;
+
+    // 15 + 32: maximum window size with automatic gzip/zlib header detection
+    if(inflateInit2(&stream_, 15 + 32) != Z_OK){
+        setErrorString("Failed to initialize zlib");
+        file_.close();
+        return false;
+    }
+
+    stream_initialized_ = true;
+    stream_end_ = false;
+    has_error_  = false;
+
+    return QIODevice::open(mode);
+}
+
+void GzipFileDevice::close()
+{
+    if(stream_initialized_){
+        inflateEnd(&stream_);
+        stream_initialized_ = false;
+    }
+    file_.close();
+    input_.clear();
+
+    if(isOpen()){
+        QIODevice::close();
+    }
+}
+
+bool GzipFileDevice::atEnd() const
+{
+    return stream_end_ && QIODevice::atEnd();
+}
+
+qint64 GzipFileDevice::readData(char *data, qint64 maxlen)
+{
+    if(!stream_initialized_ || has_error_){
+        return -1;
+    }
+
+    qint64 total = 0;
+
+    // fill the request as far as possible so that callers get full chunks
+    while(total < maxlen && !stream_end_)
+    {
+        if(0 == stream_.avail_in){
+            input_ = file_.read(chunk_size_);
+            if(input_.isEmpty()){
+                // truncated file
+                has_error_ = true;
+                setErrorString("Unexpected end of compressed data");
+                break;
+            }
+            stream_.next_in  = reinterpret_cast<Bytef*>(input_.data());
+            stream_.avail_in = static_cast<uInt>(input_.size());
+        }
+
+        qint64 request = qMin<qint64>(maxlen - total, chunk_size_);
+        stream_.next_out  = reinterpret_cast<Bytef*>(data + total);
+        stream_.avail_out = static_cast<uInt>(request);
+
+        int ret = inflate(&stream_, Z_NO_FLUSH);
+        total += request - stream_.avail_out;
+
+        if(Z_STREAM_END == ret){
+            // concatenated gzip members
+            if(stream_.avail_in > 0 || !file_.atEnd()){
+                inflateReset(&stream_);
+            }else{
+                stream_end_ = true;
+            }
+        }
+        else if(Z_OK != ret && Z_BUF_ERROR != ret){
+            has_error_ = true;
+            setErrorString(stream_.msg ? QString(stream_.msg) : QString("Decompression error"));
+            break;
+        }
+    }
+
+    if(0 == total && has_error_){
+        return -1;
+    }
+
+    return total;
+}
+
+qint64 GzipFileDevice::writeData(const char *data, qint64 len)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+    return -1;
+}
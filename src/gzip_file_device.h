@@ -0,0 +1,69 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef GZIP_FILE_DEVICE_H
+#define GZIP_FILE_DEVICE_H
+
+#include <QIODevice>
+#include <QFile>
+#include <QByteArray>
+#include <zlib.h>
+
+/**
+ * @brief Read-only sequential device which decompresses a gzip file chunk by chunk
+ * @details Only one chunk of compressed data is held at a time, so the whole file is never inflated into memory by the device itself.
+ */
+class GzipFileDevice : public QIODevice
+{
+public:
+    explicit GzipFileDevice(const QString& filePath);
+    ~GzipFileDevice();
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override{ return true; }
+    bool atEnd() const override;
+
+    /** Check if decompression has failed. Data read before the failure is incomplete. */
+    bool hasError() const{ return has_error_; }
+
+    /** Check the file name suffix */
+    static bool isGzipFile(const QString& filePath);
+
+protected:
+    qint64 readData(char* data, qint64 maxlen) override;
+    qint64 writeData(const char* data, qint64 len) override;
+
+private:
+    static const int chunk_size_ = 64*1024;
+
+    QFile      file_;
+    QByteArray input_;
+    z_stream   stream_;
+    bool       stream_initialized_;
+    bool       stream_end_;
+    bool       has_error_;
+};
+
+#endif // GZIP_FILE_DEVICE_H
@@ -24,6 +24,8 @@
 
 #include "load_catalog_result_dialog.h"
 #include "ui_load_catalog_result_dialog.h"
+#include "load_diagnostics_model.h"
+#include <QHeaderView>
 
 
 LoadCatalogResultDialog::LoadCatalogResultDialog(QWidget *parent) :
@@ -34,7 +36,21 @@ LoadCatalogResultDialog::LoadCatalogResultDialog(QWidget *parent) :
 
     this->setWindowTitle("File Loading Result");
 
-    connect(ui->pushButton_OK, SIGNAL(clicked()), this, SLOT(accept()));
+    m_model = new LoadDiagnosticsModel(this);
+    m_proxyModel = new LoadDiagnosticsFilterProxy(this);
+    m_proxyModel->setSourceModel(m_model);
+    ui->tableView_Result->setModel(m_proxyModel);
+    ui->tableView_Result->verticalHeader()->setDefaultSectionSize(ui->tableView_Result->fontMetrics().height() + 4);
+    ui->tableView_Result->horizontalHeader()->setStretchLastSection(true);
+
+    ui->comboBox_Code->addItem("All", -1);
+    for(int i = 0; i < LoadDiagnostics::CodeCount; i++){
+        ui->comboBox_Code->addItem(LoadDiagnostics::codeText(static_cast<LoadDiagnostics::Code>(i)), i);
+    }
+
+    connect(ui->comboBox_Code,  SIGNAL(currentIndexChanged(int)),     this, SLOT(onCodeChanged(int)));
+    connect(ui->lineEdit_Filter, SIGNAL(textChanged(QString)),        this, SLOT(onFilterTextChanged(QString)));
+    connect(ui->pushButton_OK,  SIGNAL(clicked()), this, SLOT(accept()));
 }
 
 LoadCatalogResultDialog::~LoadCatalogResultDialog()
@@ -47,8 +63,20 @@ void LoadCatalogResultDialog::setLabel(QString labeltext)
     ui->label->setText(labeltext);
 }
 
-void LoadCatalogResultDialog::setText(QString text)
+void LoadCatalogResultDialog::setDiagnostics(const LoadDiagnostics &diagnostics)
+{
+    m_model->setDiagnostics(diagnostics);
+    ui->label_Summary->setText(diagnostics.summary());
+    ui->tableView_Result->resizeColumnsToContents();
+}
+
+void LoadCatalogResultDialog::onCodeChanged(int index)
+{
+    m_proxyModel->setCode(ui->comboBox_Code->itemData(index).toInt());
+}
+
+void LoadCatalogResultDialog::onFilterTextChanged(const QString &text)
 {
-    ui->textEdit_Result->setText(text);
+    m_proxyModel->setText(text);
 }
 
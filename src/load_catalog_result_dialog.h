@@ -26,6 +26,10 @@
 #define LOAD_CATALOG_RESULT_DIALOG_H
 
 #include <QDialog>
+#include "load_diagnostics.h"
+
+class LoadDiagnosticsModel;
+class LoadDiagnosticsFilterProxy;
 
 namespace Ui {
 class LoadCatalogResultDialog;
@@ -40,10 +44,16 @@ public:
     ~LoadCatalogResultDialog();
 
     void setLabel(QString labeltext);
-    void setText(QString text);
+    void setDiagnostics(const LoadDiagnostics& diagnostics);
+
+private slots:
+    void onCodeChanged(int index);
+    void onFilterTextChanged(const QString& text);
 
 private:
     Ui::LoadCatalogResultDialog *ui;
+    LoadDiagnosticsModel* m_model;
+    LoadDiagnosticsFilterProxy* m_proxyModel;
 };
 
 #endif // LOAD_CATALOG_RESULT_DIALOG_H
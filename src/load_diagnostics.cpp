@@ -0,0 +1,145 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "load_diagnostics.h"
+#include <QFileInfo>
+
+LoadDiagnostics::LoadDiagnostics(int maxRecords)
+{
+    max_records_ = maxRecords;
+    clear();
+}
+
+void LoadDiagnostics::clear()
+{
+    current_file_ = -1;
+    total_count_  = 0;
+    file_names_.clear();
+    records_.clear();
+    code_counts_.fill(0, CodeCount);
+}
+
+int LoadDiagnostics::beginFile(const QString &filePath)
+{
+    QString filename = QFileInfo(filePath).fileName();
+    if(current_file_ < 0 || file_names_[current_file_] != filename){
+        file_names_.append(filename);
+        current_file_ = file_names_.size() - 1;
+    }
+    return current_file_;
+}
+
+void LoadDiagnostics::add(Code code, const QString &glassName, int line)
+{
+    code_counts_[code]++;
+    total_count_++;
+
+    if(records_.size() < max_records_){
+        Record rec;
+        rec.fileIndex = current_file_;
+        rec.line      = line;
+        rec.code      = code;
+        rec.glassName = glassName;
+        records_.append(rec);
+    }
+}
+
+void LoadDiagnostics::append(const LoadDiagnostics &other)
+{
+    const int fileOffset = file_names_.size();
+    file_names_.append(other.file_names_);
+
+    for(auto &rec : other.records_){
+        if(records_.size() >= max_records_){
+            break;
+        }
+        Record copied = rec;
+        copied.fileIndex = (rec.fileIndex < 0) ? -1 : rec.fileIndex + fileOffset;
+        records_.append(copied);
+    }
+
+    for(int i = 0; i < CodeCount; i++){
+        code_counts_[i] += other.code_counts_[i];
+    }
+    total_count_ += other.total_count_;
+    current_file_ = file_names_.size() - 1;
+}
+
+QString LoadDiagnostics::fileName(int fileIndex) const
+{
+    if(fileIndex < 0 || fileIndex >= file_names_.size()){
+        return QString();
+    }
+    return file_names_[fileIndex];
+}
+
+QString LoadDiagnostics::summary() const
+{
+    QString text;
+    for(int i = 0; i < CodeCount; i++){
+        if(code_counts_[i] > 0){
+            text += codeText(static_cast<Code>(i)) + ": " + QString::number(code_counts_[i]) + "\n";
+        }
+    }
+    if(droppedCount() > 0){
+        text += QString::number(droppedCount()) + " records are not listed\n";
+    }
+    return text;
+}
+
+QString LoadDiagnostics::codeText(Code code)
+{
+    switch (code) {
+    case UnknownFormula:
+        return "Unknown dispersion formula";
+    case ThermalDataNotFound:
+        return "Thermal Data Not Found";
+    case OtherDataNotFound:
+        return "Other Data Not Found";
+    case TransmittanceDataNotFound:
+        return "Transmittance Data Not Found";
+    case LowCTENotFound:
+        return "Not found LowCTE";
+    case HighCTENotFound:
+        return "Not found HighCTE";
+    case AcidResistNotFound:
+        return "Not found Acid Resist";
+    case ClimateResistNotFound:
+        return "Not found Climate Resist";
+    case StainResistNotFound:
+        return "Not found Stain Resist";
+    case AlkaliResistNotFound:
+        return "Not found Alkali Resist";
+    case SkippedByFilter:
+        return "Skipped by the load filter";
+    case LoadError:
+        return "Catalog loading error";
+    case DeferredDataError:
+        return "Deferred data could not be decoded";
+    case DecompressionError:
+        return "Compressed data could not be decompressed";
+    default:
+        return "";
+    }
+}
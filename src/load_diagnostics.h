@@ -0,0 +1,105 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef LOAD_DIAGNOSTICS_H
+#define LOAD_DIAGNOSTICS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief Notable results of parsing catalog files
+ * @details Records are kept up to the given limit, while the counters per code are always exact.
+ */
+class LoadDiagnostics
+{
+public:
+    enum Code{
+        UnknownFormula,
+        ThermalDataNotFound,
+        OtherDataNotFound,
+        TransmittanceDataNotFound,
+        LowCTENotFound,
+        HighCTENotFound,
+        AcidResistNotFound,
+        ClimateResistNotFound,
+        StainResistNotFound,
+        AlkaliResistNotFound,
+        SkippedByFilter,
+        LoadError,
+        DeferredDataError,
+        DecompressionError,
+        CodeCount
+    };
+
+    struct Record{
+        int     fileIndex;
+        int     line; // 0 if not available
+        Code    code;
+        QString glassName;
+    };
+
+    explicit LoadDiagnostics(int maxRecords = 10000);
+
+    /**
+     * @brief Set the file to which the following records belong
+     * @return index of the file
+     */
+    int beginFile(const QString& filePath);
+
+    void add(Code code, const QString& glassName = QString(), int line = 0);
+
+    /** Append the files and records of the other diagnostics */
+    void append(const LoadDiagnostics& other);
+
+    void clear();
+    bool isEmpty() const{ return (0 == total_count_); }
+
+    /** number of stored records */
+    int size() const{ return records_.size(); }
+    const Record& record(int i) const{ return records_[i]; }
+
+    QString fileName(int fileIndex) const;
+    int count(Code code) const{ return code_counts_[code]; }
+    int totalCount() const{ return total_count_; }
+
+    /** number of records which were counted but not stored */
+    int droppedCount() const{ return total_count_ - records_.size(); }
+
+    /** one line per code which has occurred */
+    QString summary() const;
+
+    static QString codeText(Code code);
+
+private:
+    int max_records_;
+    int current_file_;
+    int total_count_;
+    QStringList file_names_;
+    QVector<Record> records_;
+    QVector<int> code_counts_;
+};
+
+#endif // LOAD_DIAGNOSTICS_H
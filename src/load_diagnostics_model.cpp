@@ -0,0 +1,137 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "load_diagnostics_model.h"
+
+LoadDiagnosticsModel::LoadDiagnosticsModel(QObject *parent) :
+    QAbstractTableModel(parent)
+{
+}
+
+void LoadDiagnosticsModel::setDiagnostics(const LoadDiagnostics &diagnostics)
+{
+    beginResetModel();
+    m_diagnostics = diagnostics;
+    endResetModel();
+}
+
+int LoadDiagnosticsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_diagnostics.size();
+}
+
+int LoadDiagnosticsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant LoadDiagnosticsModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || index.row() >= m_diagnostics.size()){
+        return QVariant();
+    }
+
+    const LoadDiagnostics::Record& rec = m_diagnostics.record(index.row());
+
+    if(CodeRole == role){
+        return static_cast<int>(rec.code);
+    }
+
+    if(Qt::DisplayRole != role){
+        return QVariant();
+    }
+
+    switch (index.column()) {
+    case ColumnFile:
+        return m_diagnostics.fileName(rec.fileIndex);
+    case ColumnLine:
+        return (rec.line > 0) ? QVariant(rec.line) : QVariant();
+    case ColumnGlass:
+        return rec.glassName;
+    case ColumnMessage:
+        return LoadDiagnostics::codeText(rec.code);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant LoadDiagnosticsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(Qt::DisplayRole != role || Qt::Horizontal != orientation){
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case ColumnFile:
+        return "File";
+    case ColumnLine:
+        return "Line";
+    case ColumnGlass:
+        return "Glass";
+    case ColumnMessage:
+        return "Message";
+    default:
+        return QVariant();
+    }
+}
+
+
+LoadDiagnosticsFilterProxy::LoadDiagnosticsFilterProxy(QObject *parent) :
+    QSortFilterProxyModel(parent)
+{
+    m_code = -1;
+}
+
+void LoadDiagnosticsFilterProxy::setCode(int code)
+{
+    m_code = code;
+    invalidateFilter();
+}
+
+void LoadDiagnosticsFilterProxy::setText(const QString &text)
+{
+    m_text = text;
+    invalidateFilter();
+}
+
+bool LoadDiagnosticsFilterProxy::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
+{
+    QAbstractItemModel* model = sourceModel();
+
+    if(m_code >= 0){
+        if(model->index(source_row, 0, source_parent).data(LoadDiagnosticsModel::CodeRole).toInt() != m_code){
+            return false;
+        }
+    }
+
+    if(!m_text.isEmpty()){
+        QString filename  = model->index(source_row, LoadDiagnosticsModel::ColumnFile,  source_parent).data().toString();
+        QString glassname = model->index(source_row, LoadDiagnosticsModel::ColumnGlass, source_parent).data().toString();
+        if(!filename.contains(m_text, Qt::CaseInsensitive) && !glassname.contains(m_text, Qt::CaseInsensitive)){
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef LOAD_DIAGNOSTICS_MODEL_H
+#define LOAD_DIAGNOSTICS_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QSortFilterProxyModel>
+#include "load_diagnostics.h"
+
+/** Table model to show diagnostics records in a view without copying them into items */
+class LoadDiagnosticsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column{
+        ColumnFile,
+        ColumnLine,
+        ColumnGlass,
+        ColumnMessage,
+        ColumnCount
+    };
+
+    /** role to get the code of the record */
+    static const int CodeRole = Qt::UserRole;
+
+    explicit LoadDiagnosticsModel(QObject* parent = nullptr);
+
+    void setDiagnostics(const LoadDiagnostics& diagnostics);
+    const LoadDiagnostics& diagnostics() const{ return m_diagnostics; }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    LoadDiagnostics m_diagnostics;
+};
+
+
+/** Filter records by code and by text in file or glass name */
+class LoadDiagnosticsFilterProxy : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit LoadDiagnosticsFilterProxy(QObject* parent = nullptr);
+
+    /** -1 for all codes */
+    void setCode(int code);
+    void setText(const QString& text);
+
+protected:
+    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
+
+private:
+    int m_code;
+    QString m_text;
+};
+
+#endif // LOAD_DIAGNOSTICS_MODEL_H
@@ -23,11 +23,25 @@
  *****************************************************************************/
 
 #include "main_window.h"
+#include "glass_snap_command.h"
+#include "prescription_audit_command.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
+    // batch snapping runs without the window
+    if(GlassSnapCommand::isRequested(argc, argv)){
+        QCoreApplication app(argc, argv);
+        return GlassSnapCommand::run(app.arguments());
+    }
+
+    // so does batch audit of prescriptions
+    if(PrescriptionAuditCommand::isRequested(argc, argv)){
+        QCoreApplication app(argc, argv);
+        return PrescriptionAuditCommand::run(app.arguments());
+    }
+
     QApplication a(argc, argv);
     //a.setStyle("fusion"); //for windows, it looks better.
     MainWindow w;
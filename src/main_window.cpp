@@ -27,7 +27,11 @@
 #include "ui_main_window.h"
 
 #include <QFileDialog>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
 #include <QMessageBox>
+#include <QInputDialog>
 
 #include "glassmap_form.h"
 #include "dispersion_plot_form.h"
@@ -36,8 +40,19 @@
 #include "dndt_plot_form.h"
 #include "catalog_view_form.h"
 #include "glass_search_form.h"
+#include "glass_substitution_form.h"
+#include "achromat_search_form.h"
+#include "apochromat_search_form.h"
+#include "pareto_front_form.h"
+#include "melt_tolerance_form.h"
 #include "load_catalog_result_dialog.h"
 #include "preference_dialog.h"
+#include "user_property_dialog.h"
+#include "catalog_view_setting_dialog.h"
+#include "catalog_exporter.h"
+#include "glass_equivalence_table.h"
+#include "catalog_diff.h"
+#include "glass_property_table.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -51,7 +66,11 @@ MainWindow::MainWindow(QWidget *parent)
     // File menu
     QObject::connect(ui->action_loadAGF,    SIGNAL(triggered()), this, SLOT(loadNewAGF()));
     QObject::connect(ui->action_loadXML,    SIGNAL(triggered()), this, SLOT(loadNewXML()));
+    QObject::connect(ui->action_ExportCatalogs, SIGNAL(triggered()), this, SLOT(exportCatalogs()));
+    QObject::connect(ui->action_ExportEquivalents, SIGNAL(triggered()), this, SLOT(exportEquivalents()));
+    QObject::connect(ui->action_CompareCatalogVersions, SIGNAL(triggered()), this, SLOT(compareCatalogVersions()));
     QObject::connect(ui->action_Preference, SIGNAL(triggered()), this, SLOT(showPreferenceDlg()));
+    QObject::connect(ui->action_UserProperties, SIGNAL(triggered()), this, SLOT(showUserPropertyDlg()));
 
     // Tools menu
     QObject::connect(ui->action_NdVd,              SIGNAL(triggered()),this, SLOT(showGlassMapNdVd()));
@@ -59,11 +78,17 @@ MainWindow::MainWindow(QWidget *parent)
     QObject::connect(ui->action_VdPgF,             SIGNAL(triggered()),this, SLOT(showGlassMapVdPgF()));
     QObject::connect(ui->action_VdPCt,             SIGNAL(triggered()),this, SLOT(showGlassMapVdPCt()));
     QObject::connect(ui->action_Buchdahl,          SIGNAL(triggered()),this, SLOT(showGlassMapBuchdahl()));
+    QObject::connect(ui->action_CustomGlassMap,    SIGNAL(triggered()),this, SLOT(showGlassMapCustom()));
     QObject::connect(ui->action_DispersionPlot,    SIGNAL(triggered()),this, SLOT(showDispersionPlot()));
     QObject::connect(ui->action_TransmittancePlot, SIGNAL(triggered()),this, SLOT(showTransmittancePlot()));
     QObject::connect(ui->action_DnDtabsPlot,       SIGNAL(triggered()),this, SLOT(showDnDtabsPlot()));
     QObject::connect(ui->action_CatalogView,       SIGNAL(triggered()),this, SLOT(showCatalogViewForm()));
     QObject::connect(ui->action_GlassSearch,       SIGNAL(triggered()),this, SLOT(showGlassSearchForm()));
+    QObject::connect(ui->action_GlassSubstitution, SIGNAL(triggered()),this, SLOT(showGlassSubstitutionForm()));
+    QObject::connect(ui->action_AchromatSearch,    SIGNAL(triggered()),this, SLOT(showAchromatSearchForm()));
+    QObject::connect(ui->action_ApochromatSearch,  SIGNAL(triggered()),this, SLOT(showApochromatSearchForm()));
+    QObject::connect(ui->action_ParetoFront,       SIGNAL(triggered()),this, SLOT(showParetoFrontForm()));
+    QObject::connect(ui->action_MeltTolerance,     SIGNAL(triggered()),this, SLOT(showMeltToleranceForm()));
 
     // Window menu
     QObject::connect(ui->action_Tile,    SIGNAL(triggered()),this, SLOT(tileWindows()));
@@ -79,8 +104,16 @@ MainWindow::MainWindow(QWidget *parent)
     // preference
     m_globalSettings = new GlobalSettingsIO;
     m_globalSettings->loadIniFile();
+    GlassCatalogManager::setLoadFilter(m_globalSettings->loadFilter());
+
+    QStringList userPropertyErrors;
+    if(UserPropertyRegistry::setValidDefinitions(m_globalSettings->userProperties(), &userPropertyErrors) > 0){
+        QMessageBox::warning(this, tr("User Properties"), "The following user properties were not loaded:\n" + userPropertyErrors.join("\n"));
+    }
 
     m_catalogManager = new GlassCatalogManager();
+    QObject::connect(m_catalogManager, SIGNAL(catalogReloaded(int)), this, SLOT(showCatalogReloadedMessage(int)));
+    QObject::connect(m_catalogManager, SIGNAL(catalogReloadFailed(QStringList,LoadDiagnostics)), this, SLOT(showCatalogReloadFailure(QStringList,LoadDiagnostics)));
 
     // loading default catalog files is in main.cpp
 }
@@ -106,8 +139,8 @@ void MainWindow::loadDefaultCatalogFiles()
         return;
     }
 
-    QString parseResult;
-    m_catalogManager->loadCatalogFiles(catalogFilePaths, parseResult);
+    LoadDiagnostics diagnostics;
+    m_catalogManager->loadCatalogFiles(catalogFilePaths, diagnostics);
 
     //set temperature
     double temperature = m_globalSettings->temperature();
@@ -116,7 +149,7 @@ void MainWindow::loadDefaultCatalogFiles()
     if(m_globalSettings->doShowResult()) {
         LoadCatalogResultDialog dlg(this);
         dlg.setLabel("Loading catalog files has been finished.\nBelows are notable parse results.");
-        dlg.setText(parseResult);
+        dlg.setDiagnostics(diagnostics);
         dlg.exec();
     }else{
         QMessageBox::information(this, tr("Info"), "Catalog files were newly loaded");
@@ -130,19 +163,19 @@ void MainWindow::loadNewAGF()
     QStringList filePaths = QFileDialog::getOpenFileNames(this,
                                                           tr("select AGF"),
                                                           QApplication::applicationDirPath(),
-                                                          tr("AGF files(*.agf);;All Files(*.*)"));
+                                                          tr("AGF files(*.agf *.agf.gz);;All Files(*.*)"));
     if(filePaths.empty()){
         QMessageBox::warning(this,tr("Canceled"), tr("Canceled"));
         return;
     }else{
         ui->mdiArea->closeAllSubWindows();
 
-        QString parseResult;
-        GlassCatalogManager::loadCatalogFiles(filePaths, parseResult);
+        LoadDiagnostics diagnostics;
+        GlassCatalogManager::loadCatalogFiles(filePaths, diagnostics);
         if(m_globalSettings->doShowResult()) {
             LoadCatalogResultDialog dlg(this);
             dlg.setLabel("Loading catalog files has been finished.\nBelows are notable parse results.");
-            dlg.setText(parseResult);
+            dlg.setDiagnostics(diagnostics);
             dlg.exec();
         }else{
             QMessageBox::information(this, tr("Info"), "Catalog files were newly loaded");
@@ -157,18 +190,18 @@ void MainWindow::loadNewXML()
     QStringList filePaths = QFileDialog::getOpenFileNames(this,
                                                           tr("select XML"),
                                                           QApplication::applicationDirPath(),
-                                                          tr("XML files(*.xml);;All Files(*.*)"));
+                                                          tr("XML files(*.xml *.xml.gz);;All Files(*.*)"));
     if(filePaths.empty()){
         QMessageBox::warning(this,tr("Canceled"), tr("Canceled"));
         return;
     } else {
         ui->mdiArea->closeAllSubWindows();
-        QString parseResult;
-        GlassCatalogManager::loadCatalogFiles(filePaths, parseResult);
+        LoadDiagnostics diagnostics;
+        GlassCatalogManager::loadCatalogFiles(filePaths, diagnostics);
         if(m_globalSettings->doShowResult()) {
             LoadCatalogResultDialog dlg(this);
             dlg.setLabel("Loading catalog files has been finished.\nBelows are notable parse results.");
-            dlg.setText(parseResult);
+            dlg.setDiagnostics(diagnostics);
             dlg.exec();
         }else{
             QMessageBox::information(this, tr("Info"), "Catalog files were newly loaded");
@@ -176,6 +209,128 @@ void MainWindow::loadNewXML()
     }
 }
 
+void MainWindow::exportCatalogs()
+{
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    if(snapshot->isEmpty()){
+        QMessageBox::warning(this, tr("Warning"), tr("No catalogs are loaded"));
+        return;
+    }
+
+    // select properties
+    QStringList properties = {"supplier", "name", "nd", "vd", "PgF"};
+    int digit = 17;
+    CatalogViewSettingDialog dlg(CatalogExporter::propertyNames(), properties, digit, this);
+    dlg.setWindowTitle("Export Catalogs");
+    if(dlg.exec() != QDialog::Accepted){
+        return;
+    }
+    dlg.getSettings(properties, digit);
+
+    QString csvFilter = tr("CSV files(*.csv)");
+    QString binaryFilter = tr("Binary column files(*.gpcol)");
+    QString selectedFilter;
+    QString filePath = QFileDialog::getSaveFileName(this,
+                                                    tr("Export Catalogs"),
+                                                    QApplication::applicationDirPath(),
+                                                    csvFilter + ";;" + binaryFilter,
+                                                    &selectedFilter);
+    if(filePath.isEmpty()){
+        return;
+    }
+
+    CatalogExporter exporter(snapshot);
+    exporter.setProperties(properties);
+    exporter.setDigit(digit);
+
+    CatalogExporter::Format format = (selectedFilter == binaryFilter) ? CatalogExporter::Binary : CatalogExporter::CSV;
+    if(exporter.exportToFile(filePath, format)){
+        QMessageBox::information(this, tr("Info"), QString::number(exporter.rowCount()) + " glasses were exported");
+    }else{
+        QMessageBox::warning(this, tr("Error"), tr("Failed to export: ") + exporter.errorString());
+    }
+}
+
+void MainWindow::exportEquivalents()
+{
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    if(snapshot->isEmpty()){
+        QMessageBox::warning(this, tr("Warning"), tr("No catalogs are loaded"));
+        return;
+    }
+
+    QString filePath = QFileDialog::getSaveFileName(this,
+                                                    tr("Export Glass Equivalents"),
+                                                    QApplication::applicationDirPath(),
+                                                    tr("CSV files(*.csv)"));
+    if(filePath.isEmpty()){
+        return;
+    }
+
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)){
+        QMessageBox::warning(this, tr("Error"), tr("Failed to export: ") + file.errorString());
+        return;
+    }
+
+    auto table = GlassEquivalenceTable::instance(snapshot);
+    QTextStream out(&file);
+    table->writeCsv(out);
+    file.close();
+
+    QMessageBox::information(this, tr("Info"), QString::number(table->clusterCount()) + " clusters were exported");
+}
+
+void MainWindow::compareCatalogVersions()
+{
+    const QString filter = tr("Catalog files(*.agf *.agf.gz *.xml *.xml.gz)");
+    QStringList beforePaths = QFileDialog::getOpenFileNames(this, tr("Select previous catalog files"), QApplication::applicationDirPath(), filter);
+    if(beforePaths.isEmpty()){
+        return;
+    }
+    QStringList afterPaths = QFileDialog::getOpenFileNames(this, tr("Select new catalog files"), QFileInfo(beforePaths.first()).absolutePath(), filter);
+    if(afterPaths.isEmpty()){
+        return;
+    }
+
+    QString filePath = QFileDialog::getSaveFileName(this,
+                                                    tr("Save Catalog Differences"),
+                                                    QApplication::applicationDirPath(),
+                                                    tr("CSV files(*.csv)"));
+    if(filePath.isEmpty()){
+        return;
+    }
+
+    QString errorMessage;
+    std::vector< std::unique_ptr<GlassCatalog> > beforeCatalogs, afterCatalogs;
+    if(!CatalogDiff::loadCatalogs(beforePaths, beforeCatalogs, &errorMessage) || !CatalogDiff::loadCatalogs(afterPaths, afterCatalogs, &errorMessage)){
+        QMessageBox::warning(this, tr("Error"), errorMessage);
+        return;
+    }
+
+    QList<const GlassCatalog*> before, after;
+    for(auto &cat : beforeCatalogs) before.append(cat.get());
+    for(auto &cat : afterCatalogs)  after.append(cat.get());
+
+    CatalogDiff diff;
+    diff.compare(before, after);
+
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)){
+        QMessageBox::warning(this, tr("Error"), tr("Failed to export: ") + file.errorString());
+        return;
+    }
+    QTextStream out(&file);
+    diff.writeCsv(out);
+    file.close();
+
+    QMessageBox::information(this, tr("Info"),
+                             QString::number(diff.count(CatalogDiff::Added)) + " added, " +
+                             QString::number(diff.count(CatalogDiff::Removed)) + " removed, " +
+                             QString::number(diff.count(CatalogDiff::Modified)) + " modified, " +
+                             QString::number(diff.unchangedCount()) + " unchanged");
+}
+
 
 void MainWindow::showPreferenceDlg()
 {
@@ -183,6 +338,8 @@ void MainWindow::showPreferenceDlg()
 
     PreferenceDialog* dlg = new PreferenceDialog(m_globalSettings, this);
     if(dlg->exec() == QDialog::Accepted){
+        GlassCatalogManager::setLoadFilter(m_globalSettings->loadFilter());
+
         int ans = QMessageBox::question(this, tr("Question"), tr("Setting has been updated. Will you load newly set catalog files?"));
         if(ans == QMessageBox::Yes){
             QStringList paths = dlg->getCatalogPaths();
@@ -199,6 +356,13 @@ void MainWindow::showPreferenceDlg()
 
 }
 
+void MainWindow::showUserPropertyDlg()
+{
+    UserPropertyDialog* dlg = new UserPropertyDialog(m_globalSettings, this);
+    dlg->exec();
+    delete dlg;
+}
+
 void MainWindow::showGlassMap(QString xdataname, QString ydataname, QCPRange xrange, QCPRange yrange, bool xreversed)
 {
     if(m_catalogManager->isEmpty()){
@@ -238,6 +402,44 @@ void MainWindow::showGlassMapBuchdahl()
     showGlassMap("eta2", "eta1",QCPRange(-0.025,0.175), QCPRange(-0.25,0.0), false);
 }
 
+void MainWindow::showGlassMapCustom()
+{
+    if(m_catalogManager->isEmpty()){
+        QMessageBox::warning(this,tr("Error"), tr("No catalog has been loaded."));
+        return;
+    }
+
+    QStringList names = Glass::valueNames() + UserPropertyRegistry::names();
+
+    bool ok;
+    QString xdataname = QInputDialog::getItem(this, tr("Custom Glass Map"), tr("X axis"), names, names.indexOf("vd"), false, &ok);
+    if(!ok) return;
+    QString ydataname = QInputDialog::getItem(this, tr("Custom Glass Map"), tr("Y axis"), names, names.indexOf("nd"), false, &ok);
+    if(!ok) return;
+
+    // auto range from all glasses
+    GlassPropertyTable table(GlassCatalogManager::snapshot(), QStringList({xdataname, ydataname}));
+    QVector<QCPRange> ranges;
+    for(int col = 0; col < 2; col++){
+        double lower = qInf(), upper = -qInf();
+        for(int row = 0; row < table.rowCount(); row++){
+            double v = table.value(row, col);
+            if(qIsFinite(v)){
+                lower = qMin(lower, v);
+                upper = qMax(upper, v);
+            }
+        }
+        if(lower > upper){
+            lower = 0.0;
+            upper = 1.0;
+        }
+        double margin = (upper > lower) ? 0.05*(upper - lower) : 0.5;
+        ranges.append(QCPRange(lower - margin, upper + margin));
+    }
+
+    showGlassMap(xdataname, ydataname, ranges[0], ranges[1], false);
+}
+
 
 
 template<class F> void MainWindow::showAnalysisForm()
@@ -279,6 +481,31 @@ void MainWindow::showGlassSearchForm()
     showAnalysisForm<GlassSearchForm>();
 }
 
+void MainWindow::showGlassSubstitutionForm()
+{
+    showAnalysisForm<GlassSubstitutionForm>();
+}
+
+void MainWindow::showAchromatSearchForm()
+{
+    showAnalysisForm<AchromatSearchForm>();
+}
+
+void MainWindow::showApochromatSearchForm()
+{
+    showAnalysisForm<ApochromatSearchForm>();
+}
+
+void MainWindow::showParetoFrontForm()
+{
+    showAnalysisForm<ParetoFrontForm>();
+}
+
+void MainWindow::showMeltToleranceForm()
+{
+    showAnalysisForm<MeltToleranceForm>();
+}
+
 void MainWindow::tileWindows()
 {
     ui->mdiArea->tileSubWindows();
@@ -294,6 +521,25 @@ void MainWindow::closeAll()
     ui->mdiArea->closeAllSubWindows();
 }
 
+void MainWindow::showCatalogReloadedMessage(int catalogIndex)
+{
+    GlassCatalog* catalog = GlassCatalogManager::snapshot()->catalog(catalogIndex);
+    if(!catalog){
+        return;
+    }
+    ui->statusbar->showMessage("Catalog reloaded: " + catalog->supplier() + " (" + catalog->filePath() + ")", 5000);
+}
+
+void MainWindow::showCatalogReloadFailure(const QStringList &filePaths, const LoadDiagnostics &diagnostics)
+{
+    ui->statusbar->showMessage("Catalog reloading failed: " + filePaths.join(", "), 5000);
+
+    LoadCatalogResultDialog dlg(this);
+    dlg.setLabel("Changed catalog files could not be reloaded. The previously loaded data are kept.\n" + filePaths.join("\n"));
+    dlg.setDiagnostics(diagnostics);
+    dlg.exec();
+}
+
 void MainWindow::showAbout()
 {
     QString text =
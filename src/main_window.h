@@ -65,18 +65,28 @@ private:
 private slots:
     void loadNewAGF();
     void loadNewXML();
+    void exportCatalogs();
+    void exportEquivalents();
+    void compareCatalogVersions();
     void showPreferenceDlg();
+    void showUserPropertyDlg();
 
     void showGlassMapNdVd();
     void showGlassMapNeVe();
     void showGlassMapVdPgF();
     void showGlassMapVdPCt();
     void showGlassMapBuchdahl();
+    void showGlassMapCustom();
     void showDispersionPlot();
     void showTransmittancePlot();
     void showDnDtabsPlot();
     void showCatalogViewForm();
     void showGlassSearchForm();
+    void showGlassSubstitutionForm();
+    void showAchromatSearchForm();
+    void showApochromatSearchForm();
+    void showParetoFrontForm();
+    void showMeltToleranceForm();
 
     void tileWindows();
     void cascadeWindows();
@@ -84,6 +94,12 @@ private slots:
 
     void showAbout();
 
+    /** Notify that a catalog has been reloaded after its file was changed */
+    void showCatalogReloadedMessage(int catalogIndex);
+
+    /** Show the parse results of changed catalog files which could not be reloaded */
+    void showCatalogReloadFailure(const QStringList& filePaths, const LoadDiagnostics& diagnostics);
+
 private:
     Ui::MainWindow *ui;
     GlobalSettingsIO* m_globalSettings;
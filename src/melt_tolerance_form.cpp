@@ -0,0 +1,234 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "melt_tolerance_form.h"
+#include "ui_melt_tolerance_form.h"
+
+#include <QElapsedTimer>
+#include <QMessageBox>
+#include <QRegularExpression>
+#include <QValidator>
+
+#include "glass_catalog_manager.h"
+#include "glass_constraint_index.h"
+
+namespace {
+
+// Samples of a glass are held in memory on the GUI thread, about 8 bytes per sample and value.
+// The limits keep a run within a few hundred MB and a few seconds.
+const int    kMaxSamplesPerGlass = 2000000;
+const qint64 kMaxTotalSamples    = 20000000;
+
+} // namespace
+
+MeltToleranceForm::MeltToleranceForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::MeltToleranceForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Melt Tolerance");
+
+    ui->comboBox_ndClass->addItems(MeltToleranceSimulation::ndClassNames());
+    ui->comboBox_ndClass->setCurrentIndex(ui->comboBox_ndClass->count() - 1);
+    ui->comboBox_vdClass->addItems(MeltToleranceSimulation::vdClassNames());
+    ui->comboBox_vdClass->setCurrentIndex(ui->comboBox_vdClass->count() - 1);
+    ui->comboBox_Distribution->addItems(MeltToleranceSimulation::distributionNames());
+    ui->comboBox_Distribution->setCurrentIndex(MeltToleranceSimulation::Normal);
+
+    ui->lineEdit_PgF->setValidator(new QDoubleValidator(0.0, 0.1, 6, this));
+    ui->lineEdit_PgF->setText("0.0005");
+    ui->lineEdit_SampleCount->setValidator(new QIntValidator(1, kMaxSamplesPerGlass, this));
+    ui->lineEdit_SampleCount->setText("1000000");
+    ui->lineEdit_Seed->setValidator(new QIntValidator(0, 2147483647, this));
+    ui->lineEdit_Seed->setText("1");
+    ui->lineEdit_FocalLength->setValidator(new QDoubleValidator(this));
+    ui->lineEdit_FocalLength->setText("100");
+
+    ui->tableWidget_Result->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ui->tableWidget_Result->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    m_customPlot = ui->widget_Histogram;
+    m_customPlot->xAxis->setNumberFormat("g");
+
+    QObject::connect(ui->pushButton_Run,     SIGNAL(clicked()), this, SLOT(runSimulation()));
+    QObject::connect(ui->tableWidget_Result, SIGNAL(itemSelectionChanged()), this, SLOT(showHistogram()));
+}
+
+MeltToleranceForm::~MeltToleranceForm()
+{
+    delete ui;
+}
+
+QVector<const Glass*> MeltToleranceForm::getGlasses(QString* errorMessage)
+{
+    QVector<const Glass*> glasses;
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+
+    // listed by name
+    QStringList names = ui->lineEdit_Glasses->text().split(QRegularExpression("[,;\\s]+"));
+    names.removeAll("");
+    if(!names.isEmpty()){
+        for(auto &name : names){
+            const Glass* g = snapshot->find(name);
+            if(!g){
+                *errorMessage = "Not found: " + name;
+                return QVector<const Glass*>();
+            }
+            glasses.append(g);
+        }
+        return glasses;
+    }
+
+    // all glasses which satisfy the conditions
+    auto index = GlassConstraintIndex::instance(snapshot);
+    GlassConstraintQuery query = GlassConstraintQuery::parse(ui->lineEdit_Constraint->text(), errorMessage);
+    QBitArray mask = index->select(query, errorMessage);
+    for(int r = 0; r < mask.size(); r++){
+        if(mask.testBit(r)){
+            glasses.append(index->table().glass(r));
+        }
+    }
+    return glasses;
+}
+
+void MeltToleranceForm::runSimulation()
+{
+    QString errorMessage;
+    QVector<const Glass*> glasses = getGlasses(&errorMessage);
+    if(!errorMessage.isEmpty()){
+        QMessageBox::warning(this, tr("Error"), errorMessage);
+        return;
+    }
+    if(glasses.isEmpty()){
+        QMessageBox::warning(this, tr("Error"), tr("No glass is selected"));
+        return;
+    }
+
+    const int sampleCount = ui->lineEdit_SampleCount->text().toInt();
+    if(sampleCount < 1 || sampleCount > kMaxSamplesPerGlass){
+        QMessageBox::warning(this, tr("Error"), QString("Samples per glass must be 1 to %1").arg(kMaxSamplesPerGlass));
+        return;
+    }
+    if(static_cast<qint64>(sampleCount)*glasses.size() > kMaxTotalSamples){
+        QMessageBox::warning(this, tr("Error"), QString("Samples per glass times %1 glasses must not exceed %2").arg(glasses.size()).arg(kMaxTotalSamples));
+        return;
+    }
+
+    const bool doublet = ui->checkBox_Doublet->isChecked();
+    if(doublet && glasses.size() < 2){
+        QMessageBox::warning(this, tr("Error"), tr("Doublet needs two glasses"));
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    MeltToleranceSimulation::Tolerance tolerance;
+    tolerance.nd         = MeltToleranceSimulation::ndClassTolerance(ui->comboBox_ndClass->currentIndex());
+    tolerance.vdRelative = MeltToleranceSimulation::vdClassTolerance(ui->comboBox_vdClass->currentIndex());
+    tolerance.PgF        = ui->lineEdit_PgF->text().toDouble();
+
+    MeltToleranceSimulation simulation(glasses);
+    simulation.setTolerance(tolerance);
+    simulation.setDistribution(static_cast<MeltToleranceSimulation::Distribution>(ui->comboBox_Distribution->currentIndex()));
+    simulation.setSeed(ui->lineEdit_Seed->text().toUInt());
+    simulation.setDoublet(doublet, ui->lineEdit_FocalLength->text().toDouble());
+    m_statistics = simulation.run(sampleCount);
+
+    //setup result table
+    QStringList hHeaderLabels({"Glass", "Quantity", "Nominal", "Mean", "Std Dev"});
+    for(double level : MeltToleranceSimulation::percentileLevels()){
+        hHeaderLabels.append("P" + QString::number(level));
+    }
+    ui->tableWidget_Result->clearContents();
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(m_statistics.size());
+    for(int i = 0; i < m_statistics.size(); i++)
+    {
+        const MeltToleranceSimulation::Statistics& s = m_statistics[i];
+        const int digit = ("nd" == s.quantity || "PgF" == s.quantity) ? 6 : 4;
+        setCellValue(ui->tableWidget_Result, i, 0, s.glass);
+        setCellValue(ui->tableWidget_Result, i, 1, s.quantity);
+        setCellValue(ui->tableWidget_Result, i, 2, numToQString(s.nominal, 'f', digit));
+        setCellValue(ui->tableWidget_Result, i, 3, numToQString(s.mean, 'f', digit));
+        setCellValue(ui->tableWidget_Result, i, 4, numToQString(s.stdDev, 'e', 2));
+        for(int j = 0; j < s.percentiles.size(); j++){
+            setCellValue(ui->tableWidget_Result, i, j+5, numToQString(s.percentiles[j], 'f', digit));
+        }
+    }
+    ui->tableWidget_Result->resizeColumnsToContents();
+
+    ui->label_Summary->setText(QString("%1 samples x %2 glasses in %3 ms")
+                               .arg(sampleCount)
+                               .arg(glasses.size())
+                               .arg(timer.elapsed()));
+
+    if(!m_statistics.isEmpty()){
+        ui->tableWidget_Result->selectRow(0);
+    }
+}
+
+void MeltToleranceForm::showHistogram()
+{
+    m_customPlot->clearPlottables();
+
+    int row = ui->tableWidget_Result->currentRow();
+    if(row < 0 || row >= m_statistics.size()){
+        m_customPlot->replot();
+        return;
+    }
+
+    const MeltToleranceSimulation::Statistics& s = m_statistics[row];
+    const int binCount = s.histogram.size();
+    const double width = (s.histogramMax - s.histogramMin)/qMax(binCount, 1);
+
+    QVector<double> x(binCount), y(binCount);
+    for(int i = 0; i < binCount; i++){
+        x[i] = s.histogramMin + (i + 0.5)*width;
+        y[i] = s.histogram[i];
+    }
+
+    QCPBars* bars = new QCPBars(m_customPlot->xAxis, m_customPlot->yAxis);
+    bars->setData(x, y);
+    bars->setWidth(width);
+    bars->setName(s.glass + " " + s.quantity);
+
+    m_customPlot->xAxis->setLabel(s.quantity);
+    m_customPlot->yAxis->setLabel("Count");
+    m_customPlot->rescaleAxes();
+    m_customPlot->replot();
+}
+
+void MeltToleranceForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
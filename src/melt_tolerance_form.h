@@ -0,0 +1,80 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef MELT_TOLERANCE_FORM_H
+#define MELT_TOLERANCE_FORM_H
+
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+
+#include "qcustomplot.h"
+#include "melt_tolerance_simulation.h"
+
+namespace Ui {
+class MeltToleranceForm;
+}
+
+/** Form for Monte Carlo melt tolerance analysis of glasses and a doublet */
+class MeltToleranceForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MeltToleranceForm(QMdiArea *parent = nullptr);
+    ~MeltToleranceForm();
+
+private slots:
+    /** Run the simulation and show result */
+    void runSimulation();
+
+    /** Plot histogram of the current result row */
+    void showHistogram();
+
+private:
+    /** glasses listed by name, or all glasses which satisfy the conditions */
+    QVector<const Glass*> getGlasses(QString* errorMessage);
+
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+    inline QString numToQString(double val, char fmt='f', int digit=6);
+
+    Ui::MeltToleranceForm *ui;
+    QMdiArea*    m_parentMdiArea;
+    QCustomPlot* m_customPlot;
+
+    QVector<MeltToleranceSimulation::Statistics> m_statistics;
+};
+
+
+QString MeltToleranceForm::numToQString(double val, char fmt, int digit)
+{
+    if(qIsNaN(val)){
+        return "-";
+    }
+    else{
+        return QString::number(val,fmt,digit);
+    }
+}
+
+#endif // MELT_TOLERANCE_FORM_H
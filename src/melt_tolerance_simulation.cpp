@@ -0,0 +1,223 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "melt_tolerance_simulation.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <QtMath>
+#include <QtConcurrent>
+
+#include "glass.h"
+
+namespace {
+
+const int kSampleChunkSize = 65536;
+
+const double kNdClassTolerances[] = {0.0002, 0.0003, 0.0005};
+const double kVdClassTolerances[] = {0.002, 0.003, 0.005, 0.008};
+
+double vdOf(const double* n){ return (n[0] - 1.0)/(n[1] - n[2]); }
+double pgfOf(const double* n){ return (n[3] - n[1])/(n[1] - n[2]); }
+
+} // namespace
+
+MeltToleranceSimulation::MeltToleranceSimulation(const QVector<const Glass*> &glasses)
+    : glasses_(glasses),
+      distribution_(Normal),
+      seed_(1),
+      bin_count_(50),
+      doublet_(false),
+      focal_length_(100.0)
+{
+    tolerance_.nd         = kNdClassTolerances[2];
+    tolerance_.vdRelative = kVdClassTolerances[3];
+    tolerance_.PgF        = 0.0;
+
+    const QStringList lines({"d", "F", "C", "g"});
+    indices_.resize(glasses_.size()*LineCount);
+    for(int i = 0; i < glasses_.size(); i++){
+        for(int j = 0; j < LineCount; j++){
+            indices_[i*LineCount + j] = glasses_[i]->refractiveIndex(lines[j]);
+        }
+    }
+}
+
+QStringList MeltToleranceSimulation::ndClassNames()
+{
+    return QStringList({"Step 1 (+/-0.0002)", "Step 2 (+/-0.0003)", "Step 3 (+/-0.0005)"});
+}
+
+double MeltToleranceSimulation::ndClassTolerance(int n)
+{
+    return kNdClassTolerances[qBound(0, n, 2)];
+}
+
+QStringList MeltToleranceSimulation::vdClassNames()
+{
+    return QStringList({"Step 1 (+/-0.2%)", "Step 2 (+/-0.3%)", "Step 3 (+/-0.5%)", "Step 4 (+/-0.8%)"});
+}
+
+double MeltToleranceSimulation::vdClassTolerance(int n)
+{
+    return kVdClassTolerances[qBound(0, n, 3)];
+}
+
+QStringList MeltToleranceSimulation::distributionNames()
+{
+    return QStringList({"Uniform", "Normal (3 sigma)"});
+}
+
+QVector<double> MeltToleranceSimulation::percentileLevels()
+{
+    return QVector<double>({1.0, 5.0, 50.0, 95.0, 99.0});
+}
+
+void MeltToleranceSimulation::sample(int glassIndex, int sampleCount, QVector<double> &nd, QVector<double> &vd, QVector<double> &pgf) const
+{
+    nd.resize(sampleCount);
+    vd.resize(sampleCount);
+    pgf.resize(sampleCount);
+
+    const double* n = indices_.constData() + glassIndex*LineCount;
+    const double dispersion = n[F] - n[C];
+    const double uF = (n[F] - n[D])/dispersion;
+    const double uC = (n[C] - n[D])/dispersion;
+    const double uG = (n[G] - n[D])/dispersion;
+    auto q = [uF, uC](double u){ return u*(u - uF - uC); };
+    const double dq = q(uG) - q(uF); // change of PgF per unit c
+
+    QVector<int> chunks;
+    for(int begin = 0; begin < sampleCount; begin += kSampleChunkSize){
+        chunks.append(begin);
+    }
+
+    QtConcurrent::blockingMap(chunks, [&](int begin){
+        std::seed_seq seq({seed_, static_cast<quint32>(glassIndex), static_cast<quint32>(begin/kSampleChunkSize)});
+        std::mt19937 rng(seq);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        std::normal_distribution<double>       normal(0.0, 1.0/3.0);
+        auto draw = [&](){ return (Uniform == distribution_) ? uniform(rng) : normal(rng); };
+
+        const int end = qMin(begin + kSampleChunkSize, sampleCount);
+        for(int i = begin; i < end; i++){
+            const double dnd = tolerance_.nd*draw();
+            const double dvd = tolerance_.vdRelative*draw();
+            const double dpg = tolerance_.PgF*draw();
+
+            // perturbed indices at the lines
+            const double c     = (dq != 0.0) ? dpg/dq : 0.0;
+            const double scale = (1.0 + dnd/(n[D] - 1.0))/(1.0 + dvd);
+            double p[LineCount];
+            for(int j = 0; j < LineCount; j++){
+                const double m = n[j] + c*dispersion*q((n[j] - n[D])/dispersion);
+                p[j] = n[D] + dnd + (m - n[D])*scale;
+            }
+
+            nd[i]  = p[D];
+            vd[i]  = vdOf(p);
+            pgf[i] = pgfOf(p);
+        }
+    });
+}
+
+MeltToleranceSimulation::Statistics MeltToleranceSimulation::summarize(const QString &glass, const QString &quantity, double nominal, QVector<double> &values) const
+{
+    Statistics s;
+    s.glass    = glass;
+    s.quantity = quantity;
+    s.nominal  = nominal;
+
+    const int count = values.size();
+    if(0 == count){
+        s.mean = s.stdDev = s.histogramMin = s.histogramMax = qQNaN();
+        return s;
+    }
+
+    s.mean = std::accumulate(values.begin(), values.end(), 0.0)/count;
+    double sum2 = 0.0;
+    for(double v : values){
+        sum2 += (v - s.mean)*(v - s.mean);
+    }
+    s.stdDev = (count > 1) ? sqrt(sum2/(count - 1)) : 0.0;
+
+    std::sort(values.begin(), values.end());
+    for(double level : percentileLevels()){
+        s.percentiles.append(values[qBound(0, static_cast<int>(level/100.0*(count - 1) + 0.5), count - 1)]);
+    }
+
+    s.histogramMin = values.first();
+    s.histogramMax = values.last();
+    s.histogram.fill(0, bin_count_);
+    const double width = (s.histogramMax - s.histogramMin)/bin_count_;
+    for(double v : values){
+        int bin = (width > 0.0) ? static_cast<int>((v - s.histogramMin)/width) : 0;
+        s.histogram[qMin(bin, bin_count_ - 1)]++;
+    }
+
+    return s;
+}
+
+QVector<MeltToleranceSimulation::Statistics> MeltToleranceSimulation::run(int sampleCount)
+{
+    QVector<Statistics> result;
+    QVector<double> nd, vd, pgf;
+    QVector<double> vdPair[2], pgfPair[2];
+
+    for(int i = 0; i < glasses_.size(); i++){
+        sample(i, sampleCount, nd, vd, pgf);
+
+        const double* n = indices_.constData() + i*LineCount;
+        const QString name = glasses_[i]->fullName();
+
+        // the samples of the doublet glasses are kept before sorted
+        if(doublet_ && i < 2){
+            vdPair[i]  = vd;
+            pgfPair[i] = pgf;
+        }
+
+        result.append(summarize(name, "nd",  n[D],      nd));
+        result.append(summarize(name, "vd",  vdOf(n),   vd));
+        result.append(summarize(name, "PgF", pgfOf(n),  pgf));
+    }
+
+    if(doublet_ && glasses_.size() >= 2){
+        const double* na = indices_.constData();
+        const double* nb = indices_.constData() + LineCount;
+        const double va = vdOf(na), vb = vdOf(nb);
+
+        QVector<double> power(sampleCount), secondary(sampleCount);
+        for(int i = 0; i < sampleCount; i++){
+            const double dv = vdPair[0][i] - vdPair[1][i];
+            power[i]     = vdPair[0][i]/dv;
+            secondary[i] = -focal_length_*(pgfPair[0][i] - pgfPair[1][i])/dv;
+        }
+
+        result.append(summarize("Doublet", "Crown Power",         va/(va - vb),                                     power));
+        result.append(summarize("Doublet", "Secondary Spectrum",  -focal_length_*(pgfOf(na) - pgfOf(nb))/(va - vb), secondary));
+    }
+
+    return result;
+}
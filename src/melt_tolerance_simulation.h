@@ -0,0 +1,117 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef MELT_TOLERANCE_SIMULATION_H
+#define MELT_TOLERANCE_SIMULATION_H
+
+#include <QVector>
+#include <QStringList>
+
+class Glass;
+
+/**
+ * @brief Monte Carlo simulation of glass properties within melt tolerances
+ * @details
+ * The indices of each glass at the d, F, C and g lines are computed once, and each sample perturbs them as
+ *  n'(l) = nd + dnd + (m(l) - nd)*(1 + s),  m(l) = n(l) + c*(nF - nC)*q(u(l))
+ * where u = (n - nd)/(nF - nC) and q(u) = u*(u - uF - uC).  q vanishes at d and takes the same value at F and C,
+ * so that c shifts only PgF, and s is chosen to give the sampled relative deviation of vd.
+ *
+ * Samples are drawn in fixed size chunks, and each chunk has its own random stream seeded by
+ * (seed, glass, chunk).  The result does not depend on the number of threads.
+ */
+class MeltToleranceSimulation
+{
+public:
+    enum Distribution{
+        Uniform, // within +/- tolerance
+        Normal   // tolerance as 3 sigma
+    };
+
+    struct Tolerance{
+        double nd;         // absolute
+        double vdRelative; // relative to vd
+        double PgF;        // absolute
+    };
+
+    struct Statistics{
+        QString         glass;    // full name, or "Doublet"
+        QString         quantity;
+        double          nominal;
+        double          mean;
+        double          stdDev;
+        QVector<double> percentiles; // at percentileLevels()
+        double          histogramMin;
+        double          histogramMax;
+        QVector<int>    histogram;
+    };
+
+    explicit MeltToleranceSimulation(const QVector<const Glass*>& glasses);
+
+    /** SCHOTT tolerance steps of nd, the last is the standard */
+    static QStringList ndClassNames();
+    static double      ndClassTolerance(int n);
+
+    /** SCHOTT tolerance steps of vd, the last is the standard */
+    static QStringList vdClassNames();
+    static double      vdClassTolerance(int n);
+
+    static QStringList distributionNames();
+
+    /** 1, 5, 50, 95, 99 percent */
+    static QVector<double> percentileLevels();
+
+    void setTolerance(const Tolerance& tolerance){ tolerance_ = tolerance; }
+    void setDistribution(Distribution distribution){ distribution_ = distribution; }
+    void setSeed(quint32 seed){ seed_ = seed; }
+    void setHistogramBinCount(int count){ bin_count_ = count; }
+
+    /**
+     * @brief Add the thin lens doublet quantities of the first (crown) and the second (flint) glass
+     * @details crown power ratio Va/(Va - Vb) and secondary spectrum -f*(Pa - Pb)/(Va - Vb)
+     */
+    void setDoublet(bool state, double focalLength){ doublet_ = state; focal_length_ = focalLength; }
+
+    /** @param sampleCount samples per glass */
+    QVector<Statistics> run(int sampleCount);
+
+private:
+    enum Line{ D, F, C, G, LineCount };
+
+    /** sampled nd, vd and PgF of the glass */
+    void sample(int glassIndex, int sampleCount, QVector<double>& nd, QVector<double>& vd, QVector<double>& pgf) const;
+
+    Statistics summarize(const QString& glass, const QString& quantity, double nominal, QVector<double>& values) const;
+
+    QVector<const Glass*> glasses_;
+    QVector<double>       indices_; // glassCount x LineCount
+    Tolerance    tolerance_;
+    Distribution distribution_;
+    quint32      seed_;
+    int          bin_count_;
+    bool         doublet_;
+    double       focal_length_;
+};
+
+#endif // MELT_TOLERANCE_SIMULATION_H
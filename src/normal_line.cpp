@@ -0,0 +1,155 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "normal_line.h"
+
+#include <QMutex>
+
+#include "glass_catalog.h"
+#include "glass_catalog_manager.h"
+
+namespace {
+
+// serializes refitting
+QMutex fitMutex;
+
+} // namespace
+
+std::shared_ptr<const NormalLine::State> NormalLine::m_state = std::make_shared<const NormalLine::State>();
+
+void NormalLine::collectSamples(const CatalogSnapshotPtr &snapshot, const QString &xdataname, const QString &ydataname,
+                                const QStringList &suppliers, const QList<GlassHandle> &references,
+                                QVector<double> &x, QVector<double> &y)
+{
+    for(auto &cat : snapshot->catalogs()){
+        if(!suppliers.contains(cat->supplier())){
+            continue;
+        }
+        for(int i = 0; i < cat->glassCount(); i++){
+            const Glass* g = cat->glass(i);
+            x.append(g->getValue(xdataname));
+            y.append(g->getValue(ydataname));
+        }
+    }
+
+    for(GlassHandle h : references){
+        const Glass* g = snapshot->glass(h);
+        if(g){
+            x.append(g->getValue(xdataname));
+            y.append(g->getValue(ydataname));
+        }
+    }
+}
+
+bool NormalLine::fit(State &state, NormalLineFit::Result &result)
+{
+    state.snapshot    = GlassCatalogManager::snapshot();
+    state.temperature = Glass::currentTemperature();
+
+    QVector<double> x = state.definition.fixedVd;
+    QVector<double> y = state.definition.fixedPgF;
+    collectSamples(state.snapshot, "vd", "PgF", state.definition.suppliers, state.definition.references, x, y);
+
+    if(!NormalLineFit::fit(x, y, state.definition.options, result)){
+        state.coefs.clear();
+        return false;
+    }
+    state.coefs = result.coefs;
+    return true;
+}
+
+bool NormalLine::setDefinition(const Definition &definition, NormalLineFit::Result *result)
+{
+    QMutexLocker locker(&fitMutex);
+
+    auto newState = std::make_shared<State>();
+    newState->isDefault  = false;
+    newState->definition = definition;
+    newState->revision   = std::atomic_load(&m_state)->revision + 1;
+
+    NormalLineFit::Result r;
+    if(!fit(*newState, r)){
+        return false;
+    }
+    if(result) *result = r;
+
+    std::atomic_store(&m_state, std::shared_ptr<const State>(newState));
+    return true;
+}
+
+void NormalLine::reset()
+{
+    QMutexLocker locker(&fitMutex);
+
+    auto newState = std::make_shared<State>();
+    newState->revision = std::atomic_load(&m_state)->revision + 1;
+    std::atomic_store(&m_state, std::shared_ptr<const State>(newState));
+}
+
+bool NormalLine::isDefault()
+{
+    return std::atomic_load(&m_state)->isDefault;
+}
+
+int NormalLine::revision()
+{
+    return std::atomic_load(&m_state)->revision;
+}
+
+std::shared_ptr<const NormalLine::State> NormalLine::currentState()
+{
+    std::shared_ptr<const State> state = std::atomic_load(&m_state);
+    if(state->isDefault){
+        return state;
+    }
+
+    auto isCurrent = [](const std::shared_ptr<const State>& s){
+        return (s->snapshot == GlassCatalogManager::snapshot()) && (s->temperature == Glass::currentTemperature());
+    };
+    if(isCurrent(state)){
+        return state;
+    }
+
+    // refit the same definition.  The samples are vd and PgF, therefore it does not come back here.
+    QMutexLocker locker(&fitMutex);
+    state = std::atomic_load(&m_state);
+    if(state->isDefault || isCurrent(state)){
+        return state;
+    }
+
+    auto newState = std::make_shared<State>(*state);
+    NormalLineFit::Result r;
+    fit(*newState, r);
+    std::atomic_store(&m_state, std::shared_ptr<const State>(newState));
+    return newState;
+}
+
+double NormalLine::PgF(double vd)
+{
+    std::shared_ptr<const State> state = currentState();
+    if(state->isDefault){
+        return 0.6438 - 0.001682*vd;
+    }
+    return state->coefs.isEmpty() ? qQNaN() : NormalLineFit::evaluate(state->coefs, vd);
+}
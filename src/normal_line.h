@@ -0,0 +1,90 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef NORMAL_LINE_H
+#define NORMAL_LINE_H
+
+#include <memory>
+#include <QStringList>
+#include <QList>
+#include <QVector>
+
+#include "glass.h"
+#include "catalog_snapshot.h"
+#include "normal_line_fit.h"
+
+/**
+ * @brief Normal line PgF(vd) used by the dPgF property
+ * @details
+ * By default the line of K7 and F2, PgF = 0.6438 - 0.001682*vd.
+ * A fitted line keeps its definition (catalogs, reference glasses and fixed points) instead of coefficients,
+ * and is refitted lazily when the snapshot or the temperature changes.
+ */
+class NormalLine
+{
+public:
+    struct Definition{
+        QStringList        suppliers;   // all glasses of these catalogs
+        QList<GlassHandle> references;  // reference glasses
+        QVector<double>    fixedVd;     // fixed points
+        QVector<double>    fixedPgF;
+        NormalLineFit::Options options;
+    };
+
+    /** fit the definition now and use it for dPgF.  false if the samples can not determine the line. */
+    static bool setDefinition(const Definition& definition, NormalLineFit::Result* result = nullptr);
+
+    /** back to the K7-F2 line */
+    static void reset();
+
+    static bool isDefault();
+
+    /** incremented whenever the definition is changed */
+    static int revision();
+
+    /** PgF of the normal line at vd, at the current temperature */
+    static double PgF(double vd);
+
+    /** (x, y) of the glasses of the suppliers and the references in the snapshot */
+    static void collectSamples(const CatalogSnapshotPtr& snapshot, const QString& xdataname, const QString& ydataname,
+                               const QStringList& suppliers, const QList<GlassHandle>& references,
+                               QVector<double>& x, QVector<double>& y);
+
+private:
+    struct State{
+        bool               isDefault = true;
+        Definition         definition;
+        int                revision = 0;
+        CatalogSnapshotPtr snapshot;
+        double             temperature = 0.0;
+        QVector<double>    coefs;
+    };
+
+    static bool fit(State& state, NormalLineFit::Result& result);
+    static std::shared_ptr<const State> currentState();
+
+    static std::shared_ptr<const State> m_state; // accessed by std::atomic_load/atomic_store only
+};
+
+#endif // NORMAL_LINE_H
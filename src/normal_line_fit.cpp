@@ -0,0 +1,279 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "normal_line_fit.h"
+
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <QtConcurrent>
+
+#include "Eigen/Dense"
+
+using namespace Eigen;
+
+namespace {
+
+const int kRansacChunkSize = 64;
+const int kHuberMaxIterations = 50;
+
+/** samples with the abscissa scaled to [-1, 1] */
+struct ScaledSamples{
+    VectorXd u;
+    VectorXd y;
+    double center;
+    double halfWidth;
+};
+
+double horner(const VectorXd& beta, double u)
+{
+    double v = 0.0;
+    for(int j = beta.size() - 1; j >= 0; j--){
+        v = v*u + beta(j);
+    }
+    return v;
+}
+
+/** weighted least squares in u.  Empty weights for unit weights. */
+bool solve(const ScaledSamples& s, const VectorXd& w, const QVector<int>& rows, int order, VectorXd& beta)
+{
+    const int m = rows.size();
+    if(m < order + 1){
+        return false;
+    }
+
+    MatrixXd A(m, order + 1);
+    VectorXd b(m);
+    for(int i = 0; i < m; i++){
+        const int r = rows[i];
+        const double sw = (w.size() > 0) ? sqrt(w(r)) : 1.0;
+        double p = sw;
+        for(int j = 0; j <= order; j++){
+            A(i, j) = p;
+            p *= s.u(r);
+        }
+        b(i) = sw*s.y(r);
+    }
+
+    ColPivHouseholderQR<MatrixXd> qr(A);
+    if(qr.rank() < order + 1){
+        return false;
+    }
+    beta = qr.solve(b);
+    return true;
+}
+
+double madScale(const ScaledSamples& s, const VectorXd& beta, const QVector<int>& rows)
+{
+    std::vector<double> r;
+    r.reserve(rows.size());
+    for(int i : rows){
+        r.push_back(fabs(s.y(i) - horner(beta, s.u(i))));
+    }
+    if(r.empty()){
+        return 0.0;
+    }
+    std::nth_element(r.begin(), r.begin() + r.size()/2, r.end());
+    return 1.4826*r[r.size()/2];
+}
+
+QVector<int> allRows(int n)
+{
+    QVector<int> rows(n);
+    std::iota(rows.begin(), rows.end(), 0);
+    return rows;
+}
+
+/** expand the polynomial in u = (x - center)/halfWidth to the powers of x */
+QVector<double> toPowersOfX(const VectorXd& beta, double center, double halfWidth)
+{
+    const int n = beta.size();
+    QVector<double> c(n, 0.0);
+    for(int j = 0; j < n; j++){
+        // beta_j * (x - center)^j / halfWidth^j
+        double binom = 1.0;
+        for(int k = 0; k <= j; k++){
+            if(k > 0) binom = binom*(j - k + 1)/k;
+            c[k] += beta(j)*binom*pow(-center, j - k)/pow(halfWidth, j);
+        }
+    }
+    return c;
+}
+
+} // namespace
+
+
+bool NormalLineFit::fit(const QVector<double> &x, const QVector<double> &y, const Options &options, Result &result)
+{
+    const int order = options.order;
+
+    ScaledSamples s;
+    QVector<int> finite;
+    double xmin = qInf(), xmax = -qInf();
+    for(int i = 0; i < qMin(x.size(), y.size()); i++){
+        if(qIsFinite(x[i]) && qIsFinite(y[i])){
+            finite.append(i);
+            xmin = qMin(xmin, x[i]);
+            xmax = qMax(xmax, x[i]);
+        }
+    }
+
+    const int n = finite.size();
+    if(order < 0 || n < order + 1){
+        return false;
+    }
+
+    s.center    = 0.5*(xmin + xmax);
+    s.halfWidth = (xmax > xmin) ? 0.5*(xmax - xmin) : 1.0;
+    s.u.resize(n);
+    s.y.resize(n);
+    for(int i = 0; i < n; i++){
+        s.u(i) = (x[finite[i]] - s.center)/s.halfWidth;
+        s.y(i) = y[finite[i]];
+    }
+
+    const QVector<int> rows = allRows(n);
+    VectorXd beta;
+    if(!solve(s, VectorXd(), rows, order, beta)){
+        return false;
+    }
+
+    QVector<int> inliers = rows;
+
+    if(Huber == options.method){
+        VectorXd w(n);
+        for(int iter = 0; iter < kHuberMaxIterations; iter++){
+            const double scale = madScale(s, beta, rows);
+            if(scale <= 0.0){
+                break;
+            }
+            for(int i = 0; i < n; i++){
+                double t = fabs(s.y(i) - horner(beta, s.u(i)))/scale;
+                w(i) = (t <= options.huberK) ? 1.0 : options.huberK/t;
+            }
+            VectorXd next;
+            if(!solve(s, w, rows, order, next)){
+                break;
+            }
+            const bool converged = ((next - beta).cwiseAbs().maxCoeff() <= 1e-12*(1.0 + beta.cwiseAbs().maxCoeff()));
+            beta = next;
+            if(converged){
+                break;
+            }
+        }
+
+        const double scale = madScale(s, beta, rows);
+        inliers.clear();
+        for(int i = 0; i < n; i++){
+            if(fabs(s.y(i) - horner(beta, s.u(i))) <= options.huberK*scale) inliers.append(i);
+        }
+    }
+    else if(Ransac == options.method && n > order + 1){
+        const double threshold = (options.ransacThreshold > 0.0) ? options.ransacThreshold : 3.0*madScale(s, beta, rows);
+
+        struct Candidate{
+            int    count = -1;
+            double cost  = qInf();
+            VectorXd beta;
+        };
+
+        QVector<int> chunks;
+        for(int begin = 0; begin < options.ransacIterations; begin += kRansacChunkSize){
+            chunks.append(begin);
+        }
+        QVector<Candidate> best(chunks.size());
+
+        QtConcurrent::blockingMap(chunks, [&](int begin){
+            const int chunk = begin/kRansacChunkSize;
+            std::seed_seq seq({options.seed, static_cast<unsigned int>(chunk)});
+            std::mt19937 rng(seq);
+            std::uniform_int_distribution<int> pick(0, n - 1);
+
+            Candidate c;
+            QVector<int> subset;
+            const int end = qMin(begin + kRansacChunkSize, options.ransacIterations);
+            for(int it = begin; it < end; it++){
+                subset.clear();
+                while(subset.size() < order + 1){
+                    int r = pick(rng);
+                    if(!subset.contains(r)) subset.append(r);
+                }
+
+                VectorXd b;
+                if(!solve(s, VectorXd(), subset, order, b)){
+                    continue;
+                }
+
+                int count = 0;
+                double cost = 0.0;
+                for(int i = 0; i < n; i++){
+                    double r = fabs(s.y(i) - horner(b, s.u(i)));
+                    if(r <= threshold){
+                        count++;
+                        cost += r*r;
+                    }
+                }
+                if(count > c.count || (count == c.count && cost < c.cost)){
+                    c.count = count;
+                    c.cost  = cost;
+                    c.beta  = b;
+                }
+            }
+            best[chunk] = c;
+        });
+
+        const Candidate* winner = nullptr;
+        for(auto &c : best){
+            if(c.count < 0) continue;
+            if(!winner || c.count > winner->count || (c.count == winner->count && c.cost < winner->cost)){
+                winner = &c;
+            }
+        }
+
+        if(winner){
+            inliers.clear();
+            for(int i = 0; i < n; i++){
+                if(fabs(s.y(i) - horner(winner->beta, s.u(i))) <= threshold) inliers.append(i);
+            }
+            if(!solve(s, VectorXd(), inliers, order, beta)){
+                beta = winner->beta;
+            }
+        }
+    }
+
+    result.coefs       = toPowersOfX(beta, s.center, s.halfWidth);
+    result.scale       = madScale(s, beta, inliers);
+    result.inlierCount = inliers.size();
+    result.sampleCount = n;
+    return true;
+}
+
+double NormalLineFit::evaluate(const QVector<double> &coefs, double x)
+{
+    double v = 0.0;
+    for(int j = coefs.size() - 1; j >= 0; j--){
+        v = v*x + coefs[j];
+    }
+    return v;
+}
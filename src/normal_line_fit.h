@@ -0,0 +1,72 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef NORMAL_LINE_FIT_H
+#define NORMAL_LINE_FIT_H
+
+#include <QVector>
+
+/**
+ * @brief Polynomial fit y = c0 + c1*x + c2*x^2 + ... of glass map samples
+ * @details
+ * The abscissa is scaled to [-1, 1] and the least squares problem is solved by column pivoting QR,
+ * so that the normal equations are never formed.  Outliers can be suppressed by
+ *  - Huber : iteratively reweighted least squares with the MAD scale
+ *  - Ransac: minimal subsets drawn in parallel, then least squares of the best consensus
+ */
+class NormalLineFit
+{
+public:
+    enum Method{
+        LeastSquares,
+        Huber,
+        Ransac
+    };
+
+    struct Options{
+        int    order = 1;
+        Method method = LeastSquares;
+        double huberK = 1.345;          // in units of the residual scale
+        int    ransacIterations = 1024;
+        double ransacThreshold = 0.0;   // absolute residual. 0 for 3 times the residual scale of least squares.
+        unsigned int seed = 0;
+    };
+
+    struct Result{
+        QVector<double> coefs;  // c0, c1, ... in x
+        double scale = 0.0;     // robust residual scale (1.4826 MAD) of the inliers
+        int    inlierCount = 0;
+        int    sampleCount = 0;
+    };
+
+    /**
+     * @brief fit the samples. Non finite samples are skipped.
+     * @return false if the finite samples can not determine the polynomial
+     */
+    static bool fit(const QVector<double>& x, const QVector<double>& y, const Options& options, Result& result);
+
+    static double evaluate(const QVector<double>& coefs, double x);
+};
+
+#endif // NORMAL_LINE_FIT_H
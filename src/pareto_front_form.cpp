@@ -0,0 +1,224 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "pareto_front_form.h"
+#include "ui_pareto_front_form.h"
+
+#include <QElapsedTimer>
+#include <QMdiSubWindow>
+#include <QMessageBox>
+
+#include "glass_catalog_manager.h"
+#include "glass_datasheet_form.h"
+#include "glassmap_form.h"
+
+ParetoFrontForm::ParetoFrontForm(QMdiArea *parent) :
+    QWidget(parent),
+    ui(new Ui::ParetoFrontForm),
+    m_parentMdiArea(parent)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("Pareto Front");
+
+    // initialize objective table
+    QStringList hHeaderLabels({"Property", "Direction"});
+    ui->tableWidget_Objectives->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Objectives->setHorizontalHeaderLabels(hHeaderLabels);
+
+    QStringList properties = GlassConstraintIndex::propertyNames();
+    const int rowCount = 2;
+    const QStringList defaultProperties({"relCost", "climateResist"});
+    for(int i = 0; i < rowCount; i++){
+        addObjective();
+        QComboBox* combo = dynamic_cast<QComboBox*>(ui->tableWidget_Objectives->cellWidget(i, 0));
+        combo->setCurrentIndex(properties.indexOf(defaultProperties[i]));
+    }
+    ui->tableWidget_Objectives->resizeColumnsToContents();
+
+    ui->tableWidget_Result->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ui->tableWidget_Result->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    QObject::connect(ui->pushButton_Add,           SIGNAL(clicked()), this, SLOT(addObjective()));
+    QObject::connect(ui->pushButton_Remove,        SIGNAL(clicked()), this, SLOT(removeObjective()));
+    QObject::connect(ui->pushButton_Compute,       SIGNAL(clicked()), this, SLOT(showParetoFront()));
+    QObject::connect(ui->pushButton_ShowOnMap,     SIGNAL(clicked()), this, SLOT(showOnGlassMap()));
+    QObject::connect(ui->pushButton_showDatasheet, SIGNAL(clicked()), this, SLOT(showDatasheet()));
+    QObject::connect(ui->tableWidget_Result,       SIGNAL(cellDoubleClicked(int,int)), this, SLOT(showDatasheet()));
+}
+
+ParetoFrontForm::~ParetoFrontForm()
+{
+    delete ui;
+}
+
+void ParetoFrontForm::addObjective()
+{
+    QTableWidget *table = ui->tableWidget_Objectives;
+    int currentRow = table->rowCount();
+    table->setRowCount(currentRow + 1);
+
+    table->setCellWidget(currentRow, 0, createCombo(GlassConstraintIndex::propertyNames(), 0));
+    table->setCellWidget(currentRow, 1, createCombo(GlassSkyline::directionNames(), 0));
+
+    table->update();
+}
+
+void ParetoFrontForm::removeObjective()
+{
+    if(ui->tableWidget_Objectives->rowCount() > 1) {
+        int currentRow = ui->tableWidget_Objectives->currentRow();
+        ui->tableWidget_Objectives->removeRow(currentRow);
+    }
+}
+
+void ParetoFrontForm::showParetoFront()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_constraintIndex = GlassConstraintIndex::instance(GlassCatalogManager::snapshot());
+    const GlassPropertyTable& table = m_constraintIndex->table();
+
+    QVector<GlassSkyline::Objective> objectives;
+    QStringList propertyNames;
+    for(int i = 0; i < ui->tableWidget_Objectives->rowCount(); i++){
+        QComboBox* propertyCombo  = dynamic_cast<QComboBox*>(ui->tableWidget_Objectives->cellWidget(i, 0));
+        QComboBox* directionCombo = dynamic_cast<QComboBox*>(ui->tableWidget_Objectives->cellWidget(i, 1));
+        if(!propertyCombo || !directionCombo){
+            continue;
+        }
+        GlassSkyline::Objective o;
+        o.column    = table.columnIndex(propertyCombo->currentText());
+        o.direction = static_cast<GlassSkyline::Direction>(directionCombo->currentIndex());
+        objectives.append(o);
+        propertyNames.append(propertyCombo->currentText());
+    }
+
+    QString errorMessage;
+    GlassConstraintQuery query = GlassConstraintQuery::parse(ui->lineEdit_Constraint->text(), &errorMessage);
+    QBitArray mask = m_constraintIndex->select(query, &errorMessage);
+    ui->lineEdit_Constraint->setToolTip(errorMessage);
+
+    GlassSkyline skyline(table, objectives);
+    m_paretoRows = skyline.compute(&mask);
+
+    //setup result table
+    QStringList hHeaderLabels({"Glass", "Catalog"});
+    hHeaderLabels.append(propertyNames);
+    ui->tableWidget_Result->setSortingEnabled(false);
+    ui->tableWidget_Result->clearContents();
+    ui->tableWidget_Result->setColumnCount(hHeaderLabels.size());
+    ui->tableWidget_Result->setHorizontalHeaderLabels(hHeaderLabels);
+    ui->tableWidget_Result->setRowCount(m_paretoRows.size());
+    for(int i = 0; i < m_paretoRows.size(); i++)
+    {
+        int row = m_paretoRows[i];
+        const Glass* g = table.glass(row);
+        setCellValue(ui->tableWidget_Result, i, 0, g->productName());
+        ui->tableWidget_Result->item(i, 0)->setData(Qt::UserRole, g->handle());
+        setCellValue(ui->tableWidget_Result, i, 1, g->supplier());
+
+        for(int j = 0; j < objectives.size(); j++){
+            setCellNumber(ui->tableWidget_Result, i, j+2, table.value(row, objectives[j].column));
+        }
+    }
+    ui->tableWidget_Result->setSortingEnabled(true);
+    ui->tableWidget_Result->resizeColumnsToContents();
+
+    ui->label_Summary->setText(QString("%1 Pareto optimal glasses of %2 in %3 ms")
+                               .arg(m_paretoRows.size())
+                               .arg(skyline.candidateCount())
+                               .arg(timer.elapsed()));
+}
+
+void ParetoFrontForm::showOnGlassMap()
+{
+    if(!m_constraintIndex){
+        return;
+    }
+
+    QList<GlassHandle> handles;
+    for(int row : m_paretoRows){
+        handles.append(m_constraintIndex->table().glass(row)->handle());
+    }
+
+    int mapCount = 0;
+    for(auto &subwindow : m_parentMdiArea->subWindowList()){
+        GlassMapForm* glassmap = qobject_cast<GlassMapForm*>(subwindow->widget());
+        if(glassmap){
+            glassmap->setMarkedGlasses(handles, "Pareto optimal");
+            mapCount++;
+        }
+    }
+
+    if(0 == mapCount){
+        QMessageBox::information(this, tr("Info"), tr("Open a glass map to show the Pareto optimal glasses"));
+    }
+}
+
+void ParetoFrontForm::showDatasheet()
+{
+    QTableWidgetItem* item = ui->tableWidget_Result->currentItem();
+    if(!item){
+        return;
+    }
+
+    GlassHandle handle = ui->tableWidget_Result->item(item->row(), 0)->data(Qt::UserRole).toUInt();
+    Glass* glass = GlassCatalogManager::glass(handle);
+    if(!glass){
+        return;
+    }
+
+    GlassDataSheetForm* subwindow = new GlassDataSheetForm(glass, m_parentMdiArea);
+    subwindow->setAttribute(Qt::WA_DeleteOnClose);
+    m_parentMdiArea->addSubWindow(subwindow);
+    subwindow->parentWidget()->setGeometry(0,10, this->width()*1/2,this->height()*3/4);
+    subwindow->show();
+}
+
+QComboBox* ParetoFrontForm::createCombo(const QStringList& items, int currentIndex)
+{
+    QComboBox *combo = new QComboBox();
+    combo->addItems(items);
+    combo->setCurrentIndex(currentIndex);
+    return combo;
+}
+
+void ParetoFrontForm::setCellValue(QTableWidget* table, int row, int col, QString str)
+{
+    QTableWidgetItem *item = table->item(row, col);
+    if(!item){
+        item = new QTableWidgetItem;
+        table->setItem(row, col, item);
+    }
+    item->setTextAlignment(Qt::AlignRight);
+    item->setText(str);
+}
+
+void ParetoFrontForm::setCellNumber(QTableWidget* table, int row, int col, double val)
+{
+    // numeric data so that the columns are sorted by value
+    setCellValue(table, row, col, "");
+    table->item(row, col)->setData(Qt::DisplayRole, val);
+}
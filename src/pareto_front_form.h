@@ -0,0 +1,78 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef PARETO_FRONT_FORM_H
+#define PARETO_FRONT_FORM_H
+
+#include <memory>
+#include <QWidget>
+#include <QMdiArea>
+#include <QTableWidget>
+#include <QComboBox>
+
+#include "glass_constraint_index.h"
+#include "glass_skyline.h"
+
+namespace Ui {
+class ParetoFrontForm;
+}
+
+/** Form to list the Pareto optimal glasses over the selected objectives */
+class ParetoFrontForm : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ParetoFrontForm(QMdiArea *parent = nullptr);
+    ~ParetoFrontForm();
+
+private slots:
+    /** Compute the Pareto front and show result */
+    void showParetoFront();
+
+    /** Add new line to objective table */
+    void addObjective();
+
+    /** Remove line from objective table */
+    void removeObjective();
+
+    /** Mark the Pareto optimal glasses on the open glass maps */
+    void showOnGlassMap();
+
+    /** Show datasheet of the glass in the current row */
+    void showDatasheet();
+
+private:
+    QComboBox* createCombo(const QStringList& items, int currentIndex);
+    void setCellValue(QTableWidget* table, int row, int col, QString str);
+    void setCellNumber(QTableWidget* table, int row, int col, double val);
+
+    Ui::ParetoFrontForm *ui;
+    QMdiArea* m_parentMdiArea;
+
+    std::shared_ptr<const GlassConstraintIndex> m_constraintIndex; // source of the rows of m_paretoRows
+    QVector<int> m_paretoRows;
+};
+
+#endif // PARETO_FRONT_FORM_H
@@ -37,6 +37,8 @@ PreferenceDialog::PreferenceDialog(GlobalSettingsIO *settings, QWidget *parent)
     this->setWindowTitle("Preference");
 
     ui->lineEdit_Temperature->setValidator(new QDoubleValidator(-30, 70, 4, this));
+    ui->lineEdit_LambdaMin->setValidator(new QDoubleValidator(0, 100000, 4, this));
+    ui->lineEdit_LambdaMax->setValidator(new QDoubleValidator(0, 100000, 4, this));
 
     QObject::connect(ui->pushButton_Browse, SIGNAL(clicked()), this, SLOT(browseCatalogFiles()));
     QObject::connect(ui->pushButton_Clear,  SIGNAL(clicked()), this, SLOT(clearCatalogFiles()));
@@ -70,7 +72,7 @@ void PreferenceDialog::browseCatalogFiles()
     QStringList filePaths = QFileDialog::getOpenFileNames(this,
                                                           tr("select AGF"),
                                                           QApplication::applicationDirPath(),
-                                                          tr("AGF files(*.agf);;XML Files(*.xml)"));
+                                                          tr("AGF files(*.agf *.agf.gz);;XML Files(*.xml *.xml.gz)"));
     if(!filePaths.empty()){
         ui->listWidget_DefaultFiles->addItems(filePaths);
     }
@@ -82,6 +84,12 @@ void PreferenceDialog::clearCatalogFiles()
     ui->listWidget_DefaultFiles->clear();
 }
 
+QList<QCheckBox*> PreferenceDialog::statusCheckBoxes() const
+{
+    // status name is taken from the check box text
+    return QList<QCheckBox*>({ui->checkBox_Preferred, ui->checkBox_Standard, ui->checkBox_Special, ui->checkBox_Obsolete, ui->checkBox_Melt});
+}
+
 void PreferenceDialog::syncUiWithSettings()
 {
     // catalog file paths
@@ -100,6 +108,16 @@ void PreferenceDialog::syncUiWithSettings()
     // environment
     double temperature = m_globalSettings->temperature();
     ui->lineEdit_Temperature->setText(QString::number(temperature));
+
+    // load filter
+    GlassLoadFilter filter = m_globalSettings->loadFilter();
+    ui->lineEdit_Suppliers->setText(filter.suppliers.join(", "));
+    for(auto &cb : statusCheckBoxes()){
+        cb->setChecked(filter.statuses.isEmpty() || filter.statuses.contains(cb->text()));
+    }
+    ui->checkBox_RejectUnknownFormula->setChecked(filter.rejectUnknownFormula);
+    ui->lineEdit_LambdaMin->setText(qIsNaN(filter.requiredLambdaMin) ? "" : QString::number(filter.requiredLambdaMin*1000));
+    ui->lineEdit_LambdaMax->setText(qIsNaN(filter.requiredLambdaMax) ? "" : QString::number(filter.requiredLambdaMax*1000));
 }
 
 void PreferenceDialog::onAccept()
@@ -125,6 +143,34 @@ void PreferenceDialog::onAccept()
 
     Glass::setCurrentTemperature(temperature);
 
+    // load filter. Changes take effect from the next loading.
+    GlassLoadFilter filter;
+    for(auto &supplier : ui->lineEdit_Suppliers->text().split(",")){
+        if(!supplier.trimmed().isEmpty()){
+            filter.suppliers.append(supplier.trimmed());
+        }
+    }
+
+    QStringList statuses;
+    for(auto &cb : statusCheckBoxes()){
+        if(cb->isChecked()){
+            statuses.append(cb->text());
+        }
+    }
+    if(statuses.size() < statusCheckBoxes().size()){
+        filter.statuses = statuses; // all checked means no filter
+    }
+
+    filter.rejectUnknownFormula = ui->checkBox_RejectUnknownFormula->isChecked();
+
+    bool ok;
+    double lambdamin = ui->lineEdit_LambdaMin->text().toDouble(&ok);
+    filter.requiredLambdaMin = ok ? lambdamin/1000 : NAN; // nm -> micron
+    double lambdamax = ui->lineEdit_LambdaMax->text().toDouble(&ok);
+    filter.requiredLambdaMax = ok ? lambdamax/1000 : NAN;
+
+    m_globalSettings->setLoadFilter(filter);
+
     m_globalSettings->saveIniFile();
 
     accept();
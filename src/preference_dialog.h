@@ -26,6 +26,7 @@
 #define PREFERENCE_DIALOG_H
 
 #include <QDialog>
+#include <QCheckBox>
 #include "global_settings_io.h"
 
 namespace Ui {
@@ -49,6 +50,7 @@ private slots:
 
 private:
     void syncUiWithSettings();
+    QList<QCheckBox*> statusCheckBoxes() const;
 
     Ui::PreferenceDialog *ui;
     GlobalSettingsIO *m_globalSettings;
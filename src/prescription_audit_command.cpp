@@ -0,0 +1,148 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "prescription_audit_command.h"
+
+#include <cstring>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include "glass.h"
+#include "glass_catalog_manager.h"
+#include "glass_constraint_index.h"
+#include "prescription_auditor.h"
+#include "global_settings_io.h"
+
+bool PrescriptionAuditCommand::isRequested(int argc, char *argv[])
+{
+    for(int i = 1; i < argc; i++){
+        if(0 == strcmp(argv[i], "--audit")){
+            return true;
+        }
+    }
+    return false;
+}
+
+int PrescriptionAuditCommand::run(const QStringList &arguments)
+{
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Audit the glasses of Zemax prescriptions (*.zmx) against the catalogs.");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("audit",       "Directory of the prescription files.", "directory"));
+    parser.addOption(QCommandLineOption("recursive",   "Include subdirectories."));
+    parser.addOption(QCommandLineOption("output",      "Report CSV file. Default is stdout.", "file"));
+    parser.addOption(QCommandLineOption("catalog",     "Catalog file. Can be repeated. Default is the preference.", "file"));
+    parser.addOption(QCommandLineOption("conditions",  "Substitute conditions.", "text", "status = Preferred|Standard"));
+    parser.addOption(QCommandLineOption("temperature", "Temperature in degrees Celsius. Default is the preference.", "T"));
+    parser.process(arguments);
+
+    // preference
+    GlobalSettingsIO settings;
+    settings.loadIniFile();
+    // All glasses are loaded, so that the ones hidden by the load filter are reported as obsolete rather than missing.
+    GlassCatalogManager::setLoadFilter(GlassLoadFilter());
+
+    double temperature = settings.temperature();
+    if(parser.isSet("temperature")){
+        bool ok;
+        temperature = parser.value("temperature").toDouble(&ok);
+        if(!ok){
+            err << "Invalid temperature: " << parser.value("temperature") << "\n";
+            return 1;
+        }
+    }
+    Glass::setCurrentTemperature(temperature);
+
+    const QString dirPath = parser.value("audit");
+    if(!QFileInfo(dirPath).isDir()){
+        err << "Not a directory: " << dirPath << "\n";
+        return 1;
+    }
+
+    // catalogs
+    QStringList catalogFilePaths = parser.isSet("catalog") ? parser.values("catalog") : settings.defaultFilePaths();
+    if(catalogFilePaths.isEmpty()){
+        err << "No catalog file is given\n";
+        return 1;
+    }
+    LoadDiagnostics diagnostics;
+    GlassCatalogManager::loadCatalogFiles(catalogFilePaths, diagnostics);
+
+    CatalogSnapshotPtr snapshot = GlassCatalogManager::snapshot();
+    if(snapshot->isEmpty()){
+        err << "No catalog has been loaded\n";
+        return 1;
+    }
+
+    // substitute candidates
+    auto index = GlassConstraintIndex::instance(snapshot);
+    QString errorMessage;
+    GlassConstraintQuery query = GlassConstraintQuery::parse(parser.value("conditions"), &errorMessage);
+    QBitArray mask;
+    if(errorMessage.isEmpty()){
+        mask = index->select(query, &errorMessage);
+    }
+    if(!errorMessage.isEmpty()){
+        err << "Invalid conditions: " << errorMessage << "\n";
+        return 1;
+    }
+
+    PrescriptionAuditor auditor(index, mask);
+    const QStringList files = PrescriptionAuditor::listFiles(dirPath, parser.isSet("recursive"));
+    const QVector<PrescriptionAuditor::FileReport> reports = auditor.audit(files);
+
+    // result
+    QFile output;
+    bool opened;
+    if(parser.isSet("output")){
+        output.setFileName(parser.value("output"));
+        opened = output.open(QIODevice::WriteOnly | QIODevice::Text);
+    }else{
+        opened = output.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+    if(!opened){
+        err << "Could not open " << parser.value("output") << "\n";
+        return 1;
+    }
+    QTextStream out(&output);
+    auditor.writeCsv(out, reports);
+    out.flush();
+
+    // summary
+    int unreadable = 0, flagged = 0, malformed = 0;
+    for(auto &report : reports){
+        if(!report.error.isEmpty()) unreadable++;
+        if(report.needsReplacement()) flagged++;
+        malformed += report.malformedLines;
+    }
+    err << reports.size() << " files, " << flagged << " need glass replacement, "
+        << unreadable << " unreadable, " << malformed << " malformed GLAS lines\n";
+
+    return 0;
+}
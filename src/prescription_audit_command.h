@@ -0,0 +1,47 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef PRESCRIPTION_AUDIT_COMMAND_H
+#define PRESCRIPTION_AUDIT_COMMAND_H
+
+#include <QStringList>
+
+/**
+ * @brief Command line audit of lens prescriptions without the main window
+ * @details
+ * glassplotter --audit <directory> [--recursive] [--output report.csv] [--catalog file.agf ...]
+ *              [--conditions "status = Preferred|Standard"] [--temperature 25]
+ *
+ * Catalog files and temperature default to the preference. The load filter of the preference is not applied.
+ */
+namespace PrescriptionAuditCommand
+{
+    /** true if the arguments request the audit */
+    bool isRequested(int argc, char *argv[]);
+
+    /** @return exit code */
+    int run(const QStringList& arguments);
+}
+
+#endif // PRESCRIPTION_AUDIT_COMMAND_H
@@ -0,0 +1,252 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "prescription_auditor.h"
+
+#include <numeric>
+#include <QFile>
+#include <QDir>
+#include <QDirIterator>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QtConcurrent>
+
+#include "glass.h"
+#include "glass_catalog.h"
+
+namespace {
+
+const QString kModelGlassPrefix = "___BLANK";
+
+QString verdictName(PrescriptionAuditor::Verdict verdict)
+{
+    switch(verdict){
+    case PrescriptionAuditor::Ok:       return "ok";
+    case PrescriptionAuditor::Obsolete: return "obsolete";
+    case PrescriptionAuditor::Missing:  return "missing";
+    case PrescriptionAuditor::Model:    return "model";
+    }
+    return QString();
+}
+
+QString csvNumber(double v)
+{
+    return qIsFinite(v) ? QString::number(v) : QString();
+}
+
+} // namespace
+
+
+bool PrescriptionAuditor::FileReport::needsReplacement() const
+{
+    for(auto &g : glasses){
+        if(Ok != g.verdict) return true;
+    }
+    return false;
+}
+
+PrescriptionAuditor::PrescriptionAuditor(std::shared_ptr<const GlassConstraintIndex> index, const QBitArray &substituteMask)
+    : index_(index),
+      snapper_(index, substituteMask, QVector<double>({1.0, 1.0, 1.0}))
+{
+}
+
+QStringList PrescriptionAuditor::listFiles(const QString &dirPath, bool recursive)
+{
+    QStringList files;
+    QDirIterator it(dirPath, QStringList({"*.zmx", "*.ZMX", "*.zos", "*.ZOS"}), QDir::Files,
+                    recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+    while(it.hasNext()){
+        files.append(it.next());
+    }
+    files.sort();
+    return files;
+}
+
+const Glass* PrescriptionAuditor::resolve(const QString &name, const QStringList &suppliers) const
+{
+    const CatalogSnapshotPtr snapshot = index_->table().snapshot();
+
+    // catalogs of the prescription first
+    for(auto &supplier : suppliers){
+        const Glass* g = snapshot->find(supplier, name);
+        if(g) return g;
+    }
+    for(auto &cat : snapshot->catalogs()){
+        const Glass* g = snapshot->find(cat->supplier(), name);
+        if(g) return g;
+    }
+    return nullptr;
+}
+
+PrescriptionAuditor::FileReport PrescriptionAuditor::readPrescription(QIODevice *device, const QString &filePath) const
+{
+    static const QRegularExpression reSpaces("\\s+");
+
+    FileReport report;
+    report.filePath       = filePath;
+    report.malformedLines = 0;
+
+    // OpticStudio writes UTF-16 with BOM, older versions write 8 bit text
+    QTextStream in(device);
+    in.setAutoDetectUnicode(true);
+
+    QStringList suppliers;
+    int surface = -1;
+    int lineNumber = 0;
+    QString line;
+    while(in.readLineInto(&line)){
+        lineNumber++;
+        const QString trimmed = line.trimmed();
+
+        if(trimmed.startsWith("SURF ")){
+            bool ok;
+            int s = trimmed.mid(5).trimmed().toInt(&ok);
+            surface = ok ? s : surface;
+        }
+        else if(trimmed.startsWith("GCAT ")){
+            suppliers = trimmed.mid(5).split(reSpaces);
+            suppliers.removeAll(QString());
+        }
+        else if(trimmed.startsWith("GLAS ")){
+            // GLAS <name> <flag> <flag> <nd> <vd> <dPgF> ...
+            const QStringList fields = trimmed.split(reSpaces);
+            if(fields.size() < 2){
+                report.malformedLines++;
+                continue;
+            }
+
+            GlassUse use;
+            use.line          = lineNumber;
+            use.surface       = surface;
+            use.name          = fields[1];
+            use.relCost       = qQNaN();
+            use.nd            = (fields.size() > 4) ? fields[4].toDouble() : qQNaN();
+            use.vd            = (fields.size() > 5) ? fields[5].toDouble() : qQNaN();
+            use.dPgF          = (fields.size() > 6) ? fields[6].toDouble() : qQNaN();
+            use.substituteRow = -1;
+            use.distance      = qQNaN();
+
+            if("MIRROR" == use.name){
+                continue;
+            }
+
+            if(use.name.startsWith(kModelGlassPrefix)){
+                use.verdict = Model;
+                if(!(use.nd > 1.0 && use.vd > 0.0)){
+                    report.malformedLines++;
+                    continue;
+                }
+            }
+            else{
+                const Glass* g = resolve(use.name, suppliers);
+                if(!g){
+                    use.verdict = Missing;
+                }
+                else{
+                    use.verdict  = ("Obsolete" == g->status()) ? Obsolete : Ok;
+                    use.supplier = g->supplier();
+                    use.status   = g->status();
+                    use.relCost  = g->relCost();
+                    use.nd       = g->getValue("nd");
+                    use.vd       = g->getValue("vd");
+                    use.dPgF     = g->getValue("dPgF");
+                }
+            }
+            report.glasses.append(use);
+        }
+    }
+
+    return report;
+}
+
+QVector<PrescriptionAuditor::FileReport> PrescriptionAuditor::audit(const QStringList &filePaths) const
+{
+    QVector<FileReport> reports(filePaths.size());
+    QVector<int> indices(filePaths.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    QtConcurrent::blockingMap(indices, [&](int i){
+        QFile file(filePaths[i]);
+        // not in text mode, which drops '\r' bytes and breaks UTF-16 text
+        if(!file.open(QIODevice::ReadOnly)){
+            reports[i].filePath       = filePaths[i];
+            reports[i].error          = file.errorString();
+            reports[i].malformedLines = 0;
+            return;
+        }
+        reports[i] = readPrescription(&file, filePaths[i]);
+    });
+
+    // substitutes of all the glasses to be replaced at once
+    QVector<GlassSnapper::ModelGlass> models;
+    QVector<GlassUse*> targets;
+    for(auto &report : reports){
+        for(auto &use : report.glasses){
+            if(Ok != use.verdict && use.nd > 1.0 && use.vd > 0.0){
+                models.append(GlassSnapper::ModelGlass{use.name, use.nd, use.vd, (0.0 == use.dPgF) ? qQNaN() : use.dPgF});
+                targets.append(&use);
+            }
+        }
+    }
+
+    if(snapper_.candidateCount() > 0){
+        const QVector< QVector<GlassSnapper::Match> > matches = snapper_.snap(models, 1);
+        for(int i = 0; i < targets.size(); i++){
+            if(!matches[i].isEmpty()){
+                targets[i]->substituteRow = matches[i].first().row;
+                targets[i]->distance      = matches[i].first().distance;
+            }
+        }
+    }
+
+    return reports;
+}
+
+void PrescriptionAuditor::writeCsv(QTextStream &out, const QVector<FileReport> &reports) const
+{
+    const GlassPropertyTable& tbl = index_->table();
+
+    out << "File,Line,Surface,Glass,Verdict,Supplier,Status,relCost,nd,vd,Substitute,Substitute_Supplier,Substitute_Status,Substitute_relCost,Distance" << "\n";
+    for(auto &report : reports){
+        if(!report.error.isEmpty()){
+            out << report.filePath << ",,,,unreadable,,,,,,,,,," << "\n";
+            continue;
+        }
+        for(auto &use : report.glasses){
+            QStringList fields;
+            fields << report.filePath << QString::number(use.line) << ((use.surface < 0) ? QString() : QString::number(use.surface))
+                   << use.name << verdictName(use.verdict) << use.supplier << use.status << csvNumber(use.relCost)
+                   << csvNumber(use.nd) << csvNumber(use.vd);
+            if(use.substituteRow >= 0){
+                const Glass* g = tbl.glass(use.substituteRow);
+                fields << g->productName() << g->supplier() << g->status() << csvNumber(g->relCost()) << QString::number(use.distance);
+            }
+            else{
+                fields << QString() << QString() << QString() << QString() << QString();
+            }
+            out << fields.join(",") << "\n";
+        }
+    }
+}
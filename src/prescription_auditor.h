@@ -0,0 +1,105 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef PRESCRIPTION_AUDITOR_H
+#define PRESCRIPTION_AUDITOR_H
+
+#include <memory>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QBitArray>
+
+#include "glass_snapper.h"
+
+class QIODevice;
+class QTextStream;
+
+/**
+ * @brief Audit the glasses of lens prescriptions (Zemax .zmx) against the loaded catalogs
+ * @details
+ * Each GLAS line is resolved through the handle index of the snapshot, trying the suppliers of the GCAT line first.
+ * Obsolete, missing and model glasses get the nearest substitute among the candidate glasses.
+ * Files are read in parallel, line by line.  Unreadable files and malformed lines are reported and skipped.
+ */
+class PrescriptionAuditor
+{
+public:
+    enum Verdict{
+        Ok,
+        Obsolete,
+        Missing,
+        Model    // ___BLANK model glass
+    };
+
+    struct GlassUse{
+        int     line;      // line number in the file
+        int     surface;   // -1 if no SURF line precedes
+        QString name;
+        Verdict verdict;
+        QString supplier;  // empty if missing
+        QString status;
+        double  relCost;
+        double  nd;        // catalog value, or the value on the GLAS line
+        double  vd;
+        double  dPgF;
+        int     substituteRow; // row of the index table, or -1
+        double  distance;
+    };
+
+    struct FileReport{
+        QString filePath;
+        QString error;          // not empty if the file could not be read
+        int     malformedLines;
+        QVector<GlassUse> glasses;
+
+        bool needsReplacement() const;
+    };
+
+    /**
+     * @param index catalogs to resolve the glasses
+     * @param substituteMask candidate rows of the substitutes
+     */
+    PrescriptionAuditor(std::shared_ptr<const GlassConstraintIndex> index, const QBitArray& substituteMask);
+
+    /** prescription files in the directory.  *.zmx and *.zos */
+    static QStringList listFiles(const QString& dirPath, bool recursive);
+
+    /** audit the files in parallel */
+    QVector<FileReport> audit(const QStringList& filePaths) const;
+
+    /** read GLAS lines of a prescription */
+    FileReport readPrescription(QIODevice* device, const QString& filePath) const;
+
+    /** one line per glass use, and one line per unreadable file */
+    void writeCsv(QTextStream& out, const QVector<FileReport>& reports) const;
+
+private:
+    const Glass* resolve(const QString& name, const QStringList& suppliers) const;
+
+    std::shared_ptr<const GlassConstraintIndex> index_;
+    GlassSnapper snapper_;
+};
+
+#endif // PRESCRIPTION_AUDITOR_H
@@ -0,0 +1,452 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "property_expression.h"
+
+#include <QtMath>
+#include <QtConcurrent>
+#include <QRegularExpression>
+
+#include "glass.h"
+#include "spectral_line.h"
+
+namespace {
+
+const int kGlassChunkSize = 1024;
+
+// maximum depth of user defined properties referring to others
+const int kMaxNesting = 16;
+
+const QStringList kSpectralLines({"t", "s", "r", "C", "C_", "D", "d", "e", "F", "F_", "g", "h", "i"});
+
+} // namespace
+
+
+/** Recursive descent parser which emits the code of each sub-expression, folding constants */
+class PropertyExpression::Parser
+{
+public:
+    Parser(PropertyExpression* target, const QString& text, const Resolver& resolver, QStringList* expanding)
+        : target_(target), text_(text), pos_(0), resolver_(resolver), expanding_(expanding)
+    {
+    }
+
+    bool parse(QVector<Instruction>& code, QString* errorMessage)
+    {
+        code = expression();
+        skipSpaces();
+        if(error_.isEmpty() && pos_ < text_.size()){
+            fail("Unexpected '" + text_.mid(pos_, 1) + "'");
+        }
+        if(!error_.isEmpty()){
+            if(errorMessage) *errorMessage = error_;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    typedef QVector<Instruction> Code;
+
+    void fail(const QString& message)
+    {
+        if(error_.isEmpty()){
+            error_ = message + " at " + QString::number(pos_ + 1);
+        }
+    }
+
+    void skipSpaces()
+    {
+        while(pos_ < text_.size() && text_[pos_].isSpace()) pos_++;
+    }
+
+    bool accept(QChar c)
+    {
+        skipSpaces();
+        if(pos_ < text_.size() && text_[pos_] == c){
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    static bool isConstant(const Code& c){ return (1 == c.size() && PushConstant == c[0].op); }
+
+    static Code constant(double v){ return Code({Instruction{PushConstant, v, -1}}); }
+
+    static double apply(OpCode op, double a, double b)
+    {
+        switch(op){
+        case Add:  return a + b;
+        case Sub:  return a - b;
+        case Mul:  return a * b;
+        case Div:  return a / b;
+        case Pow:  return pow(a, b);
+        case Neg:  return -a;
+        case Sqrt: return sqrt(a);
+        case Abs:  return fabs(a);
+        case Log:  return log(a);
+        case Exp:  return exp(a);
+        case Min:  return qMin(a, b);
+        case Max:  return qMax(a, b);
+        default:   return qQNaN();
+        }
+    }
+
+    Code unaryOp(OpCode op, const Code& a)
+    {
+        if(isConstant(a)) return constant(apply(op, a[0].value, 0.0));
+        Code c = a;
+        c.append(Instruction{op, 0.0, -1});
+        return c;
+    }
+
+    Code binaryOp(OpCode op, const Code& a, const Code& b)
+    {
+        if(isConstant(a) && isConstant(b)) return constant(apply(op, a[0].value, b[0].value));
+        Code c = a;
+        c += b;
+        c.append(Instruction{op, 0.0, -1});
+        return c;
+    }
+
+    Code expression()
+    {
+        Code c = term();
+        while(error_.isEmpty()){
+            if(accept('+'))      c = binaryOp(Add, c, term());
+            else if(accept('-')) c = binaryOp(Sub, c, term());
+            else break;
+        }
+        return c;
+    }
+
+    Code term()
+    {
+        Code c = unary();
+        while(error_.isEmpty()){
+            if(accept('*'))      c = binaryOp(Mul, c, unary());
+            else if(accept('/')) c = binaryOp(Div, c, unary());
+            else break;
+        }
+        return c;
+    }
+
+    Code unary()
+    {
+        if(accept('-')) return unaryOp(Neg, unary());
+        if(accept('+')) return unary();
+        Code c = primary();
+        if(accept('^')) c = binaryOp(Pow, c, unary());
+        return c;
+    }
+
+    Code primary()
+    {
+        skipSpaces();
+        if(pos_ >= text_.size()){
+            fail("Unexpected end");
+            return Code();
+        }
+
+        if(accept('(')){
+            Code c = expression();
+            if(!accept(')')) fail("Missing ')'");
+            return c;
+        }
+
+        const QChar ch = text_[pos_];
+        if(ch.isDigit() || ch == '.'){
+            return number();
+        }
+        if(ch.isLetter() || ch == '_'){
+            int begin = pos_;
+            while(pos_ < text_.size() && (text_[pos_].isLetterOrNumber() || text_[pos_] == '_')) pos_++;
+            QString name = text_.mid(begin, pos_ - begin);
+            if(accept('(')){
+                return call(name);
+            }
+            return identifier(name);
+        }
+
+        fail("Unexpected '" + QString(ch) + "'");
+        return Code();
+    }
+
+    Code number()
+    {
+        static const QRegularExpression reNumber("^(?:\\d+\\.?\\d*|\\.\\d+)(?:[eE][-+]?\\d+)?");
+        QRegularExpressionMatch m = reNumber.match(text_.mid(pos_));
+        if(!m.hasMatch()){
+            fail("Invalid number");
+            return Code();
+        }
+        pos_ += m.capturedLength();
+        return constant(m.captured(0).toDouble());
+    }
+
+    Code call(const QString& name)
+    {
+        QVector<Code> args;
+        if(!accept(')')){
+            do{
+                args.append(expression());
+            }while(error_.isEmpty() && accept(','));
+            if(!accept(')')) fail("Missing ')'");
+        }
+        if(!error_.isEmpty()){
+            return Code();
+        }
+
+        auto expectArgs = [&](int n){
+            if(args.size() != n) fail(name + " takes " + QString::number(n) + " argument(s)");
+            return error_.isEmpty();
+        };
+        auto constantArgs = [&](){
+            for(auto &a : args){
+                if(!isConstant(a)) fail("Arguments of " + name + " must be constant");
+            }
+            return error_.isEmpty();
+        };
+
+        if("sqrt" == name) return expectArgs(1) ? unaryOp(Sqrt, args[0]) : Code();
+        if("abs"  == name) return expectArgs(1) ? unaryOp(Abs,  args[0]) : Code();
+        if("log"  == name) return expectArgs(1) ? unaryOp(Log,  args[0]) : Code();
+        if("exp"  == name) return expectArgs(1) ? unaryOp(Exp,  args[0]) : Code();
+        if("pow"  == name) return expectArgs(2) ? binaryOp(Pow, args[0], args[1]) : Code();
+        if("min"  == name) return expectArgs(2) ? binaryOp(Min, args[0], args[1]) : Code();
+        if("max"  == name) return expectArgs(2) ? binaryOp(Max, args[0], args[1]) : Code();
+
+        if("n" == name){
+            if(!expectArgs(1) || !constantArgs()) return Code();
+            return leaf(Leaf{Leaf::Index, QString(), args[0][0].value, 0.0});
+        }
+        if("dndT" == name){
+            if(!expectArgs(1) || !constantArgs()) return Code();
+            return leaf(Leaf{Leaf::DnDt, QString(), args[0][0].value, 0.0});
+        }
+        if("tau" == name){
+            if(!expectArgs(2) || !constantArgs()) return Code();
+            return leaf(Leaf{Leaf::Transmittance, QString(), args[0][0].value, args[1][0].value});
+        }
+
+        fail("Unknown function " + name);
+        return Code();
+    }
+
+    Code identifier(const QString& name)
+    {
+        if(Glass::valueNames().contains(name)){
+            return leaf(Leaf{Leaf::Property, name, 0.0, 0.0});
+        }
+
+        if(name.startsWith('n') && kSpectralLines.contains(name.mid(1))){
+            return leaf(Leaf{Leaf::Index, QString(), SpectralLine::wavelength(name.mid(1))/1000.0, 0.0});
+        }
+
+        const QString definition = resolver_ ? resolver_(name) : QString();
+        if(definition.isEmpty()){
+            fail("Unknown name " + name);
+            return Code();
+        }
+        if(expanding_->contains(name)){
+            fail("Circular reference to " + name);
+            return Code();
+        }
+        if(expanding_->size() >= kMaxNesting){
+            fail("Too deeply nested " + name);
+            return Code();
+        }
+
+        // inline the other definition
+        expanding_->append(name);
+        if(!target_->dependencies_.contains(name)){
+            target_->dependencies_.append(name);
+        }
+        Code c;
+        QString message;
+        Parser inner(target_, definition, resolver_, expanding_);
+        if(!inner.parse(c, &message)){
+            fail(name + ": " + message);
+        }
+        expanding_->removeLast();
+        return c;
+    }
+
+    Code leaf(const Leaf& l)
+    {
+        for(int i = 0; i < target_->leaves_.size(); i++){
+            const Leaf& o = target_->leaves_[i];
+            if(o.type == l.type && o.name == l.name && o.wavelength == l.wavelength && o.thickness == l.thickness){
+                return Code({Instruction{PushLeaf, 0.0, i}});
+            }
+        }
+        target_->leaves_.append(l);
+        return Code({Instruction{PushLeaf, 0.0, target_->leaves_.size() - 1}});
+    }
+
+    PropertyExpression* target_;
+    QString    text_;
+    int        pos_;
+    Resolver   resolver_;
+    QStringList* expanding_;
+    QString    error_;
+};
+
+
+PropertyExpression::PropertyExpression()
+    : max_stack_(0)
+{
+}
+
+PropertyExpression PropertyExpression::compile(const QString &text, QString *errorMessage, const Resolver &resolver)
+{
+    PropertyExpression e;
+    e.text_ = text;
+
+    QStringList expanding;
+    QVector<Instruction> code;
+    Parser parser(&e, text, resolver, &expanding);
+    if(!parser.parse(code, errorMessage) || code.isEmpty()){
+        if(errorMessage && errorMessage->isEmpty()) *errorMessage = "Empty expression";
+        return PropertyExpression();
+    }
+
+    // stack depth
+    int depth = 0;
+    for(auto &ins : code){
+        switch(ins.op){
+        case PushConstant:
+        case PushLeaf:
+            depth++;
+            break;
+        case Add: case Sub: case Mul: case Div: case Pow: case Min: case Max:
+            depth--;
+            break;
+        default:
+            break;
+        }
+        e.max_stack_ = qMax(e.max_stack_, depth);
+    }
+
+    e.code_ = code;
+    return e;
+}
+
+double PropertyExpression::leafValue(const Leaf &leaf, const Glass *glass) const
+{
+    switch(leaf.type){
+    case Leaf::Property:
+        return glass->getValue(leaf.name);
+    case Leaf::Index:
+        return glass->refractiveIndex(leaf.wavelength);
+    case Leaf::DnDt:
+        return glass->hasThermalData() ? glass->dn_dt_abs(Glass::currentTemperature(), leaf.wavelength)*1.0e6 : qQNaN();
+    case Leaf::Transmittance:
+        return glass->internalTransmittance(leaf.wavelength, leaf.thickness);
+    }
+    return qQNaN();
+}
+
+void PropertyExpression::run(const double *leafValues, int count, double *result) const
+{
+    QVector<double> stack(max_stack_*count);
+    int top = 0; // number of arrays in the stack
+
+    double* base = stack.data();
+    for(auto &ins : code_){
+        double* a = base + qMax(0, top - 1)*count; // top array
+        double* b = base + qMax(0, top - 2)*count; // second array
+        switch(ins.op){
+        case PushConstant:
+            std::fill(base + top*count, base + (top + 1)*count, ins.value);
+            top++;
+            break;
+        case PushLeaf:
+            std::copy(leafValues + ins.leaf*count, leafValues + (ins.leaf + 1)*count, base + top*count);
+            top++;
+            break;
+        case Add: for(int i = 0; i < count; i++) b[i] += a[i];                  top--; break;
+        case Sub: for(int i = 0; i < count; i++) b[i] -= a[i];                  top--; break;
+        case Mul: for(int i = 0; i < count; i++) b[i] *= a[i];                  top--; break;
+        case Div: for(int i = 0; i < count; i++) b[i] /= a[i];                  top--; break;
+        case Pow: for(int i = 0; i < count; i++) b[i] = pow(b[i], a[i]);        top--; break;
+        case Min: for(int i = 0; i < count; i++) b[i] = qMin(b[i], a[i]);       top--; break;
+        case Max: for(int i = 0; i < count; i++) b[i] = qMax(b[i], a[i]);       top--; break;
+        case Neg:  for(int i = 0; i < count; i++) a[i] = -a[i];       break;
+        case Sqrt: for(int i = 0; i < count; i++) a[i] = sqrt(a[i]);  break;
+        case Abs:  for(int i = 0; i < count; i++) a[i] = fabs(a[i]);  break;
+        case Log:  for(int i = 0; i < count; i++) a[i] = log(a[i]);   break;
+        case Exp:  for(int i = 0; i < count; i++) a[i] = exp(a[i]);   break;
+        }
+    }
+
+    std::copy(stack.constData(), stack.constData() + count, result);
+}
+
+double PropertyExpression::evaluate(const Glass *glass) const
+{
+    if(!isValid()){
+        return qQNaN();
+    }
+
+    QVector<double> leafValues(leaves_.size());
+    for(int i = 0; i < leaves_.size(); i++){
+        leafValues[i] = leafValue(leaves_[i], glass);
+    }
+
+    double result;
+    run(leafValues.constData(), 1, &result);
+    return result;
+}
+
+QVector<double> PropertyExpression::evaluate(const QVector<const Glass *> &glasses) const
+{
+    QVector<double> result(glasses.size(), qQNaN());
+    if(!isValid()){
+        return result;
+    }
+
+    QVector<int> chunks;
+    for(int begin = 0; begin < glasses.size(); begin += kGlassChunkSize){
+        chunks.append(begin);
+    }
+
+    double* out = result.data();
+    QtConcurrent::blockingMap(chunks, [&](int begin){
+        const int count = qMin(kGlassChunkSize, glasses.size() - begin);
+
+        // leaves column by column
+        QVector<double> leafValues(leaves_.size()*count);
+        for(int l = 0; l < leaves_.size(); l++){
+            for(int i = 0; i < count; i++){
+                leafValues[l*count + i] = leafValue(leaves_[l], glasses[begin + i]);
+            }
+        }
+
+        run(leafValues.constData(), count, out + begin);
+    });
+
+    return result;
+}
@@ -0,0 +1,113 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef PROPERTY_EXPRESSION_H
+#define PROPERTY_EXPRESSION_H
+
+#include <functional>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class Glass;
+
+/**
+ * @brief User defined glass property compiled to a stack bytecode
+ * @details
+ * Grammar
+ *  - numbers, + - * / ^ (right associative), unary minus and parentheses
+ *  - built-in properties of Glass::getValue, e.g. nd, vd, relCost, lowTCE
+ *  - n<line> for the index at a spectral line, e.g. nF, nC, ng, nF_
+ *  - n(micron), dndT(micron) [10^-6/K] and tau(micron, thickness mm)
+ *  - sqrt, abs, log, exp, pow(x,y), min(x,y), max(x,y)
+ *  - other user defined properties, which are inlined
+ *
+ * The arguments of n, dndT and tau must be constant, so that those calls and the properties are
+ * the leaves of the expression.  Batch evaluation computes each leaf for a chunk of glasses,
+ * then runs each instruction over the whole chunk.
+ */
+class PropertyExpression
+{
+public:
+    /** returns the expression text of a user defined name, or empty if unknown */
+    typedef std::function<QString(const QString&)> Resolver;
+
+    PropertyExpression();
+
+    /**
+     * @brief Parse and compile the text
+     * @param resolver resolves the names of other user defined properties
+     * @return invalid expression with the message on error
+     */
+    static PropertyExpression compile(const QString& text, QString* errorMessage = nullptr, const Resolver& resolver = Resolver());
+
+    bool isValid() const{ return !code_.isEmpty(); }
+    QString text() const{ return text_; }
+
+    /** names of the user defined properties used by this expression, including indirect ones */
+    QStringList dependencies() const{ return dependencies_; }
+
+    double evaluate(const Glass* glass) const;
+
+    /** evaluate for all glasses.  Chunks of glasses are evaluated in parallel. */
+    QVector<double> evaluate(const QVector<const Glass*>& glasses) const;
+
+private:
+    enum OpCode{
+        PushConstant,
+        PushLeaf,
+        Add, Sub, Mul, Div, Pow,
+        Neg, Sqrt, Abs, Log, Exp,
+        Min, Max
+    };
+
+    struct Instruction{
+        OpCode op;
+        double value; // constant
+        int    leaf;  // leaf index
+    };
+
+    struct Leaf{
+        enum Type{ Property, Index, DnDt, Transmittance };
+        Type    type;
+        QString name;       // property
+        double  wavelength; // micron
+        double  thickness;  // mm
+    };
+
+    class Parser;
+
+    double leafValue(const Leaf& leaf, const Glass* glass) const;
+
+    /** evaluate count glasses with the leaf values, leafCount x count */
+    void run(const double* leafValues, int count, double* result) const;
+
+    QString              text_;
+    QVector<Instruction> code_;
+    QVector<Leaf>        leaves_;
+    QStringList          dependencies_;
+    int                  max_stack_;
+};
+
+#endif // PROPERTY_EXPRESSION_H
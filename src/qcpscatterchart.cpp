@@ -25,57 +25,429 @@
 
 #include "qcpscatterchart.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+QCPLabelGrid::QCPLabelGrid(QCustomPlot* parentPlot, double cellSize) :
+    QCPLayerable(parentPlot, parentPlot ? QString("background") : QString()),
+    m_cellSize(cellSize)
+{
+}
+
+void QCPLabelGrid::addPlottable(QCPScatterPlottable *plottable)
+{
+    if(!m_plottables.contains(plottable)){
+        m_plottables.append(plottable);
+    }
+}
+
+void QCPLabelGrid::removePlottable(QCPScatterPlottable *plottable)
+{
+    m_plottables.removeAll(plottable);
+}
+
+void QCPLabelGrid::draw(QCPPainter* painter)
+{
+    Q_UNUSED(painter)
+
+    // The background layer is drawn ahead of the plottables, so the labels are placed here and drawn by each plottable.
+    clear();
+    m_plottables.removeAll(nullptr);
+
+    struct Candidate{
+        int    priority;
+        int    plottable;
+        int    index;
+        QRectF rect;
+    };
+    QVector<Candidate> candidates;
+
+    for(int p = 0; p < m_plottables.size(); p++){
+        QCPScatterPlottable* plottable = m_plottables[p];
+        plottable->m_placedLabelRects.clear();
+        plottable->m_placedLabelIndices.clear();
+        if(!plottable->realVisibility() || !plottable->labelsVisible()){
+            continue;
+        }
+
+        QVector<int> indices;
+        QVector<QRectF> rects;
+        plottable->collectLabelRects(indices, rects);
+        for(int k = 0; k < indices.size(); k++){
+            const int priority = (indices[k] < plottable->m_labelPriorities.size()) ? plottable->m_labelPriorities[indices[k]] : 0;
+            candidates.append({priority, p, indices[k], rects[k]});
+        }
+    }
+
+    // ties are kept in the order of the plottables and their data
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b){
+        return a.priority < b.priority;
+    });
+
+    for(auto &c : candidates){
+        if(tryPlace(c.rect)){
+            QCPScatterPlottable* plottable = m_plottables[c.plottable];
+            plottable->m_placedLabelRects.append(c.rect);
+            plottable->m_placedLabelIndices.append(c.index);
+        }
+    }
+}
+
+void QCPLabelGrid::clear()
+{
+    m_cells.clear();
+}
+
+bool QCPLabelGrid::tryPlace(const QRectF& rect)
+{
+    const int left   = static_cast<int>(std::floor(rect.left()/m_cellSize));
+    const int right  = static_cast<int>(std::floor(rect.right()/m_cellSize));
+    const int top    = static_cast<int>(std::floor(rect.top()/m_cellSize));
+    const int bottom = static_cast<int>(std::floor(rect.bottom()/m_cellSize));
+
+    auto cellKey = [](int ix, int iy){
+        return (static_cast<quint64>(static_cast<quint32>(ix)) << 32) | static_cast<quint32>(iy);
+    };
+
+    for(int ix = left; ix <= right; ix++){
+        for(int iy = top; iy <= bottom; iy++){
+            auto it = m_cells.constFind(cellKey(ix, iy));
+            if(it == m_cells.constEnd()){
+                continue;
+            }
+            for(auto &placed : it.value()){
+                if(placed.intersects(rect)){
+                    return false;
+                }
+            }
+        }
+    }
+
+    for(int ix = left; ix <= right; ix++){
+        for(int iy = top; iy <= bottom; iy++){
+            m_cells[cellKey(ix, iy)].append(rect);
+        }
+    }
+    return true;
+}
+
+
+QCPScatterPlottable::QCPScatterPlottable(QCPAxis* keyAxis, QCPAxis* valueAxis) :
+    QCPAbstractPlottable(keyAxis, valueAxis),
+    m_labelsPrepared(false),
+    m_scatterStyle(QCPScatterStyle::ssDisc, 8),
+    m_pointsVisible(true),
+    m_labelsVisible(true)
+{
+}
+
+void QCPScatterPlottable::setData(const QVector<double>& x, const QVector<double>& y, const QVector<QString>& labels, const QVector<quint32>& handles, const QVector<int>& priorities)
+{
+    const int n = std::min(x.size(), y.size());
+    m_x = x.mid(0, n);
+    m_y = y.mid(0, n);
+    m_labelTexts = labels.mid(0, n);
+    m_handles    = handles.mid(0, n);
+    m_labelPriorities = (priorities.size() >= m_labelTexts.size()) ? priorities.mid(0, m_labelTexts.size()) : QVector<int>();
+
+    // labels of higher priority are placed first, otherwise in the data order
+    m_labelOrder.resize(m_labelTexts.size());
+    std::iota(m_labelOrder.begin(), m_labelOrder.end(), 0);
+    if(!m_labelPriorities.isEmpty()){
+        std::stable_sort(m_labelOrder.begin(), m_labelOrder.end(), [this](int a, int b){
+            return m_labelPriorities[a] < m_labelPriorities[b];
+        });
+    }
+
+    m_staticLabels.clear();
+    m_labelSizes.clear();
+    m_labelsPrepared = false;
+    m_placedLabelRects.clear();
+    m_placedLabelIndices.clear();
+}
+
+void QCPScatterPlottable::setScatterStyle(const QCPScatterStyle& style)
+{
+    m_scatterStyle = style;
+}
+
+void QCPScatterPlottable::setPointsVisible(bool state)
+{
+    m_pointsVisible = state;
+}
+
+void QCPScatterPlottable::setLabelsVisible(bool state)
+{
+    m_labelsVisible = state;
+    if(!state){
+        m_placedLabelRects.clear();
+        m_placedLabelIndices.clear();
+    }
+}
+
+void QCPScatterPlottable::setLabelGrid(QCPLabelGrid* grid)
+{
+    if(m_labelGrid){
+        m_labelGrid->removePlottable(this);
+    }
+    m_labelGrid = grid;
+    if(m_labelGrid){
+        m_labelGrid->addPlottable(this);
+    }
+}
+
+quint32 QCPScatterPlottable::handle(int index) const
+{
+    return (index >= 0 && index < m_handles.size()) ? m_handles[index] : 0;
+}
+
+QString QCPScatterPlottable::label(int index) const
+{
+    return (index >= 0 && index < m_labelTexts.size()) ? m_labelTexts[index] : QString();
+}
+
+void QCPScatterPlottable::prepareLabels(const QFont& font)
+{
+    if(m_labelsPrepared && font == m_preparedFont){
+        return;
+    }
+
+    const int n = m_labelTexts.size();
+    m_staticLabels.resize(n);
+    m_labelSizes.resize(n);
+    for(int i = 0; i < n; i++){
+        QStaticText& text = m_staticLabels[i];
+        text.setTextFormat(Qt::PlainText);
+        text.setPerformanceHint(QStaticText::AggressiveCaching);
+        text.setText(m_labelTexts[i]);
+        text.prepare(QTransform(), font);
+        m_labelSizes[i] = text.size();
+    }
+
+    m_preparedFont   = font;
+    m_labelsPrepared = true;
+}
+
+void QCPScatterPlottable::collectLabelRects(QVector<int> &indices, QVector<QRectF> &rects)
+{
+    indices.clear();
+    rects.clear();
+    if(!mKeyAxis || !mValueAxis || m_labelTexts.isEmpty()){
+        return;
+    }
+
+    prepareLabels(mParentPlot->font());
+
+    const QCPRange keyRange   = mKeyAxis->range();
+    const QCPRange valueRange = mValueAxis->range();
+    const QRectF   clip       = clipRect();
+    for(int i : m_labelOrder){
+        if(!keyRange.contains(m_x[i]) || !valueRange.contains(m_y[i])){
+            continue;
+        }
+
+        // aligned to the bottom right, as QCPItemText with Qt::AlignRight|Qt::AlignBottom
+        const QPointF pixel = coordsToPixels(m_x[i], m_y[i]);
+        const QSizeF  size  = m_labelSizes[i];
+        const QRectF  rect(pixel.x() - size.width(), pixel.y() - size.height(), size.width(), size.height());
+        if(clip.intersects(rect)){
+            indices.append(i);
+            rects.append(rect);
+        }
+    }
+}
+
+double QCPScatterPlottable::selectTest(const QPointF& pos, bool onlySelectable, QVariant* details) const
+{
+    if((onlySelectable && mSelectable == QCP::stNone) || !mKeyAxis || !mValueAxis){
+        return -1;
+    }
+    if(!mKeyAxis->axisRect()->rect().contains(pos.toPoint())){
+        return -1;
+    }
+
+    int    hitIndex = -1;
+    double hitDistance = -1;
+
+    // labels shown in the last replot
+    if(m_labelsVisible){
+        for(int i = 0; i < m_placedLabelRects.size(); i++){
+            if(m_placedLabelRects[i].contains(pos)){
+                hitIndex    = m_placedLabelIndices[i];
+                hitDistance = 0;
+                break;
+            }
+        }
+    }
+
+    // nearest point
+    if(hitIndex < 0 && m_pointsVisible){
+        const QCPRange keyRange   = mKeyAxis->range();
+        const QCPRange valueRange = mValueAxis->range();
+        double minSquared = std::numeric_limits<double>::max();
+        for(int i = 0; i < m_x.size(); i++){
+            if(!keyRange.contains(m_x[i]) || !valueRange.contains(m_y[i])){
+                continue;
+            }
+            const QPointF d = coordsToPixels(m_x[i], m_y[i]) - pos;
+            const double squared = d.x()*d.x() + d.y()*d.y();
+            if(squared < minSquared){
+                minSquared = squared;
+                hitIndex   = i;
+            }
+        }
+        if(hitIndex >= 0){
+            hitDistance = std::sqrt(minSquared);
+        }
+    }
+
+    if(hitIndex >= 0 && details){
+        details->setValue(QCPDataSelection(QCPDataRange(hitIndex, hitIndex+1)));
+    }
+    return hitDistance;
+}
+
+QCPRange QCPScatterPlottable::getKeyRange(bool& foundRange, QCP::SignDomain inSignDomain) const
+{
+    QCPRange range;
+    foundRange = false;
+    for(double x : m_x){
+        if(!std::isfinite(x) || (inSignDomain == QCP::sdPositive && x <= 0) || (inSignDomain == QCP::sdNegative && x >= 0)){
+            continue;
+        }
+        if(!foundRange){
+            range = QCPRange(x, x);
+            foundRange = true;
+        }else{
+            range.expand(x);
+        }
+    }
+    return range;
+}
+
+QCPRange QCPScatterPlottable::getValueRange(bool& foundRange, QCP::SignDomain inSignDomain, const QCPRange& inKeyRange) const
+{
+    const bool restrictKeys = (inKeyRange != QCPRange());
+
+    QCPRange range;
+    foundRange = false;
+    for(int i = 0; i < m_y.size(); i++){
+        const double y = m_y[i];
+        if(!std::isfinite(y) || (inSignDomain == QCP::sdPositive && y <= 0) || (inSignDomain == QCP::sdNegative && y >= 0)){
+            continue;
+        }
+        if(restrictKeys && !inKeyRange.contains(m_x[i])){
+            continue;
+        }
+        if(!foundRange){
+            range = QCPRange(y, y);
+            foundRange = true;
+        }else{
+            range.expand(y);
+        }
+    }
+    return range;
+}
+
+void QCPScatterPlottable::draw(QCPPainter* painter)
+{
+    if(!mKeyAxis || !mValueAxis || m_x.isEmpty()){
+        return;
+    }
+
+    // points culled to the viewport
+    if(m_pointsVisible && m_scatterStyle.shape() != QCPScatterStyle::ssNone){
+        const QCPRange keyRange   = mKeyAxis->range();
+        const QCPRange valueRange = mValueAxis->range();
+        applyScattersAntialiasingHint(painter);
+        m_scatterStyle.applyTo(painter, mPen);
+        for(int i = 0; i < m_x.size(); i++){
+            if(keyRange.contains(m_x[i]) && valueRange.contains(m_y[i])){
+                m_scatterStyle.drawShape(painter, coordsToPixels(m_x[i], m_y[i]));
+            }
+        }
+    }
+
+    if(m_labelsVisible && !m_labelTexts.isEmpty()){
+        // Without a shared grid, the labels of this chart are decluttered among themselves.
+        // Otherwise they have been placed by the grid in this drawing pass.
+        if(!m_labelGrid){
+            QVector<int> indices;
+            QVector<QRectF> rects;
+            collectLabelRects(indices, rects);
+
+            QCPLabelGrid localGrid;
+            m_placedLabelRects.clear();
+            m_placedLabelIndices.clear();
+            for(int k = 0; k < indices.size(); k++){
+                if(localGrid.tryPlace(rects[k])){
+                    m_placedLabelRects.append(rects[k]);
+                    m_placedLabelIndices.append(indices[k]);
+                }
+            }
+        }
+
+        const QFont font = mParentPlot->font();
+        prepareLabels(font);
+        painter->setFont(font);
+        painter->setPen(QPen(Qt::black));
+        painter->setBrush(Qt::NoBrush);
+        applyDefaultAntialiasingHint(painter);
+
+        for(int k = 0; k < m_placedLabelIndices.size(); k++){
+            painter->drawStaticText(m_placedLabelRects[k].topLeft(), m_staticLabels[m_placedLabelIndices[k]]);
+        }
+    }
+}
+
+void QCPScatterPlottable::drawLegendIcon(QCPPainter* painter, const QRectF& rect) const
+{
+    if(m_scatterStyle.shape() != QCPScatterStyle::ssNone){
+        applyScattersAntialiasingHint(painter);
+        m_scatterStyle.applyTo(painter, mPen);
+        m_scatterStyle.drawShape(painter, QRectF(rect).center());
+    }
+}
+
+
 QCPScatterChart::QCPScatterChart(QCustomPlot *customPlot)
 {  
     m_customPlot = customPlot;
 
-    m_graphPoints = new QCPCurve(m_customPlot->xAxis, m_customPlot->yAxis);
-
-    m_textlabels.clear();
+    m_plottable = new QCPScatterPlottable(m_customPlot->xAxis, m_customPlot->yAxis);
 }
 
 QCPScatterChart::~QCPScatterChart()
 {
-    // delete graph
+    // delete points and labels
     try {
-        m_customPlot->removePlottable(m_graphPoints);
+        m_customPlot->removePlottable(m_plottable);
     }  catch (...) {
         qDebug() << "delete error: ~QCPScatterChart";
     }
-    m_graphPoints = nullptr;
-
-    // delete text labels
-    int labelCount = m_textlabels.size();
-    for(int i = 0; i < labelCount; i++){
-        try {
-            m_customPlot->removeItem(m_textlabels[i]);
-        }  catch (...) {
-            qDebug() << "delete error: ~QCPScatterChart";
-        }
-        m_textlabels[i] = nullptr;
-    }
-    m_textlabels.clear();
+    m_plottable = nullptr;
 
     m_customPlot = nullptr;
 }
 
 QCPScatterChart::QCPScatterChart(QCPScatterChart &other)
 {
-    m_customPlot  = other.parentPlot();
-    m_graphPoints = other.graphPoints();
-    m_textlabels  = other.textLabels();
+    m_customPlot = other.parentPlot();
+    m_plottable  = other.plottable();
 }
 
 void QCPScatterChart::setName(QString name)
 {
-    m_graphPoints->setName(name);
+    m_plottable->setName(name);
 }
 
 void QCPScatterChart::setColor(QColor color)
 {
     QPen pen;
     pen.setColor(color);
-    m_graphPoints->setPen(pen);
+    m_plottable->setPen(pen);
 }
 
 QCustomPlot* QCPScatterChart::parentPlot() const
@@ -83,73 +455,51 @@ QCustomPlot* QCPScatterChart::parentPlot() const
     return m_customPlot;
 }
 
-QCPCurve* QCPScatterChart::graphPoints() const
+QCPScatterPlottable* QCPScatterChart::plottable() const
 {
-    return m_graphPoints;
-}
-
-QList<QCPItemText*> QCPScatterChart::textLabels() const
-{
-    return m_textlabels;
+    return m_plottable;
 }
 
 QString QCPScatterChart::name() const
 {
-    return m_graphPoints->name();
+    return m_plottable->name();
 }
 
-void QCPScatterChart::setData(const QVector<double>& x, const QVector<double>& y, const QVector<QString>& label_texts)
+void QCPScatterChart::setData(const QVector<double>& x, const QVector<double>& y, const QVector<QString>& label_texts, const QVector<quint32>& handles, const QVector<int>& priorities)
 {   
-    //set data to points
-    m_graphPoints->setData(x,y);
-    m_graphPoints->setLineStyle(QCPCurve::lsNone);
-    m_graphPoints->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssDisc,8));
-
-
-    //clear current text labels and recreate
-    if(!m_textlabels.isEmpty())
-    {
-        int labelCount = m_textlabels.size();
-        for(int i = 0; i < labelCount; i++){
-            try {
-                m_customPlot->removeItem(m_textlabels[i]);
-            }  catch (...) {
-                m_textlabels[i] = nullptr;
-            }
-            m_textlabels[i] = nullptr;
-        }
-    }
-    m_textlabels.clear();
-
-    QCPItemText *label;
-    int nlabels = label_texts.size();
-    for(int i = 0; i < nlabels; i++){
-        label = new QCPItemText(m_customPlot);
-        label->position->setCoords(x[i],y[i]);
-        label->setPositionAlignment(Qt::AlignRight|Qt::AlignBottom);
-        label->setText(label_texts[i]);
-        label->setObjectName(label_texts[i]); //used for mouse click
-        m_textlabels.append(label);
-    }
-
+    m_plottable->setData(x, y, label_texts, handles, priorities);
 }
 
 void QCPScatterChart::setVisiblePointSeries(bool state)
 {    
-    m_graphPoints->setVisible(state);
+    if(m_plottable->pointsVisible() == state){
+        return;
+    }
+    m_plottable->setPointsVisible(state);
+    m_plottable->setVisible(state || m_plottable->labelsVisible());
+    if(state){
+        m_plottable->addToLegend();
+    }else{
+        m_plottable->removeFromLegend();
+    }
 }
 
 void QCPScatterChart::setVisibleTextLabels(bool state)
 {
-    int nlabels = m_textlabels.size();
-    for(int i = 0; i < nlabels; i++){
-        m_textlabels[i]->setVisible(state);
+    if(m_plottable->labelsVisible() == state){
+        return;
     }
+    m_plottable->setLabelsVisible(state);
+    m_plottable->setVisible(state || m_plottable->pointsVisible());
 }
 
-int QCPScatterChart::dataCount() const
+void QCPScatterChart::setLabelGrid(QCPLabelGrid* grid)
 {
-    return m_textlabels.size();
+    m_plottable->setLabelGrid(grid);
 }
 
+int QCPScatterChart::dataCount() const
+{
+    return m_plottable->dataCount();
+}
 
@@ -26,8 +26,115 @@
 #ifndef QCPSCATTERCHART_H
 #define QCPSCATTERCHART_H
 
+#include <QHash>
+#include <QPointer>
+#include <QStaticText>
 #include "qcustomplot.h"
 
+class QCPScatterPlottable;
+
+/**
+ * @brief Screen-space grid of the text labels placed in the current drawing pass
+ * @details Shared by the scatter charts of a plot so that labels of different series do not overlap either.
+ *          When created with a plot, it sits on the "background" layer. At the start of each replot or export it places the labels
+ *          of all its plottables in ascending order of priority, so that priority applies across the plottables.
+ */
+class QCPLabelGrid : public QCPLayerable
+{
+    Q_OBJECT
+
+public:
+    explicit QCPLabelGrid(QCustomPlot* parentPlot = nullptr, double cellSize = 32.0);
+
+    void clear();
+
+    /** @brief Occupy the rect unless it overlaps a rect placed before */
+    bool tryPlace(const QRectF& rect);
+
+    /** Plottables whose labels are placed by this grid.  Called by QCPScatterPlottable::setLabelGrid. */
+    void addPlottable(QCPScatterPlottable* plottable);
+    void removePlottable(QCPScatterPlottable* plottable);
+
+protected:
+    void applyDefaultAntialiasingHint(QCPPainter* painter) const override { Q_UNUSED(painter) }
+    void draw(QCPPainter* painter) override;
+
+private:
+    double m_cellSize;
+    QHash<quint64, QVector<QRectF>> m_cells;
+    QList< QPointer<QCPScatterPlottable> > m_plottables;
+};
+
+
+/**
+ * @brief Plottable drawing all the points and text labels of a scatter chart in one pass
+ * @details Points outside the axis ranges are skipped. Labels are placed in ascending order of priority and dropped where they would overlap a label placed before.
+ *          With a shared label grid, the grid places the labels of all its plottables before they are drawn.
+ *          Glyph layouts of the labels are cached and reused across replots.
+ */
+class QCPScatterPlottable : public QCPAbstractPlottable
+{
+    Q_OBJECT
+
+public:
+    QCPScatterPlottable(QCPAxis* keyAxis, QCPAxis* valueAxis);
+
+    /**
+     * @brief Set points and their text labels
+     * @param priorities label priority of each point, smaller is placed first. Empty for the data order.
+     */
+    void setData(const QVector<double>& x, const QVector<double>& y, const QVector<QString>& labels, const QVector<quint32>& handles, const QVector<int>& priorities = QVector<int>());
+    void setScatterStyle(const QCPScatterStyle& style);
+    void setPointsVisible(bool state);
+    void setLabelsVisible(bool state);
+    void setLabelGrid(QCPLabelGrid* grid);
+
+    bool    pointsVisible() const { return m_pointsVisible; }
+    bool    labelsVisible() const { return m_labelsVisible; }
+    int     dataCount() const { return m_x.size(); }
+    quint32 handle(int index) const;
+    QString label(int index) const;
+
+    /** @details The index of the hit point is returned as QCPDataSelection in details, which is passed to QCustomPlot::plottableClick. */
+    double   selectTest(const QPointF& pos, bool onlySelectable, QVariant* details = nullptr) const override;
+    QCPRange getKeyRange(bool& foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth) const override;
+    QCPRange getValueRange(bool& foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth, const QCPRange& inKeyRange = QCPRange()) const override;
+
+protected:
+    void draw(QCPPainter* painter) override;
+    void drawLegendIcon(QCPPainter* painter, const QRectF& rect) const override;
+
+private:
+    friend class QCPLabelGrid;
+
+    void prepareLabels(const QFont& font);
+
+    /** @brief Labels of the points in the viewport in ascending order of priority, with their rects in pixels */
+    void collectLabelRects(QVector<int>& indices, QVector<QRectF>& rects);
+
+    QVector<double>      m_x;
+    QVector<double>      m_y;
+    QVector<QString>     m_labelTexts;
+    QVector<quint32>     m_handles;
+    QVector<int>         m_labelPriorities;
+    QVector<int>         m_labelOrder;      // point indices sorted by priority
+    QVector<QStaticText> m_staticLabels;    // cached glyph layouts
+    QVector<QSizeF>      m_labelSizes;
+    QFont                m_preparedFont;
+    bool                 m_labelsPrepared;
+
+    QCPScatterStyle m_scatterStyle;
+    bool            m_pointsVisible;
+    bool            m_labelsVisible;
+
+    QPointer<QCPLabelGrid> m_labelGrid;
+
+    // labels placed in the last replot, used for hit test
+    QVector<QRectF> m_placedLabelRects;
+    QVector<int>    m_placedLabelIndices;
+};
+
+
 /** Class for scatter chart using QCustomPlot */
 class QCPScatterChart
 {
@@ -37,23 +144,28 @@ public:
     ~QCPScatterChart();
     QCPScatterChart(QCPScatterChart &other);
 
-    QCustomPlot*        parentPlot() const;
-    QCPCurve*           graphPoints() const;
-    QList<QCPItemText*> textLabels() const;
-    QString             name() const;
+    QCustomPlot*         parentPlot() const;
+    QCPScatterPlottable* plottable() const;
+    QString              name() const;
 
-    void setData(const QVector<double>& x, const QVector<double>& y, const QVector<QString>& label_texts);
+    /**
+     * @brief Set points and their text labels
+     * @param handles glass handles of the points, used for mouse click
+     * @param priorities label priority of each point, smaller is shown first where labels overlap
+     */
+    void setData(const QVector<double>& x, const QVector<double>& y, const QVector<QString>& label_texts, const QVector<quint32>& handles = QVector<quint32>(), const QVector<int>& priorities = QVector<int>());
     void setName(QString name);
     void setColor(QColor color);
+    /** the point series is also removed from the legend while hidden */
     void setVisiblePointSeries(bool state);
     void setVisibleTextLabels(bool state);
+    void setLabelGrid(QCPLabelGrid* grid);
     void setAxis(QCPRange xrange, QCPRange yrange);
     int  dataCount() const;
 
 private:
-    QCustomPlot*        m_customPlot;
-    QCPCurve*           m_graphPoints; //points
-    QList<QCPItemText*> m_textlabels; // text label for each point
+    QCustomPlot*         m_customPlot;
+    QCPScatterPlottable* m_plottable; // points and text labels
 
 };
 
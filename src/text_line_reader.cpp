@@ -0,0 +1,212 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "text_line_reader.h"
+
+#include <QTextCodec>
+
+TextLineReader::TextLineReader(QIODevice* device) :
+    device_(device),
+    buffer_pos_(0),
+    scan_pos_(0),
+    buffer_offset_(0)
+{
+    detectEncoding();
+}
+
+TextLineReader::TextLineReader(QIODevice* device, Encoding encoding) :
+    device_(device),
+    buffer_pos_(0),
+    scan_pos_(0),
+    buffer_offset_(0)
+{
+    setEncoding(encoding);
+}
+
+void TextLineReader::setEncoding(Encoding encoding)
+{
+    encoding_ = encoding;
+
+    switch (encoding) {
+    case Utf8:
+        codec_     = QTextCodec::codecForName("UTF-8");
+        char_size_ = 1;
+        break;
+    case Utf16LE:
+        codec_     = QTextCodec::codecForName("UTF-16LE");
+        char_size_ = 2;
+        break;
+    case Utf16BE:
+        codec_     = QTextCodec::codecForName("UTF-16BE");
+        char_size_ = 2;
+        break;
+    default:
+        codec_     = QTextCodec::codecForLocale();
+        char_size_ = 1;
+    }
+}
+
+void TextLineReader::detectEncoding()
+{
+    // the first chunk is large enough to contain BOM
+    fillBuffer();
+
+    const uchar* b = reinterpret_cast<const uchar*>(buffer_.constData());
+    int size = buffer_.size();
+    int bomSize = 0;
+
+    if(size >= 3 && b[0] == 0xEF && b[1] == 0xBB && b[2] == 0xBF){
+        setEncoding(Utf8);
+        bomSize = 3;
+    }
+    else if(size >= 2 && b[0] == 0xFF && b[1] == 0xFE){
+        setEncoding(Utf16LE);
+        bomSize = 2;
+    }
+    else if(size >= 2 && b[0] == 0xFE && b[1] == 0xFF){
+        setEncoding(Utf16BE);
+        bomSize = 2;
+    }
+    else if(size >= 2 && b[0] != 0 && b[1] == 0){ // UTF-16 without BOM
+        setEncoding(Utf16LE);
+    }
+    else if(size >= 2 && b[0] == 0 && b[1] != 0){
+        setEncoding(Utf16BE);
+    }
+    else{
+        setEncoding(Local8Bit);
+    }
+
+    buffer_pos_ = bomSize;
+    scan_pos_   = bomSize;
+}
+
+bool TextLineReader::fillBuffer()
+{
+    // drop the lines already read
+    if(buffer_pos_ > 0){
+        buffer_.remove(0, buffer_pos_);
+        buffer_offset_ += buffer_pos_;
+        scan_pos_      -= buffer_pos_;
+        buffer_pos_     = 0;
+    }
+
+    QByteArray chunk = device_->read(chunk_size_);
+    if(chunk.isEmpty()){
+        return false;
+    }
+
+    buffer_.append(chunk);
+    return true;
+}
+
+ushort TextLineReader::charAt(const QByteArray& bytes, int i) const
+{
+    const uchar* b = reinterpret_cast<const uchar*>(bytes.constData());
+
+    switch (encoding_) {
+    case Utf16LE:
+        return ushort(b[i] | (b[i+1] << 8));
+    case Utf16BE:
+        return ushort((b[i] << 8) | b[i+1]);
+    default:
+        return b[i];
+    }
+}
+
+bool TextLineReader::readLine(QByteArray& line, qint64& lineOffset)
+{
+    forever
+    {
+        for(; scan_pos_ + char_size_ <= buffer_.size(); scan_pos_ += char_size_)
+        {
+            if(charAt(buffer_, scan_pos_) == '\n'){
+                int lineEnd = scan_pos_;
+                if(lineEnd - buffer_pos_ >= char_size_ && charAt(buffer_, lineEnd - char_size_) == '\r'){
+                    lineEnd -= char_size_;
+                }
+
+                line       = buffer_.mid(buffer_pos_, lineEnd - buffer_pos_);
+                lineOffset = buffer_offset_ + buffer_pos_;
+
+                scan_pos_  += char_size_;
+                buffer_pos_ = scan_pos_;
+                return true;
+            }
+        }
+
+        if(!fillBuffer()){
+            // the last line without line terminator
+            if(buffer_pos_ < buffer_.size()){
+                int lineEnd = buffer_.size() - (buffer_.size() - buffer_pos_) % char_size_;
+                if(lineEnd - buffer_pos_ >= char_size_ && charAt(buffer_, lineEnd - char_size_) == '\r'){
+                    lineEnd -= char_size_;
+                }
+
+                line       = buffer_.mid(buffer_pos_, lineEnd - buffer_pos_);
+                lineOffset = buffer_offset_ + buffer_pos_;
+
+                buffer_pos_ = buffer_.size();
+                scan_pos_   = buffer_.size();
+                return true;
+            }
+            return false;
+        }
+    }
+}
+
+QString TextLineReader::decode(const QByteArray& line) const
+{
+    return codec_->toUnicode(line);
+}
+
+bool TextLineReader::startsWith(const QByteArray& line, const char* tag) const
+{
+    for(int i = 0; tag[i] != '\0'; i++){
+        int pos = i*char_size_;
+        if(pos + char_size_ > line.size() || charAt(line, pos) != ushort(uchar(tag[i]))){
+            return false;
+        }
+    }
+    return true;
+}
+
+int TextLineReader::tokenCount(const QByteArray& line) const
+{
+    int  count = 0;
+    bool inToken = false;
+
+    for(int i = 0; i + char_size_ <= line.size(); i += char_size_)
+    {
+        ushort c = charAt(line, i);
+        bool isSpace = (c == ' ' || c == '\t' || c == '\r');
+
+        if(!isSpace && !inToken){
+            count++;
+        }
+        inToken = !isSpace;
+    }
+
+    return count;
+}
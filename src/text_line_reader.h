@@ -0,0 +1,95 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef TEXT_LINE_READER_H
+#define TEXT_LINE_READER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QString>
+
+class QTextCodec;
+
+/**
+ * @brief Line reader which keeps track of the byte offset of each line
+ * @details Lines are returned as raw bytes so that callers can test a line tag without decoding the whole line.
+ *          Catalog files are read in chunks, and both 8-bit and UTF-16 encoded files are supported.
+ */
+class TextLineReader
+{
+public:
+    enum Encoding{
+        Local8Bit,
+        Utf8,
+        Utf16LE,
+        Utf16BE
+    };
+
+    /** Construct a reader whose encoding is detected from the leading bytes of the device */
+    explicit TextLineReader(QIODevice* device);
+
+    /** Construct a reader for a device whose encoding is already known, e.g. a section of a file */
+    TextLineReader(QIODevice* device, Encoding encoding);
+
+    Encoding encoding() const {return encoding_;}
+
+    /** Byte offset of the next line */
+    qint64 pos() const {return buffer_offset_ + buffer_pos_;}
+
+    /**
+     * @brief Read the next line
+     * @param line raw bytes of the line without line terminator
+     * @param lineOffset byte offset of the line start in the device
+     * @return false if no line is left
+     */
+    bool readLine(QByteArray& line, qint64& lineOffset);
+
+    QString decode(const QByteArray& line) const;
+
+    /** Check if the line starts with the given ASCII tag */
+    bool startsWith(const QByteArray& line, const char* tag) const;
+
+    /** Count whitespace separated tokens in the line */
+    int  tokenCount(const QByteArray& line) const;
+
+private:
+    void   setEncoding(Encoding encoding);
+    void   detectEncoding();
+    bool   fillBuffer();
+    ushort charAt(const QByteArray& bytes, int i) const;
+
+    static constexpr int chunk_size_ = 64*1024;
+
+    QIODevice*  device_;
+    QTextCodec* codec_;
+    Encoding    encoding_;
+    int         char_size_;
+
+    QByteArray  buffer_;
+    int         buffer_pos_;    // start of the next line in the buffer
+    int         scan_pos_;      // position to resume searching the line terminator
+    qint64      buffer_offset_; // byte offset of the buffer head in the device
+};
+
+#endif // TEXT_LINE_READER_H
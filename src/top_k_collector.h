@@ -0,0 +1,95 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef TOP_K_COLLECTOR_H
+#define TOP_K_COLLECTOR_H
+
+#include <algorithm>
+#include <QVector>
+
+/**
+ * @brief Keeps the best k of the pushed items
+ * @details The items are held in a max-heap on Less, so the worst kept item is available in O(1)
+ *          and can be used as a pruning threshold.
+ */
+template<class T, class Less>
+class TopKCollector
+{
+public:
+    explicit TopKCollector(int k = 0, Less less = Less()) : k_(k), less_(less)
+    {
+        heap_.reserve(k + 1);
+    }
+
+    int  capacity() const{ return k_; }
+    bool isFull() const{ return heap_.size() >= k_; }
+
+    /** worst of the kept items. Valid only if not empty. */
+    const T& worst() const{ return heap_.front(); }
+
+    /** true if the item would be kept */
+    bool accepts(const T& item) const
+    {
+        return (k_ > 0) && (!isFull() || less_(item, heap_.front()));
+    }
+
+    void push(const T& item)
+    {
+        if(k_ <= 0){
+            return;
+        }
+
+        if(!isFull()){
+            heap_.append(item);
+            std::push_heap(heap_.begin(), heap_.end(), less_);
+        }
+        else if(less_(item, heap_.front())){
+            std::pop_heap(heap_.begin(), heap_.end(), less_);
+            heap_.back() = item;
+            std::push_heap(heap_.begin(), heap_.end(), less_);
+        }
+    }
+
+    void merge(const TopKCollector& other)
+    {
+        for(auto &item : other.heap_){
+            push(item);
+        }
+    }
+
+    /** kept items from best to worst */
+    QVector<T> sorted() const
+    {
+        QVector<T> items = heap_;
+        std::sort(items.begin(), items.end(), less_);
+        return items;
+    }
+
+private:
+    int        k_;
+    Less       less_;
+    QVector<T> heap_;
+};
+
+#endif // TOP_K_COLLECTOR_H
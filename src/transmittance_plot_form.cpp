@@ -89,6 +89,7 @@ TransmittancePlotForm::TransmittancePlotForm(QWidget *parent) :
 TransmittancePlotForm::~TransmittancePlotForm()
 {
     m_glassList.clear();
+    m_snapshotList.clear();
 
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
@@ -117,6 +118,7 @@ void TransmittancePlotForm::addGraph()
     {
         Glass* newGlass = dlg->getSelectedGlass();
         m_glassList.append(newGlass);
+        m_snapshotList.append(dlg->snapshot());
         updateAll();
     }
 
@@ -212,6 +214,7 @@ void TransmittancePlotForm::deleteGraph()
         for(int i = 0;i < glassCount; i++){
             if(m_glassList[i]->productName() == glass_supplier[0] && m_glassList[i]->supplier() == glass_supplier[1]){
                 m_glassList.removeAt(i);
+                m_snapshotList.removeAt(i);
                 break;
             }
         }
@@ -223,6 +226,7 @@ void TransmittancePlotForm::deleteGraph()
 void TransmittancePlotForm::clearAll()
 {
     m_glassList.clear();
+    m_snapshotList.clear();
     m_customPlot->clearGraphs();
     m_customPlot->clearItems();
     m_customPlot->replot();
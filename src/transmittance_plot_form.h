@@ -27,6 +27,7 @@
 
 #include "property_plot_form.h"
 #include "glass.h"
+#include "catalog_snapshot.h"
 
 namespace Ui {
 class TransmittancePlotForm;
@@ -51,6 +52,7 @@ private:
     Ui::TransmittancePlotForm *ui;
 
     QList<Glass*>  m_glassList;
+    QList<CatalogSnapshotPtr> m_snapshotList; // keeps each glass of m_glassList alive
     QLineEdit* m_editThickness;
 
 };
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "user_property_dialog.h"
+#include "ui_user_property_dialog.h"
+
+#include <QMessageBox>
+#include <QHeaderView>
+
+UserPropertyDialog::UserPropertyDialog(GlobalSettingsIO *settings, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::UserPropertyDialog)
+{
+    ui->setupUi(this);
+    this->setWindowTitle("User Properties");
+
+    m_globalSettings = settings;
+
+    ui->tableWidget->setColumnCount(2);
+    ui->tableWidget->setHorizontalHeaderLabels(QStringList({"Name", "Expression"}));
+    ui->tableWidget->horizontalHeader()->setStretchLastSection(true);
+    ui->tableWidget->verticalHeader()->setVisible(false);
+
+    QList<UserPropertyRegistry::Definition> definitions = UserPropertyRegistry::definitions();
+    ui->tableWidget->setRowCount(definitions.size());
+    for(int i = 0; i < definitions.size(); i++){
+        setRow(i, definitions[i]);
+    }
+
+    QObject::connect(ui->pushButton_Add,    SIGNAL(clicked()),  this, SLOT(addRow()));
+    QObject::connect(ui->pushButton_Remove, SIGNAL(clicked()),  this, SLOT(removeRow()));
+    QObject::connect(ui->buttonBox,         SIGNAL(accepted()), this, SLOT(onAccept()));
+}
+
+UserPropertyDialog::~UserPropertyDialog()
+{
+    m_globalSettings = nullptr;
+    delete ui;
+}
+
+void UserPropertyDialog::setRow(int row, const UserPropertyRegistry::Definition &def)
+{
+    ui->tableWidget->setItem(row, 0, new QTableWidgetItem(def.name));
+    ui->tableWidget->setItem(row, 1, new QTableWidgetItem(def.expression));
+}
+
+void UserPropertyDialog::addRow()
+{
+    int row = ui->tableWidget->rowCount();
+    ui->tableWidget->insertRow(row);
+    setRow(row, UserPropertyRegistry::Definition());
+    ui->tableWidget->editItem(ui->tableWidget->item(row, 0));
+}
+
+void UserPropertyDialog::removeRow()
+{
+    int row = ui->tableWidget->currentRow();
+    if(row >= 0){
+        ui->tableWidget->removeRow(row);
+    }
+}
+
+void UserPropertyDialog::onAccept()
+{
+    QList<UserPropertyRegistry::Definition> definitions;
+    for(int i = 0; i < ui->tableWidget->rowCount(); i++){
+        UserPropertyRegistry::Definition def;
+        def.name       = ui->tableWidget->item(i, 0) ? ui->tableWidget->item(i, 0)->text().trimmed() : QString();
+        def.expression = ui->tableWidget->item(i, 1) ? ui->tableWidget->item(i, 1)->text().trimmed() : QString();
+        if(def.name.isEmpty() && def.expression.isEmpty()){
+            continue;
+        }
+        definitions.append(def);
+    }
+
+    QString errorMessage;
+    if(!UserPropertyRegistry::setDefinitions(definitions, &errorMessage)){
+        QMessageBox::warning(this, tr("Error"), errorMessage);
+        return;
+    }
+
+    m_globalSettings->setUserProperties(definitions);
+    m_globalSettings->saveIniFile();
+
+    accept();
+}
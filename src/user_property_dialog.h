@@ -0,0 +1,56 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef USER_PROPERTY_DIALOG_H
+#define USER_PROPERTY_DIALOG_H
+
+#include <QDialog>
+#include "global_settings_io.h"
+
+namespace Ui {
+class UserPropertyDialog;
+}
+
+/** Editor of the user defined glass properties */
+class UserPropertyDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit UserPropertyDialog(GlobalSettingsIO *settings, QWidget *parent = nullptr);
+    ~UserPropertyDialog();
+
+private slots:
+    void addRow();
+    void removeRow();
+    void onAccept();
+
+private:
+    void setRow(int row, const UserPropertyRegistry::Definition& def);
+
+    Ui::UserPropertyDialog *ui;
+    GlobalSettingsIO *m_globalSettings;
+};
+
+#endif // USER_PROPERTY_DIALOG_H
@@ -0,0 +1,138 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#include "user_property_registry.h"
+
+#include <QRegularExpression>
+
+std::shared_ptr<const UserPropertyRegistry::State> UserPropertyRegistry::m_state = std::make_shared<const UserPropertyRegistry::State>();
+
+std::shared_ptr<const UserPropertyRegistry::State> UserPropertyRegistry::state()
+{
+    return std::atomic_load(&m_state);
+}
+
+int UserPropertyRegistry::compileDefinitions(const QList<Definition> &definitions, State *state, QString *errorMessage)
+{
+    static const QRegularExpression reName("^[A-Za-z_][A-Za-z0-9_]*$");
+    static const QStringList reserved({"n", "dndT", "tau", "sqrt", "abs", "log", "exp", "pow", "min", "max"});
+
+    *state = State();
+
+    QMap<QString, QString> texts;
+    QStringList names;
+    for(int i = 0; i < definitions.size(); i++){
+        const Definition& def = definitions[i];
+        QString error;
+        if(!reName.match(def.name).hasMatch()){
+            error = "Invalid name";
+        }
+        else if(reserved.contains(def.name) || PropertyExpression::compile(def.name).isValid()){
+            // built-in properties and n<line>
+            error = "Reserved name";
+        }
+        else if(texts.contains(def.name)){
+            error = "Duplicated name";
+        }
+        else if(def.expression.trimmed().isEmpty()){
+            error = "Empty expression";
+        }
+
+        if(!error.isEmpty()){
+            if(errorMessage) *errorMessage = def.name + ": " + error;
+            return i;
+        }
+
+        texts.insert(def.name, def.expression);
+        names.append(def.name);
+    }
+
+    auto resolver = [&texts](const QString& name){ return texts.value(name); };
+
+    for(int i = 0; i < definitions.size(); i++){
+        const Definition& def = definitions[i];
+        QString error;
+        auto e = std::make_shared<const PropertyExpression>(PropertyExpression::compile(def.expression, &error, resolver));
+        if(!e->isValid()){
+            if(errorMessage) *errorMessage = def.name + ": " + error;
+            return i;
+        }
+        state->expressions.insert(def.name, e);
+    }
+    state->definitions = definitions;
+    state->names       = names;
+
+    return -1;
+}
+
+bool UserPropertyRegistry::setDefinitions(const QList<Definition> &definitions, QString *errorMessage)
+{
+    auto newState = std::make_shared<State>();
+    if(compileDefinitions(definitions, newState.get(), errorMessage) >= 0){
+        return false;
+    }
+    newState->revision = state()->revision + 1;
+
+    std::atomic_store(&m_state, std::shared_ptr<const State>(newState));
+    return true;
+}
+
+int UserPropertyRegistry::setValidDefinitions(const QList<Definition> &definitions, QStringList *errorMessages)
+{
+    // Removing a definition may invalidate the ones referring to it, so the rest is checked again.
+    QList<Definition> remaining = definitions;
+    auto newState = std::make_shared<State>();
+    QString error;
+    int invalidIndex;
+    int skippedCount = 0;
+    while((invalidIndex = compileDefinitions(remaining, newState.get(), &error)) >= 0){
+        if(errorMessages) errorMessages->append(error);
+        remaining.removeAt(invalidIndex);
+        skippedCount++;
+    }
+    newState->revision = state()->revision + 1;
+
+    std::atomic_store(&m_state, std::shared_ptr<const State>(newState));
+    return skippedCount;
+}
+
+QList<UserPropertyRegistry::Definition> UserPropertyRegistry::definitions()
+{
+    return state()->definitions;
+}
+
+QStringList UserPropertyRegistry::names()
+{
+    return state()->names;
+}
+
+std::shared_ptr<const PropertyExpression> UserPropertyRegistry::find(const QString &name)
+{
+    return state()->expressions.value(name);
+}
+
+int UserPropertyRegistry::revision()
+{
+    return state()->revision;
+}
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ **                                                                         **
+ **  This file is part of GlassPlotter.                                     **
+ **                                                                         **
+ **  GlassPlotter is free software: you can redistribute it and/or modify   **
+ **  it under the terms of the GNU General Public License as published by   **
+ **  the Free Software Foundation, either version 3 of the License, or      **
+ **  (at your option) any later version.                                    **
+ **                                                                         **
+ **  GlassPlotter is distributed in the hope that it will be useful,        **
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of         **
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          **
+ **  GNU General Public License for more details.                           **
+ **                                                                         **
+ **  You should have received a copy of the GNU General Public License      **
+ **  along with GlassPlotter.  If not, see <http://www.gnu.org/licenses/>.  **
+ **                                                                         **
+ *****************************************************************************
+ **  Author  : Hiiragi                                                      **
+ **  Contact : heterophyllus.work@gmail.com                                 **
+ **  Website : https://github.com/heterophyllus/glassplotter                **
+ **  Date    : 2026-10-19                                                   **
+ *****************************************************************************/
+
+#ifndef USER_PROPERTY_REGISTRY_H
+#define USER_PROPERTY_REGISTRY_H
+
+#include <memory>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QMap>
+
+#include "property_expression.h"
+
+/**
+ * @brief Registry of the user defined glass properties
+ * @details
+ * The definitions are compiled once when set and published as an immutable state,
+ * so that Glass::getValue can look them up from any thread.
+ */
+class UserPropertyRegistry
+{
+public:
+    struct Definition{
+        QString name;
+        QString expression;
+    };
+
+    /**
+     * @brief Validate, compile and publish the definitions
+     * @return false with the message if any definition is invalid. The current definitions are kept.
+     */
+    static bool setDefinitions(const QList<Definition>& definitions, QString* errorMessage = nullptr);
+
+    /**
+     * @brief Publish the valid definitions and skip the invalid ones, including those depending on them
+     * @param errorMessages one message per skipped definition
+     * @return number of skipped definitions
+     */
+    static int setValidDefinitions(const QList<Definition>& definitions, QStringList* errorMessages = nullptr);
+
+    static QList<Definition> definitions();
+
+    /** names of the user defined properties in the defined order */
+    static QStringList names();
+
+    /** @return compiled expression, or null if the name is not defined */
+    static std::shared_ptr<const PropertyExpression> find(const QString& name);
+
+    /** incremented whenever the definitions are changed */
+    static int revision();
+
+private:
+    struct State{
+        QList<Definition> definitions;
+        QStringList names;
+        QMap<QString, std::shared_ptr<const PropertyExpression> > expressions;
+        int revision = 0;
+    };
+
+    static std::shared_ptr<const State> state();
+
+    /**
+     * @brief Validate and compile the definitions into the state
+     * @return index of the first invalid definition, or -1 if all are valid
+     */
+    static int compileDefinitions(const QList<Definition>& definitions, State* state, QString* errorMessage);
+
+    static std::shared_ptr<const State> m_state; // accessed by std::atomic_load/atomic_store only
+};
+
+#endif // USER_PROPERTY_REGISTRY_H